@@ -1,11 +1,22 @@
 #include "CoordArrowsModel.h"
+#include "LineRing.h"
 #include "Logger.h"
 
-VkMesh CoordArrowsModel::getVertexData() {
+void CoordArrowsModel::addVertexData(VkRenderData &renderData, const glm::vec3 &position, const float colorScale) {
   if (mVertexData.vertices.size() == 0) {
     init();
   }
-  return mVertexData;
+
+  VkVertex *vertices = LineRing::reserveVertices(renderData, mVertexData.vertices.size());
+  if (!vertices) {
+    return;
+  }
+
+  for (size_t i = 0; i < mVertexData.vertices.size(); ++i) {
+    vertices[i].position = mVertexData.vertices[i].position + position;
+    vertices[i].color = mVertexData.vertices[i].color * colorScale;
+    vertices[i].uv = mVertexData.vertices[i].uv;
+  }
 }
 
 void CoordArrowsModel::init() {
@@ -7,7 +7,8 @@
 
 class CoordArrowsModel {
   public:
-    VkMesh getVertexData();
+    /* writes the arrows into the line ring, moved to position and with scaled colors */
+    void addVertexData(VkRenderData &renderData, const glm::vec3 &position, const float colorScale);
 
   private:
     void init();
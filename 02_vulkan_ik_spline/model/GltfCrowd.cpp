@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "GltfCrowd.h"
+#include "Logger.h"
+
+void GltfCrowd::animateInstances(VkRenderData &renderData, std::shared_ptr<GltfModel> model) {
+  int numInstances = std::clamp(renderData.rdCrowdInstances, 1, VkRenderData::rdMaxCrowdInstances);
+  if (numInstances != mNumInstances) {
+    updateInstanceMatrices(numInstances);
+  }
+
+  /* only the joint data of the active skinning mode is read by the shaders */
+  bool dualQuatSkinning = renderData.rdGPUDualQuatVertexSkinning == skinningMode::dualQuat;
+  int jointCount = model->getJointMatrixSize();
+  if (dualQuatSkinning) {
+    mJointDualQuats.resize(numInstances * jointCount);
+  } else {
+    mJointMatrices.resize(numInstances * jointCount);
+  }
+
+  if (numInstances == 1) {
+    return;
+  }
+
+  float endTime = model->getAnimationEndTime(renderData.rdAnimClip);
+  float clipTime = renderData.rdAnimTimePosition;
+  if (renderData.rdPlayAnimation) {
+    double currentTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+    clipTime = std::fmod(currentTime / 1000.0 * renderData.rdAnimSpeed, endTime);
+  }
+  if (renderData.rdAnimationPlayDirection == replayDirection::backward) {
+    clipTime = endTime - clipTime;
+  }
+
+  for (int i = 1; i < numInstances; ++i) {
+    /* spread the instances over the clip, or they would all move in sync */
+    float instanceOffset = std::fmod(static_cast<float>(i) * 0.618034f, 1.0f) * endTime;
+    model->sampleAnimationFrame(renderData.rdAnimClip, std::fmod(clipTime + instanceOffset, endTime));
+
+    if (dualQuatSkinning) {
+      const std::vector<glm::mat2x4> &jointDualQuats = model->getJointDualQuats();
+      std::copy(jointDualQuats.begin(), jointDualQuats.end(), mJointDualQuats.begin() + i * jointCount);
+    } else {
+      const std::vector<glm::mat4> &jointMatrices = model->getJointMatrices();
+      std::copy(jointMatrices.begin(), jointMatrices.end(), mJointMatrices.begin() + i * jointCount);
+    }
+  }
+}
+
+void GltfCrowd::setMainInstance(VkRenderData &renderData, std::shared_ptr<GltfModel> model) {
+  if (renderData.rdGPUDualQuatVertexSkinning == skinningMode::dualQuat) {
+    const std::vector<glm::mat2x4> &jointDualQuats = model->getJointDualQuats();
+    std::copy(jointDualQuats.begin(), jointDualQuats.end(), mJointDualQuats.begin());
+  } else {
+    const std::vector<glm::mat4> &jointMatrices = model->getJointMatrices();
+    std::copy(jointMatrices.begin(), jointMatrices.end(), mJointMatrices.begin());
+  }
+}
+
+int GltfCrowd::getInstanceCount() {
+  return mNumInstances;
+}
+
+const std::vector<glm::mat4>& GltfCrowd::getInstanceMatrices() {
+  return mInstanceMatrices;
+}
+
+const std::vector<glm::mat4>& GltfCrowd::getJointMatrices() {
+  return mJointMatrices;
+}
+
+const std::vector<glm::mat2x4>& GltfCrowd::getJointDualQuats() {
+  return mJointDualQuats;
+}
+
+void GltfCrowd::updateInstanceMatrices(int numInstances) {
+  mNumInstances = numInstances;
+  mInstanceMatrices.resize(numInstances);
+
+  /* square grid behind the first instance, which stays at the origin for the IK target and the skeleton */
+  int gridSize = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(numInstances))));
+  for (int i = 0; i < numInstances; ++i) {
+    glm::vec3 position = glm::vec3(static_cast<float>(i % gridSize) * mInstanceSpacing, 0.0f,
+      -static_cast<float>(i / gridSize) * mInstanceSpacing);
+    mInstanceMatrices.at(i) = glm::translate(glm::mat4(1.0f), position);
+  }
+
+  Logger::log(1, "%s: crowd has %i instances\n", __FUNCTION__, numInstances);
+}
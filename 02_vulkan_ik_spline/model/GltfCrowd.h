@@ -0,0 +1,36 @@
+/* instances of one glTF model, drawn with a single instanced draw call */
+#pragma once
+#include <vector>
+#include <memory>
+#include <glm/glm.hpp>
+
+#include "GltfModel.h"
+
+#include "VkRenderData.h"
+
+/* every instance has its own world transform and animation time, the joint data of
+ * all instances is packed into one array, the data of instance i starts at i * joint count */
+class GltfCrowd {
+  public:
+    /* samples the clip for all nodes of all instances except the first one on the CPU,
+     * overwrites the node data of the model, but not the base pose used by its blending */
+    void animateInstances(VkRenderData &renderData, std::shared_ptr<GltfModel> model);
+    /* the first instance is the model itself, call after the model was animated and IK was solved */
+    void setMainInstance(VkRenderData &renderData, std::shared_ptr<GltfModel> model);
+
+    int getInstanceCount();
+    const std::vector<glm::mat4>& getInstanceMatrices();
+    const std::vector<glm::mat4>& getJointMatrices();
+    const std::vector<glm::mat2x4>& getJointDualQuats();
+
+  private:
+    void updateInstanceMatrices(int numInstances);
+
+    int mNumInstances = 0;
+    /* distance between two instances on the grid */
+    float mInstanceSpacing = 1.5f;
+
+    std::vector<glm::mat4> mInstanceMatrices{};
+    std::vector<glm::mat4> mJointMatrices{};
+    std::vector<glm::mat2x4> mJointDualQuats{};
+};
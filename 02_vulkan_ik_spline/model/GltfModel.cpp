@@ -8,6 +8,7 @@
 
 #include "VertexBuffer.h"
 #include "IndexBuffer.h"
+#include "LineRing.h"
 #include "GltfModel.h"
 #include "Logger.h"
 
@@ -67,10 +68,6 @@ bool GltfModel::loadModel(VkRenderData &renderData, VkGltfRenderData &gltfRender
   getNodeData(mRootNode);
   getNodes(mRootNode);
 
-  /* init skeleton */
-  mSkeletonMesh = std::make_shared<VkMesh>();
-  mSkeletonMesh->vertices.resize(mModel->nodes.size() * 2);
-
   mRootNode->printTree();
 
   /* extract animation data */
@@ -83,6 +80,7 @@ bool GltfModel::loadModel(VkRenderData &renderData, VkGltfRenderData &gltfRender
   std::fill(mAdditiveAnimationMask.begin(), mAdditiveAnimationMask.end(), true);
   mInvertedAdditiveAnimationMask = mAdditiveAnimationMask;
   mInvertedAdditiveAnimationMask.flip();
+  mFullAnimationMask = std::vector<bool>(renderData.rdModelNodeCount, true);
 
   for (const auto &clip : mAnimClips) {
     renderData.rdClipNames.push_back(clip->getClipName());
@@ -208,6 +206,11 @@ void GltfModel::blendAnimationFrame(int animNum, float time, float blendFactor)
   updateNodeMatrices(mRootNode);
 }
 
+void GltfModel::sampleAnimationFrame(int animNum, float time) {
+  mAnimClips.at(animNum)->blendAnimationFrame(mNodeList, mFullAnimationMask, time, 1.0f);
+  updateNodeMatrices(mRootNode);
+}
+
 void GltfModel::crossBlendAnimationFrame(int sourceAnimNumber, int destAnimNumber, float time,
     float blendFactor) {
 
@@ -236,28 +239,19 @@ std::string GltfModel::getClipName(int animNum) {
   return mAnimClips.at(animNum)->getClipName();
 }
 
-std::shared_ptr<VkMesh> GltfModel::getSkeleton() {
-  mSkeletonMesh->vertices.clear();
+void GltfModel::addSkeletonLines(VkRenderData &renderData) {
   /* start from Armature child */
-  getSkeletonPerNode(mRootNode->getChilds().at(0));
-  return mSkeletonMesh;
+  addSkeletonLinesPerNode(renderData, mRootNode->getChilds().at(0));
 }
 
-void GltfModel::getSkeletonPerNode(std::shared_ptr<GltfNode> treeNode) {
+void GltfModel::addSkeletonLinesPerNode(VkRenderData &renderData, std::shared_ptr<GltfNode> treeNode) {
   glm::vec3 parentPos = treeNode->getGlobalPosition();
-  VkVertex parentVertex;
-  parentVertex.position = parentPos;
-  parentVertex.color = glm::vec3(0.0f, 1.0f, 1.0f);
 
   for (const auto &childNode : treeNode->getChilds()) {
-    glm::vec3 childPos = childNode->getGlobalPosition();
-    VkVertex childVertex;
-    childVertex.position = childPos;
-    childVertex.color = glm::vec3(0.0f, 0.0f, 1.0f);
-    mSkeletonMesh->vertices.emplace_back(parentVertex);
-    mSkeletonMesh->vertices.emplace_back(childVertex);
-
-    getSkeletonPerNode(childNode);
+    LineRing::addLine(renderData, parentPos, glm::vec3(0.0f, 1.0f, 1.0f),
+      childNode->getGlobalPosition(), glm::vec3(0.0f, 0.0f, 1.0f));
+
+    addSkeletonLinesPerNode(renderData, childNode);
   }
 }
 
@@ -392,6 +386,16 @@ void GltfModel::createVertexBuffers(VkRenderData &renderData, VkGltfRenderData &
       int numPositionEntries = accessor.count;
       Logger::log(1, "%s: loaded %i vertices from glTF file\n", __FUNCTION__,
         numPositionEntries);
+
+      /* glTF requires min and max values for positions
+       * the animations move the vertices out of the bind pose, so the radius gets some headroom */
+      if (accessor.minValues.size() == 3 && accessor.maxValues.size() == 3) {
+        glm::vec3 minPos = glm::vec3(accessor.minValues.at(0), accessor.minValues.at(1), accessor.minValues.at(2));
+        glm::vec3 maxPos = glm::vec3(accessor.maxValues.at(0), accessor.maxValues.at(1), accessor.maxValues.at(2));
+        mBoundingSphere = glm::vec4((minPos + maxPos) / 2.0f, glm::length(maxPos - minPos) / 2.0f * 1.2f);
+      } else {
+        Logger::log(1, "%s error: position accessor %i has no bounds\n", __FUNCTION__, accessorNum);
+      }
     }
 
     mAttribAccessors.at(attributes.at(attribType)) = accessorNum;
@@ -451,11 +455,15 @@ int GltfModel::getTriangleCount() {
   return triangles;
 }
 
+glm::vec4 GltfModel::getBoundingSphere() {
+  return mBoundingSphere;
+}
+
 int GltfModel::getJointMatrixSize() {
   return mJointMatrices.size();
 }
 
-std::vector<glm::mat4> GltfModel::getJointMatrices() {
+const std::vector<glm::mat4>& GltfModel::getJointMatrices() {
   return mJointMatrices;
 }
 
@@ -463,7 +471,7 @@ int GltfModel::getJointDualQuatsSize() {
   return mJointDualQuats.size();
 }
 
-std::vector<glm::mat2x4> GltfModel::getJointDualQuats() {
+const std::vector<glm::mat2x4>& GltfModel::getJointDualQuats() {
   return mJointDualQuats;
 }
 
@@ -531,33 +539,40 @@ void GltfModel::solveIKByFABRIK(glm::vec3 target)  {
   updateNodeMatrices(mIKSolver.getIkChainRootNode());
 }
 
-void GltfModel::draw(VkRenderData &renderData, VkGltfRenderData& gltfRenderData) {
+void GltfModel::draw(VkRenderData &renderData, VkGltfRenderData& gltfRenderData, VkCommandBuffer commandBuffer,
+    VkBuffer indirectBuffer, VkDeviceSize indirectOffset) {
   /* texture */
-  vkCmdBindDescriptorSets(renderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
     renderData.rdGltfPipelineLayout, 0, 1,
     &gltfRenderData.rdGltfModelTexture.texTextureDescriptorSet, 0, nullptr);
 
   /* vertex buffer */
   VkDeviceSize offset = 0;
   for (int i = 0; i < 5; ++i) {
-    vkCmdBindVertexBuffers(renderData.rdCommandBuffer, i, 1,
+    vkCmdBindVertexBuffers(commandBuffer, i, 1,
       &gltfRenderData.rdGltfVertexBufferData.at(i).rdVertexBuffer, &offset);
   }
 
   /* index buffer */
-  vkCmdBindIndexBuffer(renderData.rdCommandBuffer,
+  vkCmdBindIndexBuffer(commandBuffer,
     gltfRenderData.rdGltfIndexBufferData.rdIndexBuffer, 0, VK_INDEX_TYPE_UINT16);
 
   /* pipeline + shader */
   if (renderData.rdGPUDualQuatVertexSkinning == skinningMode::dualQuat) {
-    vkCmdBindPipeline(renderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
       renderData.rdGltfGPUDQPipeline);
   } else {
-    vkCmdBindPipeline(renderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
      renderData.rdGltfGPUPipeline);
   }
-  vkCmdDrawIndexed(renderData.rdCommandBuffer,
-    static_cast<uint32_t>(renderData.rdGltfTriangleCount * 3), 1, 0, 0, 0);
+
+  /* the shaders find the joints of a visible instance at instance * stride */
+  int jointStride = static_cast<int>(mJointMatrices.size());
+  vkCmdPushConstants(commandBuffer, renderData.rdGltfPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+    sizeof(int), &jointStride);
+
+  vkCmdDrawIndexedIndirect(commandBuffer, indirectBuffer, indirectOffset, 1,
+    sizeof(VkDrawIndexedIndirectCommand));
 }
 
 void GltfModel::cleanup(VkRenderData &renderData, VkGltfRenderData &gltfRenderData) {
@@ -18,16 +18,22 @@ class GltfModel {
   public:
     bool loadModel(VkRenderData &renderData, VkGltfRenderData& gltfRenderData,
       std::string modelFilename, std::string textureFilename);
-    void draw(VkRenderData &renderData, VkGltfRenderData& gltfRenderData);
+    /* the joint data of all instances is packed into the SSBOs, one block of joints per instance
+     * the instance count is taken from the indirect draw command written by the culling */
+    void draw(VkRenderData &renderData, VkGltfRenderData& gltfRenderData, VkCommandBuffer commandBuffer,
+      VkBuffer indirectBuffer, VkDeviceSize indirectOffset);
     void cleanup(VkRenderData &renderData, VkGltfRenderData& gltfRenderData);
 
     void uploadVertexBuffers(VkRenderData& renderData, VkGltfRenderData& gltfRenderData);
     void uploadIndexBuffer(VkRenderData& renderData, VkGltfRenderData& gltfRenderData);
-    std::shared_ptr<VkMesh> getSkeleton();
+    /* writes the bones as lines into the line ring */
+    void addSkeletonLines(VkRenderData &renderData);
+    /* bind pose bounds in model space, xyz is the center and w the radius */
+    glm::vec4 getBoundingSphere();
     int getJointMatrixSize();
-    std::vector<glm::mat4> getJointMatrices();
+    const std::vector<glm::mat4>& getJointMatrices();
     int getJointDualQuatsSize();
-    std::vector<glm::mat2x4> getJointDualQuats();
+    const std::vector<glm::mat2x4>& getJointDualQuats();
 
     void playAnimation(int animNum, float speedDivider, float blendFactor,
       replayDirection direction);
@@ -35,6 +41,9 @@ class GltfModel {
       float blendFactor, replayDirection direction);
 
     void blendAnimationFrame(int animNumber, float time, float blendFactor);
+    /* poses all nodes from the clip, ignoring the additive mask, used for the crowd instances
+     * the base pose of the nodes is kept, so the blending of the model itself is not changed */
+    void sampleAnimationFrame(int animNumber, float time);
     void crossBlendAnimationFrame(int sourceAnimNumber, int destAnimNumber, float time,
       float blendFactor);
 
@@ -54,7 +63,7 @@ class GltfModel {
     void createVertexBuffers(VkRenderData& renderData, VkGltfRenderData& gltfRenderData);
     void createIndexBuffer(VkRenderData& renderData, VkGltfRenderData& gltfRenderData);
     int getTriangleCount();
-    void getSkeletonPerNode(std::shared_ptr<GltfNode> treeNode);
+    void addSkeletonLinesPerNode(VkRenderData &renderData, std::shared_ptr<GltfNode> treeNode);
 
     void getJointData();
     void getWeightData();
@@ -75,20 +84,20 @@ class GltfModel {
     std::vector<glm::mat2x4> mJointDualQuats{};
 
     std::vector<int> mAttribAccessors{};
+    glm::vec4 mBoundingSphere = glm::vec4(0.0f);
     std::vector<int> mNodeToJoint{};
 
     std::shared_ptr<GltfNode> mRootNode = nullptr;
 
     std::shared_ptr<tinygltf::Model> mModel = nullptr;
 
-    std::shared_ptr<VkMesh> mSkeletonMesh = nullptr;
-
     std::vector<std::shared_ptr<GltfNode>> mNodeList;
 
     std::vector<std::shared_ptr<GltfAnimationClip>> mAnimClips{};
 
     std::vector<bool> mAdditiveAnimationMask{};
     std::vector<bool> mInvertedAdditiveAnimationMask{};
+    std::vector<bool> mFullAnimationMask{};
 
     std::map<std::string, GLint> attributes =
       {{"POSITION", 0}, {"NORMAL", 1}, {"TEXCOORD_0", 2}, {"JOINTS_0", 3}, {"WEIGHTS_0", 4}};
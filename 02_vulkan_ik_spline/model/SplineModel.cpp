@@ -1,45 +1,216 @@
+#include <algorithm>
 #include <glm/gtx/spline.hpp>
 
 #include "SplineModel.h"
+#include "LineRing.h"
 #include "Logger.h"
 
-VkMesh SplineModel::createVertexData(int numSplinePoints,
-    glm::vec3 startVertex, glm::vec3 startTangent,
-    glm::vec3 endVertex, glm::vec3 endTangent) {
+void SplineModel::setControlPoints(std::vector<glm::vec3> vertices,
+    std::vector<glm::vec3> tangents) {
+  if (vertices.size() != tangents.size()) {
+    Logger::log(1, "%s error: got %i vertices but %i tangents\n", __FUNCTION__,
+      vertices.size(), tangents.size());
+    return;
+  }
+
+  /* nothing changed, keep the cached data */
+  if (vertices == mVertices && tangents == mTangents) {
+    return;
+  }
+
+  mVertices = vertices;
+  mTangents = tangents;
+  mVertexDataDirty = true;
+  mArcLengthDirty = true;
+}
+
+int SplineModel::getNumSegments() {
+  if (mVertices.size() < 2) {
+    return 0;
+  }
+  return mVertices.size() - 1;
+}
 
-  VkMesh mVertexData;
+void SplineModel::addVertexData(VkRenderData &renderData, int numSplinePoints) {
+  if (mVertexDataDirty || numSplinePoints != mNumSplinePoints) {
+    generateVertexData(numSplinePoints);
+  }
 
-  mVertexData.vertices.resize(numSplinePoints * 2 + 4);
+  VkVertex *vertices = LineRing::reserveVertices(renderData, mVertexData.vertices.size());
+  if (!vertices) {
+    return;
+  }
+  std::copy(mVertexData.vertices.begin(), mVertexData.vertices.end(), vertices);
+}
 
-  /* draw the tangents as lines */
-  mVertexData.vertices[0].color = glm::vec3(0.0f, 0.0f, 0.0f);
-  mVertexData.vertices[0].position = startVertex;
-  mVertexData.vertices[1].color = glm::vec3(0.0f, 0.0, 0.0f);
-  mVertexData.vertices[1].position = startVertex + startTangent;
-  mVertexData.vertices[2].color = glm::vec3(0.8f, 0.8, 0.8f);
-  mVertexData.vertices[2].position = endVertex;
-  mVertexData.vertices[3].color = glm::vec3(0.8f, 0.8f,0.8f);
-  mVertexData.vertices[3].position = endVertex + endTangent;
+/* convert segment to a * t^3 + b * t^2 + c * t + d, see glm::hermite() */
+void SplineModel::getPolynomialCoefficients(int segment, glm::vec3 &a, glm::vec3 &b,
+    glm::vec3 &c, glm::vec3 &d) {
+  glm::vec3 startVertex = mVertices.at(segment);
+  glm::vec3 startTangent = mTangents.at(segment);
+  glm::vec3 endVertex = mVertices.at(segment + 1);
+  glm::vec3 endTangent = mTangents.at(segment + 1);
 
-  /* draw tangent as line segments */
-  float offset = 1.0f / static_cast<float>(numSplinePoints);
-  float value = 0.0f;
+  a = 2.0f * startVertex - 2.0f * endVertex + startTangent + endTangent;
+  b = -3.0f * startVertex + 3.0f * endVertex - 2.0f * startTangent - endTangent;
+  c = startTangent;
+  d = startVertex;
+}
+
+void SplineModel::generateVertexData(int numSplinePoints) {
+  mNumSplinePoints = numSplinePoints;
+  mVertexDataDirty = false;
+  mVertexData.vertices.clear();
 
-  for (int i = 5; i < numSplinePoints * 2 + 4; i += 2) {
-    mVertexData.vertices[i - 1].position = glm::hermite(
-      startVertex, startTangent, endVertex,endTangent, value);
-    mVertexData.vertices[i - 1].color = glm::vec3(value);
+  int numSegments = getNumSegments();
+  if (numSegments == 0 || numSplinePoints <= 0) {
+    return;
+  }
 
-    /* keep color of line segment */
-    mVertexData.vertices[i].color = glm::vec3(value);
+  int numTangentVertices = mVertices.size() * 2;
+  mVertexData.vertices.resize(numTangentVertices + numSegments * numSplinePoints * 2);
 
-    value += offset;
-    mVertexData.vertices[i].position = glm::hermite(
-      startVertex, startTangent, endVertex,endTangent, value);
+  /* draw the tangents as lines, from black at the start to light gray at the end */
+  for (int i = 0; i < mVertices.size(); ++i) {
+    glm::vec3 color = glm::vec3(0.8f * static_cast<float>(i) / static_cast<float>(numSegments));
+    mVertexData.vertices[i * 2].color = color;
+    mVertexData.vertices[i * 2].position = mVertices.at(i);
+    mVertexData.vertices[i * 2 + 1].color = color;
+    mVertexData.vertices[i * 2 + 1].position = mVertices.at(i) + mTangents.at(i);
   }
-  mVertexData.vertices[numSplinePoints * 2 + 4 - 1].position = endVertex;
-  mVertexData.vertices[numSplinePoints * 2 + 4 - 1].color = glm::vec3(value);
 
-  return mVertexData;
+  /* draw segments as lines, using forward differences of the cubic polynomial */
+  float h = 1.0f / static_cast<float>(numSplinePoints);
+  float h2 = h * h;
+  float h3 = h2 * h;
+  float colorOffset = h / static_cast<float>(numSegments);
+  int index = numTangentVertices;
+
+  for (int segment = 0; segment < numSegments; ++segment) {
+    glm::vec3 a, b, c, d;
+    getPolynomialCoefficients(segment, a, b, c, d);
+
+    glm::vec3 pos = d;
+    glm::vec3 firstDiff = a * h3 + b * h2 + c * h;
+    glm::vec3 secondDiff = 6.0f * a * h3 + 2.0f * b * h2;
+    glm::vec3 thirdDiff = 6.0f * a * h3;
+
+    float value = static_cast<float>(segment) / static_cast<float>(numSegments);
+
+    for (int i = 0; i < numSplinePoints; ++i) {
+      mVertexData.vertices[index].position = pos;
+      mVertexData.vertices[index].color = glm::vec3(value);
+
+      pos += firstDiff;
+      firstDiff += secondDiff;
+      secondDiff += thirdDiff;
+
+      /* keep color of line segment */
+      mVertexData.vertices[index + 1].position = pos;
+      mVertexData.vertices[index + 1].color = glm::vec3(value);
+
+      value += colorOffset;
+      index += 2;
+    }
+
+    /* avoid gaps by accumulated float errors */
+    mVertexData.vertices[index - 1].position = mVertices.at(segment + 1);
+  }
+
+  Logger::log(2, "%s: SplineModel - generated %i vertices for %i segments\n", __FUNCTION__,
+    mVertexData.vertices.size(), numSegments);
 }
 
+void SplineModel::generateArcLengthTable() {
+  mArcLengthDirty = false;
+  mArcLengthParams.clear();
+  mArcLengths.clear();
+
+  int numSegments = getNumSegments();
+  if (numSegments == 0) {
+    return;
+  }
+
+  mArcLengthParams.reserve(numSegments * mArcLengthSamplesPerSegment + 1);
+  mArcLengths.reserve(numSegments * mArcLengthSamplesPerSegment + 1);
+
+  mArcLengthParams.emplace_back(0.0f);
+  mArcLengths.emplace_back(0.0f);
+
+  float h = 1.0f / static_cast<float>(mArcLengthSamplesPerSegment);
+  float h2 = h * h;
+  float h3 = h2 * h;
+  float length = 0.0f;
+
+  for (int segment = 0; segment < numSegments; ++segment) {
+    glm::vec3 a, b, c, d;
+    getPolynomialCoefficients(segment, a, b, c, d);
+
+    glm::vec3 pos = d;
+    glm::vec3 firstDiff = a * h3 + b * h2 + c * h;
+    glm::vec3 secondDiff = 6.0f * a * h3 + 2.0f * b * h2;
+    glm::vec3 thirdDiff = 6.0f * a * h3;
+
+    for (int i = 1; i <= mArcLengthSamplesPerSegment; ++i) {
+      glm::vec3 nextPos = pos + firstDiff;
+      firstDiff += secondDiff;
+      secondDiff += thirdDiff;
+
+      length += glm::length(nextPos - pos);
+      pos = nextPos;
+
+      mArcLengthParams.emplace_back((static_cast<float>(segment) + i * h) /
+        static_cast<float>(numSegments));
+      mArcLengths.emplace_back(length);
+    }
+  }
+}
+
+glm::vec3 SplineModel::getPosition(float interpValue) {
+  int numSegments = getNumSegments();
+  if (numSegments == 0) {
+    return mVertices.empty() ? glm::vec3(0.0f) : mVertices.at(0);
+  }
+
+  float scaledValue = glm::clamp(interpValue, 0.0f, 1.0f) * static_cast<float>(numSegments);
+  int segment = std::min(static_cast<int>(scaledValue), numSegments - 1);
+
+  return glm::hermite(mVertices.at(segment), mTangents.at(segment),
+    mVertices.at(segment + 1), mTangents.at(segment + 1),
+    scaledValue - static_cast<float>(segment));
+}
+
+float SplineModel::getLength() {
+  if (mArcLengthDirty) {
+    generateArcLengthTable();
+  }
+  return mArcLengths.empty() ? 0.0f : mArcLengths.back();
+}
+
+glm::vec3 SplineModel::getPositionByArcLength(float lengthValue) {
+  float totalLength = getLength();
+  if (totalLength <= 0.0f) {
+    return getPosition(0.0f);
+  }
+
+  float targetLength = glm::clamp(lengthValue, 0.0f, 1.0f) * totalLength;
+
+  /* find the first sample after the requested length */
+  auto upperIter = std::upper_bound(mArcLengths.begin(), mArcLengths.end(), targetLength);
+  if (upperIter == mArcLengths.end()) {
+    return getPosition(1.0f);
+  }
+  size_t upperIndex = std::distance(mArcLengths.begin(), upperIter);
+  size_t lowerIndex = upperIndex - 1;
+
+  /* map the length linearly inside the sample interval */
+  float sampleLength = mArcLengths.at(upperIndex) - mArcLengths.at(lowerIndex);
+  float fraction = 0.0f;
+  if (sampleLength > 0.0f) {
+    fraction = (targetLength - mArcLengths.at(lowerIndex)) / sampleLength;
+  }
+
+  float interpValue = glm::mix(mArcLengthParams.at(lowerIndex),
+    mArcLengthParams.at(upperIndex), fraction);
+  return getPosition(interpValue);
+}
@@ -5,9 +5,39 @@
 
 #include "VkRenderData.h"
 
+/* multi-segment cubic Hermite path, vertices and arc length table are cached */
 class SplineModel {
   public:
-  VkMesh createVertexData(int numSplinePoints,
-    glm::vec3 startVertex, glm::vec3 startTangent,
-    glm::vec3 endVertex, glm::vec3 endTangent);
+    /* one tangent per vertex, n vertices create n - 1 segments */
+    void setControlPoints(std::vector<glm::vec3> vertices,
+      std::vector<glm::vec3> tangents);
+    int getNumSegments();
+
+    /* writes numSplinePoints lines per segment into the line ring, the lines are only rebuilt on changes */
+    void addVertexData(VkRenderData &renderData, int numSplinePoints);
+
+    /* value in [0.0, 1.0] over the whole path, like glm::hermite() */
+    glm::vec3 getPosition(float interpValue);
+    /* value in [0.0, 1.0] of the total path length, moves at constant speed */
+    glm::vec3 getPositionByArcLength(float lengthValue);
+    float getLength();
+
+  private:
+    void generateVertexData(int numSplinePoints);
+    void generateArcLengthTable();
+    void getPolynomialCoefficients(int segment, glm::vec3 &a, glm::vec3 &b,
+      glm::vec3 &c, glm::vec3 &d);
+
+    std::vector<glm::vec3> mVertices{};
+    std::vector<glm::vec3> mTangents{};
+
+    VkMesh mVertexData{};
+    int mNumSplinePoints = 0;
+    bool mVertexDataDirty = true;
+
+    /* pairs of path parameter and path length from the start */
+    std::vector<float> mArcLengthParams{};
+    std::vector<float> mArcLengths{};
+    int mArcLengthSamplesPerSegment = 64;
+    bool mArcLengthDirty = true;
 };
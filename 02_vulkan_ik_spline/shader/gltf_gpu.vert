@@ -18,12 +18,29 @@ layout (std430, set = 2, binding = 0) readonly buffer JointMatrices {
     mat4 jointMat[];
 };
 
+layout (std430, set = 4, binding = 0) readonly buffer InstanceMatrices {
+  mat4 instanceMat[];
+};
+
+/* written by the culling compute shader, one entry per drawn instance */
+layout (std430, set = 5, binding = 1) readonly buffer VisibleInstances {
+  uint visibleIds[];
+};
+
+/* number of joints, the joint data of all instances is packed into one buffer */
+layout (push_constant) uniform Constants {
+  int aModelStride;
+};
+
 void main() {
+  uint instance = visibleIds[gl_InstanceIndex];
+  uint jointOffset = instance * uint(aModelStride);
   mat4 skinMat =
-		aJointWeight.x * jointMat[aJointNum.x] +
-		aJointWeight.y * jointMat[aJointNum.y] +
-		aJointWeight.z * jointMat[aJointNum.z] +
-		aJointWeight.w * jointMat[aJointNum.w];
+		aJointWeight.x * jointMat[aJointNum.x + jointOffset] +
+		aJointWeight.y * jointMat[aJointNum.y + jointOffset] +
+		aJointWeight.z * jointMat[aJointNum.z + jointOffset] +
+		aJointWeight.w * jointMat[aJointNum.w + jointOffset];
+  skinMat = instanceMat[instance] * skinMat;
   gl_Position = projection * view * skinMat * vec4(aPos, 1.0);
   normal = vec3(transpose(inverse(skinMat)) * vec4(aNormal, 1.0));
   texCoord = aTexCoord;
@@ -18,8 +18,23 @@ layout (std430, set = 3, binding = 0) readonly buffer JointDualQuats {
   mat2x4 jointDQs[];
 };
 
+layout (std430, set = 4, binding = 0) readonly buffer InstanceMatrices {
+  mat4 instanceMat[];
+};
+
+/* written by the culling compute shader, one entry per drawn instance */
+layout (std430, set = 5, binding = 1) readonly buffer VisibleInstances {
+  uint visibleIds[];
+};
+
+/* number of joints, the joint data of all instances is packed into one buffer */
+layout (push_constant) uniform Constants {
+  int aModelStride;
+};
+
 mat2x4 getJointTransform(uvec4 joints, vec4 weights) {
-  // read dual quaterions from buffer
+  // read dual quaterions of this instance from buffer
+  joints += uvec4(visibleIds[gl_InstanceIndex] * uint(aModelStride));
   mat2x4 dq0 = jointDQs[joints.x];
   mat2x4 dq1 = jointDQs[joints.y];
   mat2x4 dq2 = jointDQs[joints.z];
@@ -71,7 +86,7 @@ mat4 getSkinMat() {
 }
 
 void main() {
-  mat4 skinMat = getSkinMat();
+  mat4 skinMat = instanceMat[visibleIds[gl_InstanceIndex]] * getSkinMat();
   gl_Position = projection * view * skinMat * vec4(aPos, 1.0);
   normal = vec3(transpose(inverse(skinMat)) * vec4(aNormal, 1.0));
   texCoord = aTexCoord;
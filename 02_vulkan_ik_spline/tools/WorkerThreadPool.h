@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/* fixed set of worker threads, sleeping until a batch of jobs arrives
+ * the calling thread works on the jobs too, so a pool with n threads starts n - 1 workers */
+class WorkerThreadPool {
+  public:
+    WorkerThreadPool(const unsigned int numThreads);
+    ~WorkerThreadPool();
+
+    WorkerThreadPool(const WorkerThreadPool&) = delete;
+    WorkerThreadPool& operator=(const WorkerThreadPool&) = delete;
+
+    /* including the calling thread */
+    unsigned int getNumThreads() const;
+
+    /* calls job(jobIndex, threadIndex) once for every job index and returns after all jobs are done
+     * the thread index is in [0, getNumThreads()) and never used by two jobs at the same time */
+    void runJobs(const unsigned int numJobs, const std::function<void(unsigned int, unsigned int)>& job);
+
+  private:
+    void workerLoop(const unsigned int threadIndex);
+    void processJobs(const unsigned int threadIndex);
+
+    std::vector<std::thread> mWorkers{};
+
+    std::mutex mMutex{};
+    std::condition_variable mJobCondition{};
+    std::condition_variable mDoneCondition{};
+
+    /* current batch, only changed while no worker is busy */
+    const std::function<void(unsigned int, unsigned int)>* mJob = nullptr;
+    unsigned int mNumJobs = 0;
+    std::atomic<unsigned int> mNextJob = 0;
+
+    /* incremented for every batch, a waiting worker compares it against the last batch it has seen */
+    unsigned long long mBatch = 0;
+    unsigned int mBusyWorkers = 0;
+    bool mShutdown = false;
+};
@@ -0,0 +1,43 @@
+#include <VkBootstrap.h>
+
+#include "ComputePipeline.h"
+#include "Logger.h"
+#include "Shader.h"
+
+bool ComputePipeline::init(VkRenderData& renderData, VkPipelineLayout& pipelineLayout,
+    VkPipeline& pipeline, std::string computeShaderFilename) {
+  /* shader */
+  VkShaderModule computeModule = Shader::loadShader(renderData.rdVkbDevice.device, computeShaderFilename);
+
+  if (computeModule == VK_NULL_HANDLE) {
+    Logger::log(1, "%s error: could not load compute shader\n", __FUNCTION__);
+    return false;
+  }
+
+  VkPipelineShaderStageCreateInfo computeStageInfo{};
+  computeStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  computeStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+  computeStageInfo.module = computeModule;
+  computeStageInfo.pName = "main";
+
+  VkComputePipelineCreateInfo pipelineCreateInfo{};
+  pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+  pipelineCreateInfo.stage = computeStageInfo;
+  pipelineCreateInfo.layout = pipelineLayout;
+  pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+  if (vkCreateComputePipelines(renderData.rdVkbDevice.device, renderData.rdPipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not create compute pipeline\n", __FUNCTION__);
+    vkDestroyShaderModule(renderData.rdVkbDevice.device, computeModule, nullptr);
+    return false;
+  }
+
+  /* it is save to destroy the shader module after pipeline has been created */
+  vkDestroyShaderModule(renderData.rdVkbDevice.device, computeModule, nullptr);
+
+  return true;
+}
+
+void ComputePipeline::cleanup(VkRenderData &renderData, VkPipeline &pipeline) {
+  vkDestroyPipeline(renderData.rdVkbDevice.device, pipeline, nullptr);
+}
@@ -0,0 +1,297 @@
+#include <cstddef>
+
+#include "GpuCulling.h"
+#include "Logger.h"
+
+#include <VkBootstrap.h>
+
+bool GpuCulling::init(VkRenderData &renderData, const uint32_t maxInstances) {
+  VkGpuCullingData &cullingData = renderData.rdGpuCulling;
+  cullingData.rdFrameCountCopied.resize(VkRenderData::rdMaxFramesInFlight, false);
+  cullingData.rdFrameInstanceCounts.resize(VkRenderData::rdMaxFramesInFlight, 0);
+
+  /* the regions are bound with dynamic offsets */
+  VkDeviceSize alignment = renderData.rdVkbPhysicalDevice.properties.limits.minStorageBufferOffsetAlignment;
+  cullingData.rdIndirectRegionSize = (sizeof(VkDrawIndexedIndirectCommand) + alignment - 1) & ~(alignment - 1);
+  cullingData.rdVisibleRegionSize = (maxInstances * sizeof(uint32_t) + alignment - 1) & ~(alignment - 1);
+
+  VmaAllocationCreateInfo deviceAllocInfo{};
+  deviceAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+  /* the instance count is reset by a buffer update and copied to the readback buffer */
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size = cullingData.rdIndirectRegionSize * VkRenderData::rdMaxFramesInFlight;
+  bufferInfo.usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+    VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  if (vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &deviceAllocInfo, &cullingData.rdIndirectBuffer,
+      &cullingData.rdIndirectBufferAlloc, nullptr) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not allocate indirect draw buffer via VMA\n", __FUNCTION__);
+    return false;
+  }
+
+  bufferInfo.size = cullingData.rdVisibleRegionSize * VkRenderData::rdMaxFramesInFlight;
+  bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+  if (vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &deviceAllocInfo, &cullingData.rdVisibleBuffer,
+      &cullingData.rdVisibleBufferAlloc, nullptr) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not allocate visible instance buffer via VMA\n", __FUNCTION__);
+    return false;
+  }
+
+  bufferInfo.size = sizeof(uint32_t) * VkRenderData::rdMaxFramesInFlight;
+  bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+  VmaAllocationCreateInfo readbackAllocInfo{};
+  readbackAllocInfo.usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+  readbackAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+  VmaAllocationInfo allocInfo{};
+  if (vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &readbackAllocInfo, &cullingData.rdReadbackBuffer,
+      &cullingData.rdReadbackBufferAlloc, &allocInfo) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not allocate culling readback buffer via VMA\n", __FUNCTION__);
+    return false;
+  }
+  cullingData.rdReadbackData = static_cast<uint32_t*>(allocInfo.pMappedData);
+
+  /* written by the compute shader, the visible IDs are also read by the vertex shaders */
+  VkDescriptorSetLayoutBinding cullBindings[2]{};
+  for (uint32_t i = 0; i < 2; ++i) {
+    cullBindings[i].binding = i;
+    cullBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    cullBindings[i].descriptorCount = 1;
+    cullBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+  }
+
+  VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+  layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutCreateInfo.bindingCount = 2;
+  layoutCreateInfo.pBindings = cullBindings;
+
+  if (vkCreateDescriptorSetLayout(renderData.rdVkbDevice.device, &layoutCreateInfo, nullptr,
+      &cullingData.rdDescriptorLayout) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not create culling descriptor set layout\n", __FUNCTION__);
+    return false;
+  }
+
+  VkDescriptorPoolSize poolSize{};
+  poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+  poolSize.descriptorCount = 2;
+
+  VkDescriptorPoolCreateInfo descriptorPool{};
+  descriptorPool.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  descriptorPool.poolSizeCount = 1;
+  descriptorPool.pPoolSizes = &poolSize;
+  descriptorPool.maxSets = 1;
+
+  if (vkCreateDescriptorPool(renderData.rdVkbDevice.device, &descriptorPool, nullptr,
+      &cullingData.rdDescriptorPool) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not create culling descriptor pool\n", __FUNCTION__);
+    return false;
+  }
+
+  VkDescriptorSetAllocateInfo descriptorAllocateInfo{};
+  descriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  descriptorAllocateInfo.descriptorPool = cullingData.rdDescriptorPool;
+  descriptorAllocateInfo.descriptorSetCount = 1;
+  descriptorAllocateInfo.pSetLayouts = &cullingData.rdDescriptorLayout;
+
+  if (vkAllocateDescriptorSets(renderData.rdVkbDevice.device, &descriptorAllocateInfo,
+      &cullingData.rdDescriptorSet) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not allocate culling descriptor set\n", __FUNCTION__);
+    return false;
+  }
+
+  VkDescriptorBufferInfo indirectInfo{};
+  indirectInfo.buffer = cullingData.rdIndirectBuffer;
+  indirectInfo.offset = 0;
+  indirectInfo.range = sizeof(VkDrawIndexedIndirectCommand);
+
+  VkDescriptorBufferInfo visibleInfo{};
+  visibleInfo.buffer = cullingData.rdVisibleBuffer;
+  visibleInfo.offset = 0;
+  visibleInfo.range = maxInstances * sizeof(uint32_t);
+
+  VkWriteDescriptorSet writeDescriptorSets[2]{};
+  writeDescriptorSets[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  writeDescriptorSets[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+  writeDescriptorSets[0].dstSet = cullingData.rdDescriptorSet;
+  writeDescriptorSets[0].dstBinding = 0;
+  writeDescriptorSets[0].descriptorCount = 1;
+  writeDescriptorSets[0].pBufferInfo = &indirectInfo;
+
+  writeDescriptorSets[1] = writeDescriptorSets[0];
+  writeDescriptorSets[1].dstBinding = 1;
+  writeDescriptorSets[1].pBufferInfo = &visibleInfo;
+
+  vkUpdateDescriptorSets(renderData.rdVkbDevice.device, 2, writeDescriptorSets, 0, nullptr);
+
+  /* the compute shader reads the instance matrices of the current frame from the upload ring */
+  VkDescriptorSetLayout layouts[] = { renderData.rdInstanceMatrixSSBO.rdSSBODescriptorLayout,
+    cullingData.rdDescriptorLayout };
+
+  VkPushConstantRange pushConstants{};
+  pushConstants.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  pushConstants.offset = 0;
+  pushConstants.size = sizeof(VkCullPushConstants);
+
+  VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+  pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  pipelineLayoutInfo.setLayoutCount = 2;
+  pipelineLayoutInfo.pSetLayouts = layouts;
+  pipelineLayoutInfo.pushConstantRangeCount = 1;
+  pipelineLayoutInfo.pPushConstantRanges = &pushConstants;
+
+  if (vkCreatePipelineLayout(renderData.rdVkbDevice.device, &pipelineLayoutInfo, nullptr,
+      &cullingData.rdCullPipelineLayout) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not create culling pipeline layout\n", __FUNCTION__);
+    return false;
+  }
+
+  Logger::log(1, "%s: created culling buffers for %i instances\n", __FUNCTION__, maxInstances);
+  return true;
+}
+
+void GpuCulling::beginFrame(VkRenderData &renderData) {
+  VkGpuCullingData &cullingData = renderData.rdGpuCulling;
+  const unsigned int frame = renderData.rdCurrentFrame;
+  if (!cullingData.rdFrameCountCopied.at(frame)) {
+    return;
+  }
+  cullingData.rdFrameCountCopied.at(frame) = false;
+
+  /* no-op for host coherent memory */
+  vmaInvalidateAllocation(renderData.rdAllocator, cullingData.rdReadbackBufferAlloc, frame * sizeof(uint32_t),
+    sizeof(uint32_t));
+
+  uint32_t visibleInstances = cullingData.rdReadbackData[frame];
+  uint32_t instanceCount = cullingData.rdFrameInstanceCounts.at(frame);
+  renderData.rdVisibleInstances = visibleInstances;
+  renderData.rdCulledInstances = instanceCount > visibleInstances ? instanceCount - visibleInstances : 0;
+}
+
+void GpuCulling::cull(VkRenderData &renderData, VkCommandBuffer commandBuffer, const glm::mat4 &projectionView,
+    const glm::vec4 &boundingSphere, const uint32_t instanceCount, const uint32_t indexCount) {
+  VkGpuCullingData &cullingData = renderData.rdGpuCulling;
+  const unsigned int frame = renderData.rdCurrentFrame;
+  cullingData.rdDynamicOffsets.at(0) = static_cast<uint32_t>(frame * cullingData.rdIndirectRegionSize);
+  cullingData.rdDynamicOffsets.at(1) = static_cast<uint32_t>(frame * cullingData.rdVisibleRegionSize);
+  cullingData.rdFrameInstanceCounts.at(frame) = instanceCount;
+
+  /* the compute shader only counts the instances */
+  VkDrawIndexedIndirectCommand drawCommand{};
+  drawCommand.indexCount = indexCount;
+  drawCommand.instanceCount = 0;
+  drawCommand.firstIndex = 0;
+  drawCommand.vertexOffset = 0;
+  drawCommand.firstInstance = 0;
+
+  vkCmdUpdateBuffer(commandBuffer, cullingData.rdIndirectBuffer, cullingData.rdDynamicOffsets.at(0),
+    sizeof(VkDrawIndexedIndirectCommand), &drawCommand);
+
+  VkMemoryBarrier resetBarrier{};
+  resetBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  resetBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  resetBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    0, 1, &resetBarrier, 0, nullptr, 0, nullptr);
+
+  VkCullPushConstants pushConstants{};
+  if (renderData.rdFrustumCulling) {
+    pushConstants.frustumPlanes = getFrustumPlanes(projectionView);
+  } else {
+    /* every instance is in front of these planes */
+    pushConstants.frustumPlanes.fill(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+  }
+  pushConstants.boundingSphere = boundingSphere;
+  pushConstants.instanceCount = instanceCount;
+
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullingData.rdCullPipeline);
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+    cullingData.rdCullPipelineLayout, 0, 1, &renderData.rdInstanceMatrixSSBO.rdSSBODescriptorSet,
+    1, &renderData.rdInstanceMatrixSSBO.rdSsboDynamicOffset);
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+    cullingData.rdCullPipelineLayout, 1, 1, &cullingData.rdDescriptorSet,
+    static_cast<uint32_t>(cullingData.rdDynamicOffsets.size()), cullingData.rdDynamicOffsets.data());
+  vkCmdPushConstants(commandBuffer, cullingData.rdCullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+    sizeof(VkCullPushConstants), &pushConstants);
+
+  /* must match the local size of the compute shader */
+  vkCmdDispatch(commandBuffer, (instanceCount + 63) / 64, 1, 1);
+
+  /* the draw reads the command and the ids, copyVisibleCount() copies the instance count after the render pass */
+  VkMemoryBarrier cullBarrier{};
+  cullBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+  cullBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT |
+    VK_ACCESS_TRANSFER_READ_BIT;
+
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+    0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+}
+
+void GpuCulling::copyVisibleCount(VkRenderData &renderData, VkCommandBuffer commandBuffer) {
+  VkGpuCullingData &cullingData = renderData.rdGpuCulling;
+  const unsigned int frame = renderData.rdCurrentFrame;
+
+  /* instanceCount of the draw command */
+  VkBufferCopy countCopy{};
+  countCopy.srcOffset = cullingData.rdDynamicOffsets.at(0) + offsetof(VkDrawIndexedIndirectCommand, instanceCount);
+  countCopy.dstOffset = frame * sizeof(uint32_t);
+  countCopy.size = sizeof(uint32_t);
+
+  vkCmdCopyBuffer(commandBuffer, cullingData.rdIndirectBuffer, cullingData.rdReadbackBuffer, 1, &countCopy);
+
+  VkMemoryBarrier hostBarrier{};
+  hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+    0, 1, &hostBarrier, 0, nullptr, 0, nullptr);
+
+  cullingData.rdFrameCountCopied.at(frame) = true;
+}
+
+VkDeviceSize GpuCulling::getIndirectOffset(VkRenderData &renderData) {
+  return renderData.rdGpuCulling.rdDynamicOffsets.at(0);
+}
+
+void GpuCulling::cleanup(VkRenderData &renderData) {
+  VkGpuCullingData &cullingData = renderData.rdGpuCulling;
+
+  vkDestroyPipelineLayout(renderData.rdVkbDevice.device, cullingData.rdCullPipelineLayout, nullptr);
+  vkDestroyDescriptorPool(renderData.rdVkbDevice.device, cullingData.rdDescriptorPool, nullptr);
+  vkDestroyDescriptorSetLayout(renderData.rdVkbDevice.device, cullingData.rdDescriptorLayout, nullptr);
+
+  vmaDestroyBuffer(renderData.rdAllocator, cullingData.rdReadbackBuffer, cullingData.rdReadbackBufferAlloc);
+  vmaDestroyBuffer(renderData.rdAllocator, cullingData.rdVisibleBuffer, cullingData.rdVisibleBufferAlloc);
+  vmaDestroyBuffer(renderData.rdAllocator, cullingData.rdIndirectBuffer, cullingData.rdIndirectBufferAlloc);
+  cullingData.rdReadbackData = nullptr;
+}
+
+std::array<glm::vec4, 6> GpuCulling::getFrustumPlanes(const glm::mat4 &projectionView) {
+  /* rows of the matrix, glm stores the columns */
+  std::array<glm::vec4, 4> rows{};
+  for (int i = 0; i < 4; ++i) {
+    rows.at(i) = glm::vec4(projectionView[0][i], projectionView[1][i], projectionView[2][i], projectionView[3][i]);
+  }
+
+  /* left, right, bottom, top, near and far
+   * the near plane of the OpenGL depth range lies behind the near plane of the projection, nothing visible is culled */
+  std::array<glm::vec4, 6> planes = {
+    rows.at(3) + rows.at(0), rows.at(3) - rows.at(0),
+    rows.at(3) + rows.at(1), rows.at(3) - rows.at(1),
+    rows.at(3) + rows.at(2), rows.at(3) - rows.at(2)
+  };
+
+  /* normalized planes give the distance to the sphere center */
+  for (auto &plane : planes) {
+    plane /= glm::length(glm::vec3(plane));
+  }
+  return planes;
+}
@@ -0,0 +1,37 @@
+/* frustum culling of the model instances in a compute shader, the model is drawn with an indirect draw call */
+#pragma once
+
+#include <array>
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+
+#include "VkRenderData.h"
+
+/* must match the push constants of the culling compute shader */
+struct VkCullPushConstants {
+  std::array<glm::vec4, 6> frustumPlanes;
+  glm::vec4 boundingSphere;
+  uint32_t instanceCount;
+};
+
+class GpuCulling {
+  public:
+    /* buffers, descriptor set and pipeline layout for up to maxInstances instances, needs the instance matrix SSBO */
+    static bool init(VkRenderData &renderData, const uint32_t maxInstances);
+    /* reads the visible instances of the last frame with this index, must be called after the fence of the current frame was signaled */
+    static void beginFrame(VkRenderData &renderData);
+
+    /* resets the draw command and tests the instances against the frustum, must be recorded outside of a render pass
+     * the bounding sphere is in model space, the instance matrices must be uploaded already */
+    static void cull(VkRenderData &renderData, VkCommandBuffer commandBuffer, const glm::mat4 &projectionView,
+      const glm::vec4 &boundingSphere, const uint32_t instanceCount, const uint32_t indexCount);
+    /* copies the visible instance count of the current frame for the UI, must be recorded after the draw */
+    static void copyVisibleCount(VkRenderData &renderData, VkCommandBuffer commandBuffer);
+
+    static VkDeviceSize getIndirectOffset(VkRenderData &renderData);
+    static void cleanup(VkRenderData &renderData);
+
+  private:
+    /* normalized planes of the view frustum, the normals point inside */
+    static std::array<glm::vec4, 6> getFrustumPlanes(const glm::mat4 &projectionView);
+};
@@ -0,0 +1,195 @@
+#include <fstream>
+
+#include "GpuProfiler.h"
+#include "Logger.h"
+
+#include <VkBootstrap.h>
+
+bool GpuProfiler::init(VkRenderData &renderData) {
+  VkGpuProfilerData &profilerData = renderData.rdGpuProfiler;
+  profilerData.rdFrameQueriesReset.resize(VkRenderData::rdMaxFramesInFlight, false);
+
+  /* timestamps are optional, without them the profiler stays silent */
+  uint32_t graphicsQueueFamily = renderData.rdVkbDevice.get_queue_index(vkb::QueueType::graphics).value();
+  std::vector<VkQueueFamilyProperties> queueFamilies = renderData.rdVkbPhysicalDevice.get_queue_families();
+  uint32_t validBits = queueFamilies.at(graphicsQueueFamily).timestampValidBits;
+  if (validBits == 0) {
+    Logger::log(1, "%s: graphics queue has no timestamp support, GPU profiling disabled\n", __FUNCTION__);
+    return true;
+  }
+
+  profilerData.rdTimestampPeriod = renderData.rdVkbPhysicalDevice.properties.limits.timestampPeriod;
+  profilerData.rdTimestampMask = validBits >= 64 ? ~0ULL : (1ULL << validBits) - 1;
+
+  /* begin and end query per scope and frame in flight */
+  VkQueryPoolCreateInfo queryPoolInfo{};
+  queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+  queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+  queryPoolInfo.queryCount = VkRenderData::rdMaxFramesInFlight * VkGpuProfilerData::rdNumScopes * 2;
+
+  if (vkCreateQueryPool(renderData.rdVkbDevice.device, &queryPoolInfo, nullptr, &profilerData.rdQueryPool) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not create timestamp query pool\n", __FUNCTION__);
+    return false;
+  }
+
+  profilerData.rdTimestampsSupported = true;
+  Logger::log(1, "%s: created %i timestamp queries, %i valid bits, %f ns per tick\n", __FUNCTION__,
+    queryPoolInfo.queryCount, validBits, profilerData.rdTimestampPeriod);
+  return true;
+}
+
+void GpuProfiler::beginFrame(VkRenderData &renderData) {
+  VkGpuProfilerData &profilerData = renderData.rdGpuProfiler;
+  if (!profilerData.rdTimestampsSupported || !profilerData.rdFrameQueriesReset.at(renderData.rdCurrentFrame)) {
+    return;
+  }
+  profilerData.rdFrameQueriesReset.at(renderData.rdCurrentFrame) = false;
+
+  /* value and availability per query, skipped scopes are not available */
+  std::array<uint64_t, VkGpuProfilerData::rdNumScopes * 2 * 2> queryResults{};
+  VkResult result = vkGetQueryPoolResults(renderData.rdVkbDevice.device, profilerData.rdQueryPool,
+    getFirstQuery(renderData.rdCurrentFrame), VkGpuProfilerData::rdNumScopes * 2,
+    sizeof(queryResults), queryResults.data(), 2 * sizeof(uint64_t),
+    VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+  if (result != VK_SUCCESS && result != VK_NOT_READY) {
+    Logger::log(1, "%s error: could not read timestamp queries (error: %i)\n", __FUNCTION__, result);
+    return;
+  }
+
+  for (int i = 0; i < VkGpuProfilerData::rdNumScopes; ++i) {
+    const uint64_t *beginQuery = &queryResults.at(i * 4);
+    const uint64_t *endQuery = &queryResults.at(i * 4 + 2);
+
+    if (beginQuery[1] == 0 || endQuery[1] == 0) {
+      profilerData.rdScopeTimes.at(i) = 0.0f;
+      continue;
+    }
+
+    uint64_t ticks = (endQuery[0] - beginQuery[0]) & profilerData.rdTimestampMask;
+    profilerData.rdScopeTimes.at(i) = static_cast<float>(ticks) * profilerData.rdTimestampPeriod / 1000000.0f;
+  }
+
+  if (profilerData.rdCaptureRunning) {
+    addCaptureRow(renderData);
+  }
+}
+
+void GpuProfiler::resetQueries(VkRenderData &renderData, VkCommandBuffer commandBuffer) {
+  VkGpuProfilerData &profilerData = renderData.rdGpuProfiler;
+  if (!profilerData.rdTimestampsSupported) {
+    return;
+  }
+
+  vkCmdResetQueryPool(commandBuffer, profilerData.rdQueryPool, getFirstQuery(renderData.rdCurrentFrame),
+    VkGpuProfilerData::rdNumScopes * 2);
+  profilerData.rdFrameQueriesReset.at(renderData.rdCurrentFrame) = true;
+}
+
+void GpuProfiler::beginScope(VkRenderData &renderData, VkCommandBuffer commandBuffer, const gpuScope scope) {
+  VkGpuProfilerData &profilerData = renderData.rdGpuProfiler;
+  if (!profilerData.rdTimestampsSupported) {
+    return;
+  }
+
+  uint32_t query = getFirstQuery(renderData.rdCurrentFrame) + static_cast<uint32_t>(scope) * 2;
+  vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, profilerData.rdQueryPool, query);
+}
+
+void GpuProfiler::endScope(VkRenderData &renderData, VkCommandBuffer commandBuffer, const gpuScope scope) {
+  VkGpuProfilerData &profilerData = renderData.rdGpuProfiler;
+  if (!profilerData.rdTimestampsSupported) {
+    return;
+  }
+
+  uint32_t query = getFirstQuery(renderData.rdCurrentFrame) + static_cast<uint32_t>(scope) * 2 + 1;
+  vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, profilerData.rdQueryPool, query);
+}
+
+void GpuProfiler::startCapture(VkRenderData &renderData, const int numFrames, const std::string fileName) {
+  VkGpuProfilerData &profilerData = renderData.rdGpuProfiler;
+  if (!profilerData.rdTimestampsSupported || profilerData.rdCaptureRunning || numFrames <= 0) {
+    return;
+  }
+
+  profilerData.rdCaptureRows.clear();
+  profilerData.rdCaptureRows.reserve(numFrames);
+  profilerData.rdCaptureFrameCount = numFrames;
+  profilerData.rdCaptureFileName = fileName;
+  profilerData.rdCaptureRunning = true;
+  Logger::log(1, "%s: capturing GPU times of %i frames\n", __FUNCTION__, numFrames);
+}
+
+const char* GpuProfiler::getScopeName(const gpuScope scope) {
+  switch (scope) {
+    case gpuScope::culling:
+      return "Culling";
+    case gpuScope::modelDraw:
+      return "Model Draw";
+    case gpuScope::lines:
+      return "Lines";
+    case gpuScope::skeleton:
+      return "Skeleton";
+    case gpuScope::userInterface:
+      return "UI";
+    default:
+      return "Unknown";
+  }
+}
+
+void GpuProfiler::cleanup(VkRenderData &renderData) {
+  VkGpuProfilerData &profilerData = renderData.rdGpuProfiler;
+
+  /* keep the frames captured so far */
+  if (profilerData.rdCaptureRunning) {
+    saveCapture(renderData);
+    profilerData.rdCaptureRunning = false;
+  }
+
+  vkDestroyQueryPool(renderData.rdVkbDevice.device, profilerData.rdQueryPool, nullptr);
+  profilerData.rdQueryPool = VK_NULL_HANDLE;
+  profilerData.rdTimestampsSupported = false;
+}
+
+uint32_t GpuProfiler::getFirstQuery(const unsigned int frame) {
+  return frame * VkGpuProfilerData::rdNumScopes * 2;
+}
+
+void GpuProfiler::addCaptureRow(VkRenderData &renderData) {
+  VkGpuProfilerData &profilerData = renderData.rdGpuProfiler;
+  profilerData.rdCaptureRows.emplace_back(profilerData.rdScopeTimes);
+
+  if (profilerData.rdCaptureRows.size() >= static_cast<size_t>(profilerData.rdCaptureFrameCount)) {
+    saveCapture(renderData);
+    profilerData.rdCaptureRunning = false;
+  }
+}
+
+bool GpuProfiler::saveCapture(VkRenderData &renderData) {
+  VkGpuProfilerData &profilerData = renderData.rdGpuProfiler;
+
+  std::ofstream outFile(profilerData.rdCaptureFileName, std::ios::trunc);
+  if (!outFile.is_open()) {
+    Logger::log(1, "%s error: could not open '%s' for writing\n", __FUNCTION__, profilerData.rdCaptureFileName.c_str());
+    return false;
+  }
+
+  /* one column per scope in milliseconds, skipped scopes are zero */
+  outFile << "frame";
+  for (int i = 0; i < VkGpuProfilerData::rdNumScopes; ++i) {
+    outFile << "," << getScopeName(static_cast<gpuScope>(i)) << " (ms)";
+  }
+  outFile << "\n";
+
+  for (size_t row = 0; row < profilerData.rdCaptureRows.size(); ++row) {
+    outFile << row;
+    for (const auto value : profilerData.rdCaptureRows.at(row)) {
+      outFile << "," << value;
+    }
+    outFile << "\n";
+  }
+  outFile.close();
+
+  Logger::log(1, "%s: saved GPU times of %i frames to '%s'\n", __FUNCTION__, profilerData.rdCaptureRows.size(),
+    profilerData.rdCaptureFileName.c_str());
+  return true;
+}
@@ -0,0 +1,31 @@
+/* GPU timestamp queries for named scopes of the frame */
+#pragma once
+
+#include <string>
+#include <vulkan/vulkan.h>
+
+#include "VkRenderData.h"
+
+class GpuProfiler {
+  public:
+    static bool init(VkRenderData &renderData);
+    /* reads the results of the last frame with this index, must be called after the fence of the current frame was signaled */
+    static void beginFrame(VkRenderData &renderData);
+    /* resets the queries of the current frame, must be recorded outside of a render pass */
+    static void resetQueries(VkRenderData &renderData, VkCommandBuffer commandBuffer);
+
+    /* only record commands, safe to call from several threads for different command buffers */
+    static void beginScope(VkRenderData &renderData, VkCommandBuffer commandBuffer, const gpuScope scope);
+    static void endScope(VkRenderData &renderData, VkCommandBuffer commandBuffer, const gpuScope scope);
+
+    /* collects the scope times of the next numFrames frames and writes them to a CSV file */
+    static void startCapture(VkRenderData &renderData, const int numFrames, const std::string fileName);
+
+    static const char* getScopeName(const gpuScope scope);
+    static void cleanup(VkRenderData &renderData);
+
+  private:
+    static uint32_t getFirstQuery(const unsigned int frame);
+    static void addCaptureRow(VkRenderData &renderData);
+    static bool saveCapture(VkRenderData &renderData);
+};
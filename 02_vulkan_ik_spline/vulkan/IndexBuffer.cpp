@@ -1,5 +1,6 @@
 #include "IndexBuffer.h"
 #include "CommandBuffer.h"
+#include "UploadManager.h"
 #include "Logger.h"
 
 bool IndexBuffer::init(VkRenderData &renderData, VkIndexBufferData &indexBufferData,
@@ -21,21 +22,6 @@ bool IndexBuffer::init(VkRenderData &renderData, VkIndexBufferData &indexBufferD
     return false;
   }
 
-  /* staging buffer for copy */
-  VkBufferCreateInfo stagingBufferInfo{};
-  stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  stagingBufferInfo.size = bufferSize;;
-  stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-  VmaAllocationCreateInfo stagingAllocInfo{};
-  stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-  if (vmaCreateBuffer(renderData.rdAllocator, &stagingBufferInfo, &stagingAllocInfo,
-      &indexBufferData.rdStagingBuffer, &indexBufferData.rdStagingBufferAlloc,
-      nullptr) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate index staging buffer via VMA\n", __FUNCTION__);
-    return false;
-  }
   indexBufferData.rdIndexBufferSize = bufferSize;
   return true;
 }
@@ -55,38 +41,18 @@ bool IndexBuffer::uploadData(VkRenderData &renderData, VkIndexBufferData &indexB
     indexBufferData.rdIndexBufferSize = bufferView.byteLength;
   }
 
-  /* copy data to staging buffer*/
-  void* data;
-  vmaMapMemory(renderData.rdAllocator, indexBufferData.rdStagingBufferAlloc, &data);
-  memcpy(data, &buffer.data.at(0) + bufferView.byteOffset, bufferView.byteLength);
-  vmaUnmapMemory(renderData.rdAllocator, indexBufferData.rdStagingBufferAlloc);
-
-  VkBufferMemoryBarrier vertexBufferBarrier{};
-  vertexBufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-  vertexBufferBarrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
-  vertexBufferBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-  vertexBufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-  vertexBufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-  vertexBufferBarrier.buffer = indexBufferData.rdStagingBuffer;
-  vertexBufferBarrier.offset = 0;
-  vertexBufferBarrier.size = indexBufferData.rdIndexBufferSize;
-
-  VkBufferCopy stagingBufferCopy{};
-  stagingBufferCopy.srcOffset = 0;
-  stagingBufferCopy.dstOffset = 0;
-  stagingBufferCopy.size = indexBufferData.rdIndexBufferSize;
-
-  vkCmdCopyBuffer(renderData.rdCommandBuffer, indexBufferData.rdStagingBuffer,
-    indexBufferData.rdIndexBuffer, 1, &stagingBufferCopy);
-  vkCmdPipelineBarrier(renderData.rdCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-    VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, nullptr, 1, &vertexBufferBarrier, 0, nullptr);
+  /* recorded into the upload batch, the buffer is ready after the batch is complete */
+  if (!UploadManager::uploadBuffer(renderData, indexBufferData.rdIndexBuffer,
+      &buffer.data.at(0) + bufferView.byteOffset, bufferView.byteLength,
+      VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT)) {
+    Logger::log(1, "%s error: could not upload index buffer data\n", __FUNCTION__);
+    return false;
+  }
 
   return true;
 }
 
 void IndexBuffer::cleanup(VkRenderData &renderData, VkIndexBufferData &indexBufferData) {
-  vmaDestroyBuffer(renderData.rdAllocator, indexBufferData.rdStagingBuffer,
-    indexBufferData.rdStagingBufferAlloc);
   vmaDestroyBuffer(renderData.rdAllocator, indexBufferData.rdIndexBuffer,
     indexBufferData.rdIndexBufferAlloc);
 }
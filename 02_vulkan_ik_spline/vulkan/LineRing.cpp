@@ -0,0 +1,97 @@
+#include "LineRing.h"
+#include "Logger.h"
+
+bool LineRing::init(VkRenderData &renderData, const uint32_t maxVerticesPerFrame) {
+  VkLineRingData &lineData = renderData.rdLineRing;
+  lineData.rdFrameCapacity = maxVerticesPerFrame;
+
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size = static_cast<VkDeviceSize>(maxVerticesPerFrame) * sizeof(VkVertex) *
+    VkRenderData::rdMaxFramesInFlight;
+  bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  /* read directly by the vertex input stage, no staging copy */
+  VmaAllocationCreateInfo vmaAllocInfo{};
+  vmaAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+  vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+  VmaAllocationInfo allocInfo{};
+  if (vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo, &lineData.rdLineBuffer,
+      &lineData.rdLineBufferAlloc, &allocInfo) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not allocate line vertex buffer via VMA\n", __FUNCTION__);
+    return false;
+  }
+  lineData.rdMappedVertices = static_cast<VkVertex*>(allocInfo.pMappedData);
+
+  Logger::log(1, "%s: created line ring with %i regions of %i vertices\n", __FUNCTION__,
+    VkRenderData::rdMaxFramesInFlight, maxVerticesPerFrame);
+  return true;
+}
+
+void LineRing::beginFrame(VkRenderData &renderData) {
+  VkLineRingData &lineData = renderData.rdLineRing;
+  lineData.rdFrameStart = renderData.rdCurrentFrame * lineData.rdFrameCapacity;
+  lineData.rdVertexCount = 0;
+}
+
+void LineRing::addLine(VkRenderData &renderData, const glm::vec3 &startPos, const glm::vec3 &startColor,
+    const glm::vec3 &endPos, const glm::vec3 &endColor) {
+  VkVertex *vertices = reserveVertices(renderData, 2);
+  if (!vertices) {
+    return;
+  }
+
+  vertices[0].position = startPos;
+  vertices[0].color = startColor;
+  vertices[0].uv = glm::vec2(0.0f);
+  vertices[1].position = endPos;
+  vertices[1].color = endColor;
+  vertices[1].uv = glm::vec2(0.0f);
+}
+
+VkVertex* LineRing::reserveVertices(VkRenderData &renderData, const uint32_t numVertices) {
+  VkLineRingData &lineData = renderData.rdLineRing;
+  if (lineData.rdVertexCount + numVertices > lineData.rdFrameCapacity) {
+    if (!lineData.rdOverflowLogged) {
+      Logger::log(1, "%s error: line ring region full (%i vertices), lines are dropped\n", __FUNCTION__,
+        lineData.rdFrameCapacity);
+      lineData.rdOverflowLogged = true;
+    }
+    return nullptr;
+  }
+
+  VkVertex *vertices = lineData.rdMappedVertices + lineData.rdFrameStart + lineData.rdVertexCount;
+  lineData.rdVertexCount += numVertices;
+  return vertices;
+}
+
+uint32_t LineRing::getVertexCount(VkRenderData &renderData) {
+  return renderData.rdLineRing.rdVertexCount;
+}
+
+void LineRing::endFrame(VkRenderData &renderData) {
+  VkLineRingData &lineData = renderData.rdLineRing;
+  if (lineData.rdVertexCount == 0) {
+    return;
+  }
+
+  /* no-op for host coherent memory */
+  vmaFlushAllocation(renderData.rdAllocator, lineData.rdLineBufferAlloc,
+    static_cast<VkDeviceSize>(lineData.rdFrameStart) * sizeof(VkVertex),
+    static_cast<VkDeviceSize>(lineData.rdVertexCount) * sizeof(VkVertex));
+}
+
+void LineRing::bind(VkRenderData &renderData, VkCommandBuffer commandBuffer) {
+  VkLineRingData &lineData = renderData.rdLineRing;
+  VkDeviceSize offset = static_cast<VkDeviceSize>(lineData.rdFrameStart) * sizeof(VkVertex);
+  vkCmdBindVertexBuffers(commandBuffer, 0, 1, &lineData.rdLineBuffer, &offset);
+}
+
+void LineRing::cleanup(VkRenderData &renderData) {
+  VkLineRingData &lineData = renderData.rdLineRing;
+  vmaDestroyBuffer(renderData.rdAllocator, lineData.rdLineBuffer, lineData.rdLineBufferAlloc);
+  lineData.rdLineBuffer = VK_NULL_HANDLE;
+  lineData.rdMappedVertices = nullptr;
+}
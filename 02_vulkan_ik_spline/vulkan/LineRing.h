@@ -0,0 +1,26 @@
+/* immediate mode line drawing, the vertices are written directly into a mapped per-frame vertex buffer region */
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+
+#include "VkRenderData.h"
+
+class LineRing {
+  public:
+    static bool init(VkRenderData &renderData, const uint32_t maxVerticesPerFrame);
+    /* must be called after the fence of the current frame was signaled */
+    static void beginFrame(VkRenderData &renderData);
+
+    static void addLine(VkRenderData &renderData, const glm::vec3 &startPos, const glm::vec3 &startColor,
+      const glm::vec3 &endPos, const glm::vec3 &endColor);
+    /* space for numVertices vertices in the region of the current frame, nullptr if the region is full */
+    static VkVertex* reserveVertices(VkRenderData &renderData, const uint32_t numVertices);
+    /* vertices written in the current frame, relative to the bound buffer offset */
+    static uint32_t getVertexCount(VkRenderData &renderData);
+
+    /* makes the written vertices visible to the GPU, must be called before the submit */
+    static void endFrame(VkRenderData &renderData);
+    static void bind(VkRenderData &renderData, VkCommandBuffer commandBuffer);
+    static void cleanup(VkRenderData &renderData);
+};
@@ -8,13 +8,22 @@ bool PipelineLayout::init(VkRenderData &renderData, VkTextureData &textureData,
   VkDescriptorSetLayout layouts [] = { textureData.texTextureDescriptorLayout,
     renderData.rdPerspViewMatrixUBO.rdUBODescriptorLayout,
     renderData.rdJointMatrixSSBO.rdSSBODescriptorLayout,
-    renderData.rdJointDualQuatSSBO.rdSSBODescriptorLayout };
+    renderData.rdJointDualQuatSSBO.rdSSBODescriptorLayout,
+    renderData.rdInstanceMatrixSSBO.rdSSBODescriptorLayout,
+    renderData.rdGpuCulling.rdDescriptorLayout };
+
+  /* number of joints per instance, the joint data of instance i starts at i * stride */
+  VkPushConstantRange pushConstants{};
+  pushConstants.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+  pushConstants.offset = 0;
+  pushConstants.size = sizeof(int);
 
   VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
   pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-  pipelineLayoutInfo.setLayoutCount = 4;
+  pipelineLayoutInfo.setLayoutCount = 6;
   pipelineLayoutInfo.pSetLayouts = layouts;
-  pipelineLayoutInfo.pushConstantRangeCount = 0;
+  pipelineLayoutInfo.pushConstantRangeCount = 1;
+  pipelineLayoutInfo.pPushConstantRanges = &pushConstants;
 
   if (vkCreatePipelineLayout(renderData.rdVkbDevice.device, &pipelineLayoutInfo, nullptr,
       &pipelineLayout) != VK_SUCCESS) {
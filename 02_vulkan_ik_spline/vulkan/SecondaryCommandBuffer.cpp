@@ -0,0 +1,103 @@
+#include "SecondaryCommandBuffer.h"
+#include "Logger.h"
+
+#include <VkBootstrap.h>
+
+bool SecondaryCommandBuffer::init(VkRenderData &renderData, const unsigned int numThreads) {
+  renderData.rdRecordThreads = numThreads;
+  renderData.rdRecordPools.resize(numThreads * VkRenderData::rdMaxFramesInFlight);
+
+  /* command pools are not thread safe, every thread records from its own pools */
+  VkCommandPoolCreateInfo poolCreateInfo{};
+  poolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  poolCreateInfo.queueFamilyIndex = renderData.rdVkbDevice.get_queue_index(vkb::QueueType::graphics).value();
+  poolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+  for (auto &recordPool : renderData.rdRecordPools) {
+    if (vkCreateCommandPool(renderData.rdVkbDevice.device, &poolCreateInfo, nullptr, &recordPool.rpCommandPool) != VK_SUCCESS) {
+      Logger::log(1, "%s error: could not create secondary command pool\n", __FUNCTION__);
+      return false;
+    }
+  }
+
+  Logger::log(1, "%s: created %i command pools for %i recording threads\n", __FUNCTION__,
+    renderData.rdRecordPools.size(), numThreads);
+  return true;
+}
+
+bool SecondaryCommandBuffer::beginFrame(VkRenderData &renderData) {
+  for (unsigned int i = 0; i < renderData.rdRecordThreads; ++i) {
+    VkRecordPoolData &recordPool = getRecordPool(renderData, i, renderData.rdCurrentFrame);
+    if (recordPool.rpUsedCommandBuffers == 0) {
+      continue;
+    }
+
+    if (vkResetCommandPool(renderData.rdVkbDevice.device, recordPool.rpCommandPool, 0) != VK_SUCCESS) {
+      Logger::log(1, "%s error: could not reset secondary command pool\n", __FUNCTION__);
+      return false;
+    }
+    recordPool.rpUsedCommandBuffers = 0;
+  }
+  return true;
+}
+
+VkCommandBuffer SecondaryCommandBuffer::begin(VkRenderData &renderData, const unsigned int threadIndex,
+    VkFramebuffer framebuffer) {
+  VkRecordPoolData &recordPool = getRecordPool(renderData, threadIndex, renderData.rdCurrentFrame);
+
+  /* the pool grows to the largest number of buffers a thread has recorded in one frame */
+  if (recordPool.rpUsedCommandBuffers == recordPool.rpCommandBuffers.size()) {
+    VkCommandBufferAllocateInfo bufferAllocInfo{};
+    bufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    bufferAllocInfo.commandPool = recordPool.rpCommandPool;
+    bufferAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    bufferAllocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    if (vkAllocateCommandBuffers(renderData.rdVkbDevice.device, &bufferAllocInfo, &commandBuffer) != VK_SUCCESS) {
+      Logger::log(1, "%s error: could not allocate secondary command buffer\n", __FUNCTION__);
+      return VK_NULL_HANDLE;
+    }
+    recordPool.rpCommandBuffers.emplace_back(commandBuffer);
+  }
+  VkCommandBuffer commandBuffer = recordPool.rpCommandBuffers.at(recordPool.rpUsedCommandBuffers++);
+
+  VkCommandBufferInheritanceInfo inheritanceInfo{};
+  inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+  inheritanceInfo.renderPass = renderData.rdRenderpass;
+  inheritanceInfo.subpass = 0;
+  inheritanceInfo.framebuffer = framebuffer;
+
+  VkCommandBufferBeginInfo cmdBeginInfo{};
+  cmdBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  cmdBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+  cmdBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+  if (vkBeginCommandBuffer(commandBuffer, &cmdBeginInfo) != VK_SUCCESS) {
+    Logger::log(1, "%s error: failed to begin secondary command buffer\n", __FUNCTION__);
+    return VK_NULL_HANDLE;
+  }
+  return commandBuffer;
+}
+
+bool SecondaryCommandBuffer::end(VkCommandBuffer commandBuffer) {
+  if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+    Logger::log(1, "%s error: failed to end secondary command buffer\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
+void SecondaryCommandBuffer::cleanup(VkRenderData &renderData) {
+  /* destroying the pool frees its command buffers */
+  for (auto &recordPool : renderData.rdRecordPools) {
+    vkDestroyCommandPool(renderData.rdVkbDevice.device, recordPool.rpCommandPool, nullptr);
+  }
+  renderData.rdRecordPools.clear();
+  renderData.rdRecordThreads = 0;
+}
+
+VkRecordPoolData& SecondaryCommandBuffer::getRecordPool(VkRenderData &renderData, const unsigned int threadIndex,
+    const unsigned int frame) {
+  return renderData.rdRecordPools.at(threadIndex * VkRenderData::rdMaxFramesInFlight + frame);
+}
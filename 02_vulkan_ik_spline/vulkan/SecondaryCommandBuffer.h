@@ -0,0 +1,24 @@
+/* Vulkan secondary command buffers, recorded by several threads inside the render pass */
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "VkRenderData.h"
+
+class SecondaryCommandBuffer {
+  public:
+    /* one command pool per recording thread and frame in flight */
+    static bool init(VkRenderData &renderData, const unsigned int numThreads);
+    /* resets the pools of the current frame, must be called after the fence of the current frame was signaled */
+    static bool beginFrame(VkRenderData &renderData);
+
+    /* starts a buffer continuing the render pass in the framebuffer, only called by the thread with this index */
+    static VkCommandBuffer begin(VkRenderData &renderData, const unsigned int threadIndex, VkFramebuffer framebuffer);
+    static bool end(VkCommandBuffer commandBuffer);
+
+    static void cleanup(VkRenderData &renderData);
+
+  private:
+    static VkRecordPoolData& getRecordPool(VkRenderData &renderData, const unsigned int threadIndex,
+      const unsigned int frame);
+};
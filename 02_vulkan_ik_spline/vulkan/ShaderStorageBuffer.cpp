@@ -1,30 +1,18 @@
 #include "ShaderStorageBuffer.h"
+#include "UploadRing.h"
 #include "Logger.h"
 
 #include <VkBootstrap.h>
 
 bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferData &SSBOData,
-    std::vector<glm::mat4> matricesToUpload) {
-  VkBufferCreateInfo bufferInfo{};
-  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  bufferInfo.size = matricesToUpload.size() * sizeof(glm::mat4);
-  bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-
-  VmaAllocationCreateInfo vmaAllocInfo{};
-  vmaAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-
-  if (vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo,
-    &SSBOData.rdSsboBuffer, &SSBOData.rdSsboBufferAlloc, nullptr) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate shader storage buffer via VMA\n", __FUNCTION__);
-    return false;
-  }
-
+    const size_t bufferSize) {
   VkDescriptorSetLayoutBinding ssboBind{};
-  ssboBind.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  ssboBind.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
   ssboBind.binding = 0;
   ssboBind.descriptorCount = 1;
   ssboBind.pImmutableSamplers = nullptr;
-  ssboBind.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+  /* the instance matrices are also read by the culling compute shader */
+  ssboBind.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
 
   VkDescriptorSetLayoutCreateInfo ssboCreateInfo{};
   ssboCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
@@ -38,7 +26,7 @@ bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferDa
   }
 
   VkDescriptorPoolSize poolSize{};
-  poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
   poolSize.descriptorCount = 1;
 
   VkDescriptorPoolCreateInfo descriptorPool{};
@@ -65,14 +53,15 @@ bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferDa
     return false;
   }
 
+  /* like the uniform buffer, the data of the current frame is selected by the dynamic offset */
   VkDescriptorBufferInfo ssboInfo{};
-  ssboInfo.buffer = SSBOData.rdSsboBuffer;
+  ssboInfo.buffer = renderData.rdUploadRing.rdRingBuffer;
   ssboInfo.offset = 0;
-  ssboInfo.range = matricesToUpload.size() * sizeof(glm::mat4);
+  ssboInfo.range = bufferSize;
 
   VkWriteDescriptorSet writeDescriptorSet{};
   writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-  writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
   writeDescriptorSet.dstSet = SSBOData.rdSSBODescriptorSet;
   writeDescriptorSet.dstBinding = 0;
   writeDescriptorSet.descriptorCount = 1;
@@ -80,89 +69,20 @@ bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferDa
 
   vkUpdateDescriptorSets(renderData.rdVkbDevice.device, 1, &writeDescriptorSet, 0, nullptr);
 
-  Logger::log(1, "%s: created shader storage buffer of size %i\n", __FUNCTION__, ssboInfo.range);
+  Logger::log(1, "%s: created shader storage buffer descriptor of size %i\n", __FUNCTION__, bufferSize);
 	return true;
 }
 
-bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferData &SSBOData,
-    std::vector<glm::mat2x4> matricesToUpload) {
-  VkBufferCreateInfo bufferInfo{};
-  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  bufferInfo.size = matricesToUpload.size() * sizeof(glm::mat2x4);
-  bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-
-  VmaAllocationCreateInfo vmaAllocInfo{};
-  vmaAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-
-  if (vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo,
-    &SSBOData.rdSsboBuffer, &SSBOData.rdSsboBufferAlloc, nullptr) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate shader storage buffer via VMA\n", __FUNCTION__);
-    return false;
-  }
-
-  VkDescriptorSetLayoutBinding ssboBind{};
-  ssboBind.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-  ssboBind.binding = 0;
-  ssboBind.descriptorCount = 1;
-  ssboBind.pImmutableSamplers = nullptr;
-  ssboBind.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
-  VkDescriptorSetLayoutCreateInfo ssboCreateInfo{};
-  ssboCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-  ssboCreateInfo.bindingCount = 1;
-  ssboCreateInfo.pBindings = &ssboBind;
-
-  if (vkCreateDescriptorSetLayout(renderData.rdVkbDevice.device, &ssboCreateInfo, nullptr,
-    &SSBOData.rdSSBODescriptorLayout) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not create SSBO descriptor set layout\n", __FUNCTION__);
-    return false;
-  }
-
-  VkDescriptorPoolSize poolSize{};
-  poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-  poolSize.descriptorCount = 1;
-
-  VkDescriptorPoolCreateInfo descriptorPool{};
-  descriptorPool.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-  descriptorPool.poolSizeCount = 1;
-  descriptorPool.pPoolSizes = &poolSize;
-  descriptorPool.maxSets = 1;
-
-  if (vkCreateDescriptorPool(renderData.rdVkbDevice.device, &descriptorPool, nullptr,
-      &SSBOData.rdSSBODescriptorPool) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not create SSBO descriptor pool\n", __FUNCTION__);
-    return false;
-  }
-
-  VkDescriptorSetAllocateInfo descriptorAllocateInfo{};
-  descriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-  descriptorAllocateInfo.descriptorPool = SSBOData.rdSSBODescriptorPool;
-  descriptorAllocateInfo.descriptorSetCount = 1;
-  descriptorAllocateInfo.pSetLayouts = &SSBOData.rdSSBODescriptorLayout;
-
-  if (vkAllocateDescriptorSets(renderData.rdVkbDevice.device, &descriptorAllocateInfo,
-      &SSBOData.rdSSBODescriptorSet) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate SSBO descriptor set\n", __FUNCTION__);
-    return false;
-  }
-
-  VkDescriptorBufferInfo ssboInfo{};
-  ssboInfo.buffer = SSBOData.rdSsboBuffer;
-  ssboInfo.offset = 0;
-  ssboInfo.range = matricesToUpload.size() * sizeof(glm::mat2x4);
-
-  VkWriteDescriptorSet writeDescriptorSet{};
-  writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-  writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-  writeDescriptorSet.dstSet = SSBOData.rdSSBODescriptorSet;
-  writeDescriptorSet.dstBinding = 0;
-  writeDescriptorSet.descriptorCount = 1;
-  writeDescriptorSet.pBufferInfo = &ssboInfo;
-
-  vkUpdateDescriptorSets(renderData.rdVkbDevice.device, 1, &writeDescriptorSet, 0, nullptr);
+bool ShaderStorageBuffer::uploadData(VkRenderData& renderData, VkShaderStorageBufferData &SSBOData,
+    const std::vector<glm::mat4>& matrices) {
+  return UploadRing::uploadData(renderData, matrices.data(), matrices.size() * sizeof(glm::mat4),
+    SSBOData.rdSsboDynamicOffset);
+}
 
-  Logger::log(1, "%s: created shader storage buffer of size %i\n", __FUNCTION__, ssboInfo.range);
-	return true;
+bool ShaderStorageBuffer::uploadData(VkRenderData& renderData, VkShaderStorageBufferData &SSBOData,
+    const std::vector<glm::mat2x4>& matrices) {
+  return UploadRing::uploadData(renderData, matrices.data(), matrices.size() * sizeof(glm::mat2x4),
+    SSBOData.rdSsboDynamicOffset);
 }
 
 void ShaderStorageBuffer::cleanup(VkRenderData& renderData, VkShaderStorageBufferData &SSBOData) {
@@ -170,5 +90,4 @@ void ShaderStorageBuffer::cleanup(VkRenderData& renderData, VkShaderStorageBuffe
     nullptr);
   vkDestroyDescriptorSetLayout(renderData.rdVkbDevice.device, SSBOData.rdSSBODescriptorLayout,
     nullptr);
-  vmaDestroyBuffer(renderData.rdAllocator, SSBOData.rdSsboBuffer, SSBOData.rdSsboBufferAlloc);
 }
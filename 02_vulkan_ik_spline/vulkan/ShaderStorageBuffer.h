@@ -9,9 +9,13 @@
 
 class ShaderStorageBuffer {
   public:
+    /* bufferSize is the largest upload, the descriptor range covers it at every dynamic offset */
     static bool init(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData,
-      std::vector<glm::mat4> matricesToUpload);
-    static bool init(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData,
-      std::vector<glm::mat2x4> matricesToUpload);
+      const size_t bufferSize);
+    /* copy into the upload ring, stores the offset in rdSsboDynamicOffset */
+    static bool uploadData(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData,
+      const std::vector<glm::mat4>& matrices);
+    static bool uploadData(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData,
+      const std::vector<glm::mat2x4>& matrices);
     static void cleanup(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData);
 };
@@ -11,17 +11,29 @@ bool SyncObjects::init(VkRenderData &renderData) {
   VkSemaphoreCreateInfo semaphoreInfo{};
   semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-  if (vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &renderData.rdPresentSemaphore) != VK_SUCCESS ||
-      vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &renderData.rdRenderSemaphore) != VK_SUCCESS ||
-      vkCreateFence(renderData.rdVkbDevice.device, &fenceInfo, nullptr, &renderData.rdRenderFence) != VK_SUCCESS) {
-    Logger::log(1, "%s error: failed to init sync objects\n", __FUNCTION__);
-    return false;
+  /* the fences start signaled, the first wait of every frame returns immediately */
+  renderData.rdPresentSemaphores.resize(VkRenderData::rdMaxFramesInFlight, VK_NULL_HANDLE);
+  renderData.rdRenderSemaphores.resize(VkRenderData::rdMaxFramesInFlight, VK_NULL_HANDLE);
+  renderData.rdRenderFences.resize(VkRenderData::rdMaxFramesInFlight, VK_NULL_HANDLE);
+
+  for (int i = 0; i < VkRenderData::rdMaxFramesInFlight; ++i) {
+    if (vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &renderData.rdPresentSemaphores.at(i)) != VK_SUCCESS ||
+        vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &renderData.rdRenderSemaphores.at(i)) != VK_SUCCESS ||
+        vkCreateFence(renderData.rdVkbDevice.device, &fenceInfo, nullptr, &renderData.rdRenderFences.at(i)) != VK_SUCCESS) {
+      Logger::log(1, "%s error: failed to init sync objects for frame %i\n", __FUNCTION__, i);
+      return false;
+    }
   }
   return true;
 }
 
 void SyncObjects::cleanup(VkRenderData &renderData) {
-  vkDestroySemaphore(renderData.rdVkbDevice.device, renderData.rdPresentSemaphore, nullptr);
-  vkDestroySemaphore(renderData.rdVkbDevice.device, renderData.rdRenderSemaphore, nullptr);
-  vkDestroyFence(renderData.rdVkbDevice.device, renderData.rdRenderFence, nullptr);
+  for (int i = 0; i < static_cast<int>(renderData.rdRenderFences.size()); ++i) {
+    vkDestroySemaphore(renderData.rdVkbDevice.device, renderData.rdPresentSemaphores.at(i), nullptr);
+    vkDestroySemaphore(renderData.rdVkbDevice.device, renderData.rdRenderSemaphores.at(i), nullptr);
+    vkDestroyFence(renderData.rdVkbDevice.device, renderData.rdRenderFences.at(i), nullptr);
+  }
+  renderData.rdPresentSemaphores.clear();
+  renderData.rdRenderSemaphores.clear();
+  renderData.rdRenderFences.clear();
 }
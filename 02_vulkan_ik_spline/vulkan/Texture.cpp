@@ -1,6 +1,6 @@
 #include <stb_image.h>
 
-#include "CommandBuffer.h"
+#include "UploadManager.h"
 #include "Texture.h"
 #include "Logger.h"
 
@@ -45,146 +45,19 @@ bool Texture::loadTexture(VkRenderData &renderData, VkTextureData& textureData,
     return false;
   }
 
-  /* staging buffer */
-  VkBufferCreateInfo stagingBufferInfo{};
-  stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  stagingBufferInfo.size = imageSize;
-  stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-  VkBuffer stagingBuffer;
-  VmaAllocation stagingBufferAlloc;
-
-  VmaAllocationCreateInfo stagingAllocInfo{};
-  stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-  if (vmaCreateBuffer(renderData.rdAllocator, &stagingBufferInfo, &stagingAllocInfo, &stagingBuffer,
-      &stagingBufferAlloc, nullptr) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate texture staging buffer via VMA\n", __FUNCTION__);
-    return false;
-  }
-
-  void* data;
-  vmaMapMemory(renderData.rdAllocator, stagingBufferAlloc, &data);
-  memcpy(data, texData, static_cast<uint32_t>(imageSize));
-  vmaUnmapMemory(renderData.rdAllocator, stagingBufferAlloc);
-
-  stbi_image_free(texData);
-
-  VkImageSubresourceRange stagingBufferRange{};
-  stagingBufferRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-  stagingBufferRange.baseMipLevel = 0;
-  stagingBufferRange.levelCount = 1;
-  stagingBufferRange.baseArrayLayer = 0;
-  stagingBufferRange.layerCount = 1;
-
-  /* 1st barrier, undefined to transfer optimal */
-  VkImageMemoryBarrier stagingBufferTransferBarrier{};
-  stagingBufferTransferBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  stagingBufferTransferBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-  stagingBufferTransferBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-  stagingBufferTransferBarrier.image = textureData.texTextureImage;
-  stagingBufferTransferBarrier.subresourceRange = stagingBufferRange;
-  stagingBufferTransferBarrier.srcAccessMask = 0;
-  stagingBufferTransferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
   VkExtent3D textureExtent{};
   textureExtent.width = static_cast<uint32_t>(texWidth);
   textureExtent.height = static_cast<uint32_t>(texHeight);
   textureExtent.depth = 1;
 
-  VkBufferImageCopy stagingBufferCopy{};
-  stagingBufferCopy.bufferOffset = 0;
-  stagingBufferCopy.bufferRowLength = 0;
-  stagingBufferCopy.bufferImageHeight = 0;
-  stagingBufferCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-  stagingBufferCopy.imageSubresource.mipLevel = 0;
-  stagingBufferCopy.imageSubresource.baseArrayLayer = 0;
-  stagingBufferCopy.imageSubresource.layerCount = 1;
-  stagingBufferCopy.imageExtent = textureExtent;
-
-  /* 2nd barrier, transfer optimal to shader optimal */
-  VkImageMemoryBarrier stagingBufferShaderBarrier{};
-  stagingBufferShaderBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  stagingBufferShaderBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-  stagingBufferShaderBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-  stagingBufferShaderBarrier.image = textureData.texTextureImage;
-  stagingBufferShaderBarrier.subresourceRange = stagingBufferRange;
-  stagingBufferShaderBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-  stagingBufferShaderBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-  /* transfer to get optimal layout */
-  VkCommandBuffer stagingCommandBuffer;
-
-  if (!CommandBuffer::init(renderData, stagingCommandBuffer)) {
-    Logger::log(1, "%s error: could not create texture upload command buffers\n", __FUNCTION__);
-    return false;
-  }
-
-  if (vkResetCommandBuffer(stagingCommandBuffer, 0) != VK_SUCCESS) {
-    Logger::log(1, "%s error: failed to reset staging command buffer\n", __FUNCTION__);
-    return false;
-  }
-
-  VkCommandBufferBeginInfo cmdBeginInfo{};
-  cmdBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  cmdBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-  if(vkBeginCommandBuffer(stagingCommandBuffer, &cmdBeginInfo) != VK_SUCCESS) {
-    Logger::log(1, "%s error: failed to begin staging command buffer\n", __FUNCTION__);
-    return false;
-  }
-
-  vkCmdPipelineBarrier(stagingCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-    VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferTransferBarrier);
-  vkCmdCopyBufferToImage(stagingCommandBuffer, stagingBuffer, textureData.texTextureImage,
-    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &stagingBufferCopy);
-  vkCmdPipelineBarrier(stagingCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferShaderBarrier);
-
-  if (vkEndCommandBuffer(stagingCommandBuffer) != VK_SUCCESS) {
-    Logger::log(1, "%s error: failed to end staging command buffer\n", __FUNCTION__);
-    return false;
-  }
-
-  VkSubmitInfo submitInfo{};
-  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  submitInfo.pWaitDstStageMask = nullptr;
-  submitInfo.waitSemaphoreCount = 0;
-  submitInfo.pWaitSemaphores = nullptr;
-  submitInfo.signalSemaphoreCount = 0;
-  submitInfo.pSignalSemaphores = nullptr;
-  submitInfo.commandBufferCount = 1;
-  submitInfo.pCommandBuffers = &stagingCommandBuffer;
-
-  VkFence stagingBufferFence;
-
-  VkFenceCreateInfo fenceInfo{};
-  fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-  fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-  if (vkCreateFence(renderData.rdVkbDevice.device, &fenceInfo, nullptr, &stagingBufferFence) != VK_SUCCESS) {
-    Logger::log(1, "%s error: failed to create staging buffer fence\n", __FUNCTION__);
-    return false;
-  }
-
-  if (vkResetFences(renderData.rdVkbDevice.device, 1, &stagingBufferFence) != VK_SUCCESS) {
-    Logger::log(1, "%s error: staging buffer fence reset failed\n", __FUNCTION__);
-    return false;
-  }
-
-  if (vkQueueSubmit(renderData.rdGraphicsQueue, 1, &submitInfo, stagingBufferFence) != VK_SUCCESS) {
-    Logger::log(1, "%s error: failed to submit staging buffer copy command buffer\n", __FUNCTION__);
-    return false;
-  }
-
-  if (vkWaitForFences(renderData.rdVkbDevice.device, 1, &stagingBufferFence, VK_TRUE, UINT64_MAX) != VK_SUCCESS) {
-    Logger::log(1, "%s error: waiting for staging buffer copy fence failed\n", __FUNCTION__);
+  /* the copy runs on the transfer queue, the texture must not be used before the upload batch is complete */
+  if (!UploadManager::uploadImage(renderData, textureData.texTextureImage, texData, imageSize, textureExtent)) {
+    Logger::log(1, "%s error: could not upload texture data\n", __FUNCTION__);
+    stbi_image_free(texData);
     return false;
   }
 
-  vkDestroyFence(renderData.rdVkbDevice.device, stagingBufferFence, nullptr);
-  CommandBuffer::cleanup(renderData, stagingCommandBuffer);
-  vmaDestroyBuffer(renderData.rdAllocator, stagingBuffer, stagingBufferAlloc);
+  stbi_image_free(texData);
 
   /* image view and sampler */
   VkImageViewCreateInfo texViewInfo{};
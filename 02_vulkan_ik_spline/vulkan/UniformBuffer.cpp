@@ -1,27 +1,14 @@
 #include "UniformBuffer.h"
+#include "UploadRing.h"
 #include "Logger.h"
 
 #include <glm/glm.hpp>
 #include <VkBootstrap.h>
 
 bool UniformBuffer::init(VkRenderData& renderData, VkUniformBufferData &UBOData,
-    std::vector<glm::mat4> matricesToUpload) {
-  VkBufferCreateInfo bufferInfo{};
-  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  bufferInfo.size = matricesToUpload.size() * sizeof(glm::mat4);
-  bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-
-  VmaAllocationCreateInfo vmaAllocInfo{};
-  vmaAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-
-  if (vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo,
-    &UBOData.rdUboBuffer, &UBOData.rdUboBufferAlloc, nullptr) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate uniform buffer via VMA\n", __FUNCTION__);
-    return false;
-  }
-
+    const std::vector<glm::mat4>& matricesToUpload) {
   VkDescriptorSetLayoutBinding uboBind{};
-  uboBind.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  uboBind.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   uboBind.binding = 0;
   uboBind.descriptorCount = 1;
   uboBind.pImmutableSamplers = nullptr;
@@ -39,7 +26,7 @@ bool UniformBuffer::init(VkRenderData& renderData, VkUniformBufferData &UBOData,
   }
 
   VkDescriptorPoolSize poolSize{};
-  poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   poolSize.descriptorCount = 1;
 
   VkDescriptorPoolCreateInfo descriptorPool{};
@@ -66,14 +53,15 @@ bool UniformBuffer::init(VkRenderData& renderData, VkUniformBufferData &UBOData,
     return false;
   }
 
+  /* the data of the current frame is found by the dynamic offset given at bind time */
   VkDescriptorBufferInfo uboInfo{};
-  uboInfo.buffer = UBOData.rdUboBuffer;
+  uboInfo.buffer = renderData.rdUploadRing.rdRingBuffer;
   uboInfo.offset = 0;
   uboInfo.range = matricesToUpload.size() * sizeof(glm::mat4);
 
   VkWriteDescriptorSet writeDescriptorSet{};
   writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-  writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   writeDescriptorSet.dstSet = UBOData.rdUBODescriptorSet;
   writeDescriptorSet.dstBinding = 0;
   writeDescriptorSet.descriptorCount = 1;
@@ -81,13 +69,18 @@ bool UniformBuffer::init(VkRenderData& renderData, VkUniformBufferData &UBOData,
 
   vkUpdateDescriptorSets(renderData.rdVkbDevice.device, 1, &writeDescriptorSet, 0, nullptr);
 
-  Logger::log(1, "%s: created uniform buffer of size %i\n", __FUNCTION__, uboInfo.range);
+  Logger::log(1, "%s: created uniform buffer descriptor of size %i\n", __FUNCTION__, uboInfo.range);
 	return true;
 }
 
+bool UniformBuffer::uploadData(VkRenderData& renderData, VkUniformBufferData &UBOData,
+    const std::vector<glm::mat4>& matrices) {
+  return UploadRing::uploadData(renderData, matrices.data(), matrices.size() * sizeof(glm::mat4),
+    UBOData.rdUBODynamicOffset);
+}
+
 void UniformBuffer::cleanup(VkRenderData& renderData, VkUniformBufferData &UBOData) {
   vkDestroyDescriptorPool(renderData.rdVkbDevice.device, UBOData.rdUBODescriptorPool, nullptr);
   vkDestroyDescriptorSetLayout(renderData.rdVkbDevice.device, UBOData.rdUBODescriptorLayout,
     nullptr);
-  vmaDestroyBuffer(renderData.rdAllocator, UBOData.rdUboBuffer, UBOData.rdUboBufferAlloc);
 }
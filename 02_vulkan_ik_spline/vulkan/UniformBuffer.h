@@ -8,6 +8,9 @@
 class UniformBuffer {
   public:
     static bool init(VkRenderData &renderData, VkUniformBufferData &UBOData,
-      std::vector<glm::mat4> matricesToUpload);
+      const std::vector<glm::mat4>& matricesToUpload);
+    /* copy into the upload ring, stores the offset in rdUBODynamicOffset */
+    static bool uploadData(VkRenderData &renderData, VkUniformBufferData &UBOData,
+      const std::vector<glm::mat4>& matrices);
     static void cleanup(VkRenderData &renderData, VkUniformBufferData &UBOData);
 };
@@ -1,4 +1,5 @@
 #include <string>
+#include <algorithm>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/string_cast.hpp>
@@ -9,6 +10,7 @@
 
 #include "UserInterface.h"
 #include "CommandBuffer.h"
+#include "GpuProfiler.h"
 #include "Logger.h"
 
 bool UserInterface::init(VkRenderData& renderData) {
@@ -51,7 +53,9 @@ bool UserInterface::init(VkRenderData& renderData) {
   imguiIinitInfo.Queue = renderData.rdGraphicsQueue;
   imguiIinitInfo.DescriptorPool = renderData.rdImguiDescriptorPool;
   imguiIinitInfo.MinImageCount = 2;
-  imguiIinitInfo.ImageCount = renderData.rdSwapchainImages.size();
+  /* ImGui rotates its vertex buffers by this count, it must not reuse a buffer of a frame still in flight */
+  imguiIinitInfo.ImageCount = std::max(static_cast<uint32_t>(renderData.rdSwapchainImages.size()),
+    static_cast<uint32_t>(VkRenderData::rdMaxFramesInFlight));
   imguiIinitInfo.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
 
   ImGui_ImplVulkan_Init(&imguiIinitInfo, renderData.rdRenderpass);
@@ -130,6 +134,7 @@ bool UserInterface::init(VkRenderData& renderData) {
   /* init plot vectors */
   mFPSValues.resize(mNumFPSValues);
   mFrameTimeValues.resize(mNumFrameTimeValues);
+  mWaitForFenceValues.resize(mNumWaitForFenceValues);
   mModelUploadValues.resize(mNumModelUploadValues);
   mMatrixGenerationValues.resize(mNumMatrixGenerationValues);
   mIKValues.resize(mNumIKValues);
@@ -174,6 +179,7 @@ void UserInterface::createFrame(VkRenderData& renderData) {
 
   static int fpsOffset = 0;
   static int frameTimeOffset = 0;
+  static int waitForFenceOffset = 0;
   static int modelUploadOffset = 0;
   static int matrixGenOffset = 0;
   static int ikOffset = 0;
@@ -188,6 +194,9 @@ void UserInterface::createFrame(VkRenderData& renderData) {
     mFrameTimeValues.at(frameTimeOffset) = renderData.rdFrameTime;
     frameTimeOffset = ++frameTimeOffset % mNumFrameTimeValues;
 
+    mWaitForFenceValues.at(waitForFenceOffset) = renderData.rdWaitForFenceTime;
+    waitForFenceOffset = ++waitForFenceOffset % mNumWaitForFenceValues;
+
     mModelUploadValues.at(modelUploadOffset) = renderData.rdUploadToVBOTime;
     modelUploadOffset = ++modelUploadOffset % mNumModelUploadValues;
 
@@ -233,7 +242,16 @@ void UserInterface::createFrame(VkRenderData& renderData) {
   if (ImGui::CollapsingHeader("Info")) {
     ImGui::Text("Triangles:");
     ImGui::SameLine();
-    ImGui::Text("%s", std::to_string(renderData.rdTriangleCount + renderData.rdGltfTriangleCount).c_str());
+    ImGui::Text("%s", std::to_string(renderData.rdTriangleCount +
+      renderData.rdGltfTriangleCount * renderData.rdVisibleInstances).c_str());
+
+    ImGui::Text("Visible Instances:");
+    ImGui::SameLine();
+    ImGui::Text("%s", std::to_string(renderData.rdVisibleInstances).c_str());
+
+    ImGui::Text("Culled Instances:");
+    ImGui::SameLine();
+    ImGui::Text("%s", std::to_string(renderData.rdCulledInstances).c_str());
 
     std::string windowDims = std::to_string(renderData.rdWidth) + "x" + std::to_string(renderData.rdHeight);
     ImGui::Text("Window Dimensions:");
@@ -244,6 +262,17 @@ void UserInterface::createFrame(VkRenderData& renderData) {
     ImGui::Text("ImGui Window Position:");
     ImGui::SameLine();
     ImGui::Text("%s", imgWindowPos.c_str());
+
+    const VkStagingPoolData &stagingPool = renderData.rdStagingPool;
+    std::string stagingMemory = std::to_string(stagingPool.rdUsedSize / 1024) + "/" +
+      std::to_string(stagingPool.rdPeakUsedSize / 1024) + "/" + std::to_string(stagingPool.rdResidentSize / 1024) + " KiB";
+    ImGui::Text("Staging Used/Peak/Resident:");
+    ImGui::SameLine();
+    ImGui::Text("%s", stagingMemory.c_str());
+
+    ImGui::Text("Staging Block Allocations:");
+    ImGui::SameLine();
+    ImGui::Text("%s", std::to_string(stagingPool.rdBlockAllocations).c_str());
   }
 
   if (ImGui::CollapsingHeader("Timers")) {
@@ -271,6 +300,30 @@ void UserInterface::createFrame(VkRenderData& renderData) {
       ImGui::EndTooltip();
     }
 
+    ImGui::BeginGroup();
+    ImGui::Text("Wait for Fence Time:");
+    ImGui::SameLine();
+    ImGui::Text("%s", std::to_string(renderData.rdWaitForFenceTime).c_str());
+    ImGui::SameLine();
+    ImGui::Text("ms");
+    ImGui::EndGroup();
+
+    if (ImGui::IsItemHovered()) {
+      ImGui::BeginTooltip();
+      float averageWaitForFence = 0.0f;
+      for (const auto value : mWaitForFenceValues) {
+        averageWaitForFence += value;
+      }
+      averageWaitForFence /= static_cast<float>(mNumWaitForFenceValues);
+      std::string waitForFenceOverlay = "now:     " + std::to_string(renderData.rdWaitForFenceTime)
+        + " ms\n30s avg: " + std::to_string(averageWaitForFence) + " ms";
+      ImGui::Text("Wait for Fence");
+      ImGui::SameLine();
+      ImGui::PlotLines("##WaitForFenceTimes", mWaitForFenceValues.data(), mWaitForFenceValues.size(),
+        waitForFenceOffset, waitForFenceOverlay.c_str(), 0.0f, FLT_MAX, ImVec2(0, 80));
+      ImGui::EndTooltip();
+    }
+
     ImGui::BeginGroup();
     ImGui::Text("Model Upload Time:");
     ImGui::SameLine();
@@ -414,6 +467,42 @@ void UserInterface::createFrame(VkRenderData& renderData) {
         uiDrawOverlay.c_str(), 0.0f, FLT_MAX, ImVec2(0, 80));
       ImGui::EndTooltip();
     }
+
+    /* one frame in flight serializes CPU and GPU, compare the frame and fence wait times */
+    ImGui::Text("Frames in Flight:");
+    ImGui::SameLine();
+    ImGui::SliderInt("##FramesInFlight", &renderData.rdFramesInFlight, 1, VkRenderData::rdMaxFramesInFlight,
+      "%d", flags);
+  }
+
+  if (ImGui::CollapsingHeader("GPU Timers")) {
+    const VkGpuProfilerData &gpuProfiler = renderData.rdGpuProfiler;
+    if (!gpuProfiler.rdTimestampsSupported) {
+      ImGui::Text("Timestamp queries are not supported");
+    } else {
+      for (int i = 0; i < VkGpuProfilerData::rdNumScopes; ++i) {
+        ImGui::Text("%s:", GpuProfiler::getScopeName(static_cast<gpuScope>(i)));
+        ImGui::SameLine();
+        ImGui::Text("%s", std::to_string(gpuProfiler.rdScopeTimes.at(i)).c_str());
+        ImGui::SameLine();
+        ImGui::Text("ms");
+      }
+
+      /* the file is written after the last frame of the capture */
+      ImGui::Text("Capture Frames:");
+      ImGui::SameLine();
+      ImGui::SliderInt("##GpuCaptureFrames", &renderData.rdGpuCaptureFrames, 10, 3000, "%d", flags);
+
+      ImGui::BeginDisabled(gpuProfiler.rdCaptureRunning);
+      if (ImGui::Button("Capture to CSV")) {
+        renderData.rdGpuCaptureRequested = true;
+      }
+      ImGui::EndDisabled();
+      if (gpuProfiler.rdCaptureRunning) {
+        ImGui::SameLine();
+        ImGui::Text("%i/%i", static_cast<int>(gpuProfiler.rdCaptureRows.size()), gpuProfiler.rdCaptureFrameCount);
+      }
+    }
   }
 
   if (ImGui::CollapsingHeader("Camera")) {
@@ -449,6 +538,13 @@ void UserInterface::createFrame(VkRenderData& renderData) {
       renderData.rdGPUDualQuatVertexSkinning == skinningMode::dualQuat)) {
        renderData.rdGPUDualQuatVertexSkinning = skinningMode::dualQuat;
      }
+
+    ImGui::Text("Crowd Instances:");
+    ImGui::SameLine();
+    ImGui::SliderInt("##CrowdInstances", &renderData.rdCrowdInstances, 1, VkRenderData::rdMaxCrowdInstances,
+      "%d", flags);
+
+    ImGui::Checkbox("Frustum Culling", &renderData.rdFrustumCulling);
   }
 
   if (ImGui::CollapsingHeader("glTF Animation")) {
@@ -601,6 +697,7 @@ void UserInterface::createFrame(VkRenderData& renderData) {
 
       ImGui::Checkbox("Draw Target Coordinates", &renderData.rdTargetCoordLines);
       ImGui::Checkbox("Draw Spline lines", &renderData.rdDrawSplineLines);
+      ImGui::Checkbox("Constant Speed on Spline", &renderData.rdSplineConstantSpeed);
       ImGui::Text("Interpolate");
       ImGui::SameLine();
       ImGui::SliderFloat("##Interp", &renderData.rdInterpValue, 0.0f, 1.0f);
@@ -667,9 +764,9 @@ void UserInterface::createFrame(VkRenderData& renderData) {
   ImGui::End();
 }
 
-void UserInterface::render(VkRenderData& renderData) {
+void UserInterface::render(VkRenderData& renderData, VkCommandBuffer commandBuffer) {
   ImGui::Render();
-  ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), renderData.rdCommandBuffer);
+  ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
 }
 
 void UserInterface::cleanup(VkRenderData& renderData) {
@@ -8,7 +8,8 @@ class UserInterface {
   public:
     bool init(VkRenderData& renderData);
     void createFrame(VkRenderData& renderData);
-    void render(VkRenderData& renderData);
+    /* records the ImGui draw data into the command buffer */
+    void render(VkRenderData& renderData, VkCommandBuffer commandBuffer);
     void cleanup(VkRenderData& renderData);
 
   private:
@@ -22,6 +23,9 @@ class UserInterface {
     std::vector<float> mFrameTimeValues{};
     int mNumFrameTimeValues = 90;
 
+    std::vector<float> mWaitForFenceValues{};
+    int mNumWaitForFenceValues = 90;
+
     std::vector<float> mModelUploadValues{};
     int mNumModelUploadValues = 90;
 
@@ -1,6 +1,8 @@
 /* Vulkan */
 #pragma once
 #include <vector>
+#include <array>
+#include <string>
 
 #include <glm/glm.hpp>
 
@@ -42,6 +44,16 @@ enum class ikMode {
   fabrik
 };
 
+/* parts of the frame measured by the GPU profiler */
+enum class gpuScope {
+  culling = 0,
+  modelDraw,
+  lines,
+  skeleton,
+  userInterface,
+  NUM_SCOPES
+};
+
 struct VkTextureData {
   VkImage texTextureImage = VK_NULL_HANDLE;
   VkImageView texTextureImageView = VK_NULL_HANDLE;
@@ -57,34 +69,177 @@ struct VkVertexBufferData {
   unsigned int rdVertexBufferSize = 0;
 	VkBuffer rdVertexBuffer = VK_NULL_HANDLE;
 	VmaAllocation rdVertexBufferAlloc = nullptr;
-	VkBuffer rdStagingBuffer = VK_NULL_HANDLE;
-	VmaAllocation rdStagingBufferAlloc = nullptr;
 };
 
 struct VkIndexBufferData {
   unsigned int rdIndexBufferSize = 0;
 	VkBuffer rdIndexBuffer = VK_NULL_HANDLE;
 	VmaAllocation rdIndexBufferAlloc = nullptr;
-	VkBuffer rdStagingBuffer = VK_NULL_HANDLE;
-	VmaAllocation rdStagingBufferAlloc = nullptr;
 };
 
+/* the data lives in the upload ring, the descriptor set points to it with a dynamic offset */
 struct VkUniformBufferData {
-  VkBuffer rdUboBuffer = VK_NULL_HANDLE;
-  VmaAllocation rdUboBufferAlloc = nullptr;
-
   VkDescriptorPool rdUBODescriptorPool = VK_NULL_HANDLE;
   VkDescriptorSetLayout rdUBODescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSet rdUBODescriptorSet = VK_NULL_HANDLE;
+  uint32_t rdUBODynamicOffset = 0;
 };
 
 struct VkShaderStorageBufferData {
-  VkBuffer rdSsboBuffer = VK_NULL_HANDLE;
-  VmaAllocation rdSsboBufferAlloc = nullptr;
-
   VkDescriptorPool rdSSBODescriptorPool = VK_NULL_HANDLE;
   VkDescriptorSetLayout rdSSBODescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSet rdSSBODescriptorSet = VK_NULL_HANDLE;
+  uint32_t rdSsboDynamicOffset = 0;
+};
+
+/* one persistently mapped buffer for all per-frame uniform and storage data
+ * every frame in flight owns a region, uploads are aligned suballocations inside the region of the current frame */
+struct VkUploadRingData {
+  VkBuffer rdRingBuffer = VK_NULL_HANDLE;
+  VmaAllocation rdRingBufferAlloc = nullptr;
+  char* rdMappedData = nullptr;
+
+  VkDeviceSize rdAlignment = 0;
+  VkDeviceSize rdFrameRegionSize = 0;
+  VkDeviceSize rdFrameRegionStart = 0;
+  VkDeviceSize rdFrameRegionUsed = 0;
+};
+
+/* persistently mapped vertex buffer for the debug lines, every frame in flight owns a region of rdFrameCapacity vertices */
+struct VkLineRingData {
+  VkBuffer rdLineBuffer = VK_NULL_HANDLE;
+  VmaAllocation rdLineBufferAlloc = nullptr;
+  VkVertex* rdMappedVertices = nullptr;
+
+  uint32_t rdFrameCapacity = 0;
+  uint32_t rdFrameStart = 0;
+  uint32_t rdVertexCount = 0;
+  bool rdOverflowLogged = false;
+};
+
+/* host visible staging memory shared by all uploads
+ * allocations are placed one after another into large blocks, a block starts over after all of its allocations were released */
+struct VkStagingBlockData {
+  VkBuffer sbBuffer = VK_NULL_HANDLE;
+  VmaAllocation sbBufferAlloc = nullptr;
+  char* sbMappedData = nullptr;
+  VkDeviceSize sbSize = 0;
+  VkDeviceSize sbUsedSize = 0;
+  unsigned int sbAllocations = 0;
+};
+
+struct VkStagingAllocation {
+  VkBuffer saBuffer = VK_NULL_HANDLE;
+  VkDeviceSize saOffset = 0;
+  VkDeviceSize saSize = 0;
+  unsigned int saBlock = 0;
+};
+
+struct VkStagingPoolData {
+  std::vector<VkStagingBlockData> rdBlocks{};
+  VkDeviceSize rdBlockSize = 0;
+  VkDeviceSize rdAlignment = 0;
+
+  /* allocations of every frame in flight, released after the fence of the frame was signaled */
+  std::vector<std::vector<VkStagingAllocation>> rdFrameReleases{};
+
+  /* statistics */
+  VkDeviceSize rdUsedSize = 0;
+  VkDeviceSize rdPeakUsedSize = 0;
+  VkDeviceSize rdResidentSize = 0;
+  unsigned int rdBlockAllocations = 0;
+};
+
+/* copies recorded into one command buffer of the transfer queue, submitted together */
+struct VkUploadBatchData {
+  uint64_t ubId = 0;
+  VkCommandBuffer ubCommandBuffer = VK_NULL_HANDLE;
+  VkFence ubFence = VK_NULL_HANDLE;
+
+  /* released after the fence was signaled */
+  std::vector<VkStagingAllocation> ubStagingAllocations{};
+
+  /* recorded on the graphics queue if the transfer queue belongs to another queue family */
+  std::vector<VkBufferMemoryBarrier> ubBufferAcquireBarriers{};
+  std::vector<VkImageMemoryBarrier> ubImageAcquireBarriers{};
+  VkPipelineStageFlags ubAcquireStages = 0;
+};
+
+struct VkUploadManagerData {
+  VkQueue rdTransferQueue = VK_NULL_HANDLE;
+  uint32_t rdTransferQueueFamily = 0;
+  uint32_t rdGraphicsQueueFamily = 0;
+  VkCommandPool rdTransferCommandPool = VK_NULL_HANDLE;
+
+  /* signaled fences are reset and reused by the next batches */
+  std::vector<VkFence> rdFreeFences{};
+
+  VkUploadBatchData rdRecordingBatch{};
+  std::vector<VkUploadBatchData> rdPendingBatches{};
+  uint64_t rdNextBatchId = 1;
+  uint64_t rdCompletedBatchId = 0;
+};
+
+/* secondary command buffers of one recording thread for one frame in flight
+ * the whole pool is reset when the frame starts again, the buffers are reused */
+struct VkRecordPoolData {
+  VkCommandPool rpCommandPool = VK_NULL_HANDLE;
+  std::vector<VkCommandBuffer> rpCommandBuffers{};
+  unsigned int rpUsedCommandBuffers = 0;
+};
+
+/* timestamp queries around the GPU scopes, every frame in flight owns a range of the query pool
+ * the results of a frame are read after the fence of the frame was signaled, so the CPU never waits for them */
+struct VkGpuProfilerData {
+  static constexpr int rdNumScopes = static_cast<int>(gpuScope::NUM_SCOPES);
+
+  VkQueryPool rdQueryPool = VK_NULL_HANDLE;
+  bool rdTimestampsSupported = false;
+  /* nanoseconds per timestamp tick */
+  float rdTimestampPeriod = 0.0f;
+  uint64_t rdTimestampMask = 0;
+
+  /* queries of a frame in flight were reset, skipped scopes stay unavailable.
+   * only changed by the thread owning the primary command buffer, the scopes may be recorded by other threads */
+  std::vector<bool> rdFrameQueriesReset{};
+
+  /* newest results in milliseconds */
+  std::array<float, rdNumScopes> rdScopeTimes{};
+
+  /* one row per frame, written to a CSV file after rdCaptureFrameCount frames */
+  int rdCaptureFrameCount = 0;
+  bool rdCaptureRunning = false;
+  std::vector<std::array<float, rdNumScopes>> rdCaptureRows{};
+  std::string rdCaptureFileName{};
+};
+
+/* frustum culling of the crowd instances in a compute shader
+ * the GPU writes the IDs of the visible instances and the instance count of the indirect draw,
+ * every frame in flight owns a region of both buffers, selected by the dynamic offsets */
+struct VkGpuCullingData {
+  VkBuffer rdIndirectBuffer = VK_NULL_HANDLE;
+  VmaAllocation rdIndirectBufferAlloc = nullptr;
+  VkDeviceSize rdIndirectRegionSize = 0;
+
+  VkBuffer rdVisibleBuffer = VK_NULL_HANDLE;
+  VmaAllocation rdVisibleBufferAlloc = nullptr;
+  VkDeviceSize rdVisibleRegionSize = 0;
+
+  /* visible instances of every frame in flight, copied from the indirect command after the draw */
+  VkBuffer rdReadbackBuffer = VK_NULL_HANDLE;
+  VmaAllocation rdReadbackBufferAlloc = nullptr;
+  uint32_t* rdReadbackData = nullptr;
+  std::vector<bool> rdFrameCountCopied{};
+  std::vector<uint32_t> rdFrameInstanceCounts{};
+
+  /* binding 0 is the indirect command, binding 1 the visible instance IDs */
+  VkDescriptorPool rdDescriptorPool = VK_NULL_HANDLE;
+  VkDescriptorSetLayout rdDescriptorLayout = VK_NULL_HANDLE;
+  VkDescriptorSet rdDescriptorSet = VK_NULL_HANDLE;
+  std::array<uint32_t, 2> rdDynamicOffsets{};
+
+  VkPipelineLayout rdCullPipelineLayout = VK_NULL_HANDLE;
+  VkPipeline rdCullPipeline = VK_NULL_HANDLE;
 };
 
 struct VkRenderData {
@@ -105,6 +260,13 @@ struct VkRenderData {
   float rdUploadToUBOTime = 0.0f;
   float rdUIGenerateTime = 0.0f;
   float rdUIDrawTime = 0.0f;
+  /* time the CPU waited for the GPU to finish the oldest frame in flight */
+  float rdWaitForFenceTime = 0.0f;
+
+  /* GPU times of the scopes, some frames behind the CPU timers */
+  VkGpuProfilerData rdGpuProfiler{};
+  int rdGpuCaptureFrames = 300;
+  bool rdGpuCaptureRequested = false;
 
   int rdMoveForward = 0;
   int rdMoveRight = 0;
@@ -129,6 +291,15 @@ struct VkRenderData {
   float rdAnimEndTime = 0.0f;
   int rdModelNodeCount = 0;
 
+  /* the first instance is the animated model with IK and skeleton, the others play the clip with their own time offset */
+  static constexpr int rdMaxCrowdInstances = 10000;
+  int rdCrowdInstances = 1;
+
+  /* results of the GPU culling, some frames behind the CPU */
+  bool rdFrustumCulling = true;
+  unsigned int rdVisibleInstances = 0;
+  unsigned int rdCulledInstances = 0;
+
   replayDirection rdAnimationPlayDirection = replayDirection::forward;
 
   float rdAnimBlendFactor = 1.0f;
@@ -154,6 +325,7 @@ struct VkRenderData {
   glm::vec3 rdSplineEndVertex = glm::vec3(4.0f, 2.0f, -2.0f);
   glm::vec3 rdSplineEndTangent = glm::vec3(-6.0f, 5.0f, -6.0f);
   float rdInterpValue = 0.0f;
+  bool rdSplineConstantSpeed = true;
 
   VmaAllocator rdAllocator = nullptr;
 
@@ -176,23 +348,44 @@ struct VkRenderData {
 
   VkRenderPass rdRenderpass;
   VkPipelineLayout rdGltfPipelineLayout = VK_NULL_HANDLE;
+  /* shared by all pipelines, filled from and saved to a file */
+  VkPipelineCache rdPipelineCache = VK_NULL_HANDLE;
+  bool rdPipelineCacheLoaded = false;
   VkPipeline rdLinePipeline = VK_NULL_HANDLE;
   VkPipeline rdGltfGPUPipeline = VK_NULL_HANDLE;
   VkPipeline rdGltfGPUDQPipeline = VK_NULL_HANDLE;
   VkPipeline rdGltfSkeletonPipeline = VK_NULL_HANDLE;
 
+  /* resources for rdMaxFramesInFlight frames are created, the first rdFramesInFlight of them are used */
+  static constexpr int rdMaxFramesInFlight = 3;
+  int rdFramesInFlight = 2;
+  unsigned int rdCurrentFrame = 0;
+
   VkCommandPool rdCommandPool = VK_NULL_HANDLE;
+  /* command buffer of the frame currently recorded, one of rdCommandBuffers */
   VkCommandBuffer rdCommandBuffer = VK_NULL_HANDLE;
+  std::vector<VkCommandBuffer> rdCommandBuffers{};
+
+  /* rdMaxFramesInFlight pools per recording thread, a pool is only used by its own thread */
+  std::vector<VkRecordPoolData> rdRecordPools{};
+  unsigned int rdRecordThreads = 0;
+
+  std::vector<VkSemaphore> rdPresentSemaphores{};
+  std::vector<VkSemaphore> rdRenderSemaphores{};
+  std::vector<VkFence> rdRenderFences{};
 
-  VkSemaphore rdPresentSemaphore = VK_NULL_HANDLE;
-  VkSemaphore rdRenderSemaphore = VK_NULL_HANDLE;
-  VkFence rdRenderFence = VK_NULL_HANDLE;
+  /* the line vertices change every frame */
+  VkLineRingData rdLineRing{};
 
-  VkVertexBufferData rdVertexBufferData{};
+  VkUploadRingData rdUploadRing{};
+  VkStagingPoolData rdStagingPool{};
+  VkUploadManagerData rdUploadManager{};
 
   VkUniformBufferData rdPerspViewMatrixUBO{};
   VkShaderStorageBufferData rdJointMatrixSSBO{};
   VkShaderStorageBufferData rdJointDualQuatSSBO{};
+  VkShaderStorageBufferData rdInstanceMatrixSSBO{};
+  VkGpuCullingData rdGpuCulling{};
 
   VkDescriptorPool rdImguiDescriptorPool = VK_NULL_HANDLE;
 };
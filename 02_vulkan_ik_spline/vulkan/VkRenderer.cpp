@@ -1,7 +1,9 @@
+#include <algorithm>
+#include <thread>
+
 #include <imgui_impl_glfw.h>
 
 #include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtx/spline.hpp>
 
 #define VMA_IMPLEMENTATION
 #include <vk_mem_alloc.h>
@@ -37,6 +39,14 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
+  if (!createStagingPool()) {
+    return false;
+  }
+
+  if (!createGpuProfiler()) {
+    return false;
+  }
+
   if (!createSwapchain()) {
     return false;
   }
@@ -50,27 +60,53 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
+  if (!createUploadManager()) {
+    return false;
+  }
+
   if (!createCommandBuffer()) {
     return false;
   }
 
-  if (!createUBO(mRenderData.rdPerspViewMatrixUBO, mPerspViewMatrices)) {
+  if (!createSecondaryCommandBuffers()) {
     return false;
   }
+
   /* before pipeline layout and pipeline */
   if (!loadGltfModel()) {
       return false;
   }
 
-  if (!createSSBO(mRenderData.rdJointMatrixSSBO, mGltfModel->getJointMatrices())) {
+  /* needs the number of joints of the model */
+  if (!createUploadRing()) {
     return false;
   }
 
-  if (!createSSBO(mRenderData.rdJointDualQuatSSBO, mGltfModel->getJointDualQuats())) {
+  if (!createUBO(mRenderData.rdPerspViewMatrixUBO, mPerspViewMatrices)) {
+    return false;
+  }
+
+  /* the SSBOs are large enough for the joint data of the largest crowd */
+  if (!createSSBO(mRenderData.rdJointMatrixSSBO,
+      VkRenderData::rdMaxCrowdInstances * mGltfModel->getJointMatrixSize() * sizeof(glm::mat4))) {
     return false;
   }
 
-  if (!createVBO()) {
+  if (!createSSBO(mRenderData.rdJointDualQuatSSBO,
+      VkRenderData::rdMaxCrowdInstances * mGltfModel->getJointDualQuatsSize() * sizeof(glm::mat2x4))) {
+    return false;
+  }
+
+  if (!createSSBO(mRenderData.rdInstanceMatrixSSBO, VkRenderData::rdMaxCrowdInstances * sizeof(glm::mat4))) {
+    return false;
+  }
+
+  if (!createLineRing()) {
+    return false;
+  }
+
+  /* needs the instance matrix SSBO, before the pipeline layout */
+  if (!createGpuCulling()) {
     return false;
   }
 
@@ -82,6 +118,13 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
       return false;
   }
 
+  if (!createPipelineCache()) {
+      return false;
+  }
+
+  /* compare the time with an empty and a filled pipeline cache */
+  mPipelineCreationTimer.start();
+
   if (!createLinePipeline()) {
       return false;
   }
@@ -99,6 +142,12 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
       return false;
   }
 
+  if (!createCullPipeline()) {
+      return false;
+  }
+  Logger::log(1, "%s: created pipelines in %f ms (%s pipeline cache)\n", __FUNCTION__,
+    mPipelineCreationTimer.stop(), mRenderData.rdPipelineCacheLoaded ? "warm" : "cold");
+
   if (!createFramebuffer()) {
     return false;
   }
@@ -111,10 +160,6 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
- /* valid, but emtpy */
-  mLineMesh = std::make_shared<VkMesh>();
-  Logger::log(1, "%s: line mesh storage initialized\n", __FUNCTION__);
-
   /* reset skeleton split */
   mRenderData.rdSkelSplitNode = mRenderData.rdModelNodeCount - 1;
 
@@ -299,36 +344,65 @@ bool VkRenderer::recreateSwapchain() {
   return true;
 }
 
-bool VkRenderer::createVBO() {
-  /* init with arbitrary size here */
-  if (!VertexBuffer::init(mRenderData, mRenderData.rdVertexBufferData, 2000)) {
-    Logger::log(1, "%s error: could not create vertex buffer\n", __FUNCTION__);
+bool VkRenderer::createLineRing() {
+  if (!LineRing::init(mRenderData, mMaxLineVertices)) {
+    Logger::log(1, "%s error: could not create line ring\n", __FUNCTION__);
     return false;
   }
   return true;
 }
 
-bool VkRenderer::createUBO(VkUniformBufferData &UBOData,
-  std::vector<glm::mat4> matricesToUpload) {
-  if (!UniformBuffer::init(mRenderData, UBOData, matricesToUpload)) {
-    Logger::log(1, "%s error: could not create uniform buffers\n", __FUNCTION__);
+bool VkRenderer::createGpuProfiler() {
+  if (!GpuProfiler::init(mRenderData)) {
+    Logger::log(1, "%s error: could not create GPU profiler\n", __FUNCTION__);
     return false;
   }
   return true;
 }
 
-bool VkRenderer::createSSBO(VkShaderStorageBufferData &SSBOData,
-  std::vector<glm::mat4> matricesToUpload) {
-  if (!ShaderStorageBuffer::init(mRenderData, SSBOData, matricesToUpload)) {
-    Logger::log(1, "%s error: could not create shader storage buffers\n", __FUNCTION__);
+bool VkRenderer::createGpuCulling() {
+  if (!GpuCulling::init(mRenderData, VkRenderData::rdMaxCrowdInstances)) {
+    Logger::log(1, "%s error: could not create GPU culling\n", __FUNCTION__);
     return false;
   }
   return true;
 }
 
-bool VkRenderer::createSSBO(VkShaderStorageBufferData &SSBOData,
-  std::vector<glm::mat2x4> matricesToUpload) {
-  if (!ShaderStorageBuffer::init(mRenderData, SSBOData, matricesToUpload)) {
+bool VkRenderer::createStagingPool() {
+  if (!StagingPool::init(mRenderData, mStagingBlockSize)) {
+    Logger::log(1, "%s error: could not create staging pool\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
+bool VkRenderer::createUploadRing() {
+  /* room for both joint buffers of the largest crowd, the skinning mode can change at every frame */
+  std::vector<VkDeviceSize> frameAllocationSizes = {
+    mPerspViewMatrices.size() * sizeof(glm::mat4),
+    VkRenderData::rdMaxCrowdInstances * mGltfModel->getJointMatrixSize() * sizeof(glm::mat4),
+    VkRenderData::rdMaxCrowdInstances * mGltfModel->getJointDualQuatsSize() * sizeof(glm::mat2x4),
+    VkRenderData::rdMaxCrowdInstances * sizeof(glm::mat4)
+  };
+
+  if (!UploadRing::init(mRenderData, frameAllocationSizes)) {
+    Logger::log(1, "%s error: could not create upload ring\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
+bool VkRenderer::createUBO(VkUniformBufferData &UBOData,
+  const std::vector<glm::mat4>& matricesToUpload) {
+  if (!UniformBuffer::init(mRenderData, UBOData, matricesToUpload)) {
+    Logger::log(1, "%s error: could not create uniform buffers\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
+bool VkRenderer::createSSBO(VkShaderStorageBufferData &SSBOData, const size_t bufferSize) {
+  if (!ShaderStorageBuffer::init(mRenderData, SSBOData, bufferSize)) {
     Logger::log(1, "%s error: could not create shader storage buffers\n", __FUNCTION__);
     return false;
   }
@@ -351,6 +425,14 @@ bool VkRenderer::createGltfPipelineLayout() {
     return true;
 }
 
+bool VkRenderer::createPipelineCache() {
+  if (!PipelineCache::init(mRenderData, mPipelineCacheFileName)) {
+    Logger::log(1, "%s error: could not create pipeline cache\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
 bool VkRenderer::createLinePipeline() {
     std::string vertexShaderFile = "shader/line.vert.spv";
     std::string fragmentShaderFile = "shader/line.frag.spv";
@@ -398,6 +480,16 @@ bool VkRenderer::createGltfGPUDQPipeline() {
   return true;
 }
 
+bool VkRenderer::createCullPipeline() {
+  std::string computeShaderFile = "shader/instance_cull.comp.spv";
+  if (!ComputePipeline::init(mRenderData, mRenderData.rdGpuCulling.rdCullPipelineLayout,
+      mRenderData.rdGpuCulling.rdCullPipeline, computeShaderFile)) {
+    Logger::log(1, "%s error: could not init culling compute pipeline\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
 bool VkRenderer::createFramebuffer() {
   if (!Framebuffer::init(mRenderData)) {
     Logger::log(1, "%s error: could not init framebuffer\n", __FUNCTION__);
@@ -414,9 +506,33 @@ bool VkRenderer::createCommandPool() {
   return true;
 }
 
+bool VkRenderer::createUploadManager() {
+  if (!UploadManager::init(mRenderData)) {
+    Logger::log(1, "%s error: could not create upload manager\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
 bool VkRenderer::createCommandBuffer() {
-  if (!CommandBuffer::init(mRenderData, mRenderData.rdCommandBuffer)) {
-    Logger::log(1, "%s error: could not create command buffers\n", __FUNCTION__);
+  mRenderData.rdCommandBuffers.resize(VkRenderData::rdMaxFramesInFlight, VK_NULL_HANDLE);
+  for (auto& commandBuffer : mRenderData.rdCommandBuffers) {
+    if (!CommandBuffer::init(mRenderData, commandBuffer)) {
+      Logger::log(1, "%s error: could not create command buffers\n", __FUNCTION__);
+      return false;
+    }
+  }
+  mRenderData.rdCommandBuffer = mRenderData.rdCommandBuffers.at(0);
+  return true;
+}
+
+bool VkRenderer::createSecondaryCommandBuffers() {
+  /* model, lines and UI are recorded in parallel, more threads would stay idle */
+  unsigned int numThreads = std::min(mMaxRecordThreads, std::max(std::thread::hardware_concurrency(), 1u));
+  mRecordThreadPool = std::make_unique<WorkerThreadPool>(numThreads);
+
+  if (!SecondaryCommandBuffer::init(mRenderData, mRecordThreadPool->getNumThreads())) {
+    Logger::log(1, "%s error: could not create secondary command buffers\n", __FUNCTION__);
     return false;
   }
   return true;
@@ -467,34 +583,58 @@ bool VkRenderer::loadGltfModel() {
     Logger::log(1, "%s: loading glTF model '%s' failed\n", __FUNCTION__, modelFilename.c_str());
     return false;
   }
+
+  /* the texture and the buffers are copied while the rest of the renderer is created */
+  mGltfModel->uploadVertexBuffers(mRenderData, mGltfRenderData);
+  mGltfModel->uploadIndexBuffer(mRenderData, mGltfRenderData);
+  mModelUploadBatch = UploadManager::submit(mRenderData);
+  if (mModelUploadBatch == 0) {
+    Logger::log(1, "%s: uploading glTF model '%s' failed\n", __FUNCTION__, modelFilename.c_str());
+    return false;
+  }
   return true;
 }
 
 void VkRenderer::cleanup() {
   vkDeviceWaitIdle(mRenderData.rdVkbDevice.device);
 
+  PipelineCache::save(mRenderData, mPipelineCacheFileName);
+
   mGltfModel->cleanup(mRenderData, mGltfRenderData);
   mGltfModel.reset();
 
   mUserInterface.cleanup(mRenderData);
 
+  mRecordThreadPool.reset();
+  SecondaryCommandBuffer::cleanup(mRenderData);
+
   SyncObjects::cleanup(mRenderData);
-  CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandBuffer);
+  for (const auto& commandBuffer : mRenderData.rdCommandBuffers) {
+    CommandBuffer::cleanup(mRenderData, commandBuffer);
+  }
   CommandPool::cleanup(mRenderData);
   Framebuffer::cleanup(mRenderData);
+  ComputePipeline::cleanup(mRenderData, mRenderData.rdGpuCulling.rdCullPipeline);
   GltfGPUPipeline::cleanup(mRenderData, mRenderData.rdGltfGPUDQPipeline);
   GltfGPUPipeline::cleanup(mRenderData, mRenderData.rdGltfGPUPipeline);
   GltfSkeletonPipeline::cleanup(mRenderData, mRenderData.rdGltfSkeletonPipeline);
   Pipeline::cleanup(mRenderData, mRenderData.rdLinePipeline);
   PipelineLayout::cleanup(mRenderData, mRenderData.rdGltfPipelineLayout);
+  PipelineCache::cleanup(mRenderData);
   Renderpass::cleanup(mRenderData);
   UniformBuffer::cleanup(mRenderData, mRenderData.rdPerspViewMatrixUBO);
   ShaderStorageBuffer::cleanup(mRenderData, mRenderData.rdJointDualQuatSSBO);
   ShaderStorageBuffer::cleanup(mRenderData, mRenderData.rdJointMatrixSSBO);
-  VertexBuffer::cleanup(mRenderData, mRenderData.rdVertexBufferData);
+  ShaderStorageBuffer::cleanup(mRenderData, mRenderData.rdInstanceMatrixSSBO);
+  UploadRing::cleanup(mRenderData);
+  UploadManager::cleanup(mRenderData);
+  LineRing::cleanup(mRenderData);
+  GpuProfiler::cleanup(mRenderData);
+  GpuCulling::cleanup(mRenderData);
 
   vkDestroyImageView(mRenderData.rdVkbDevice.device, mRenderData.rdDepthImageView, nullptr);
   vmaDestroyImage(mRenderData.rdAllocator, mRenderData.rdDepthImage, mRenderData.rdDepthImageAlloc);
+  StagingPool::cleanup(mRenderData);
   vmaDestroyAllocator(mRenderData.rdAllocator);
 
   mRenderData.rdVkbSwapchain.destroy_image_views(mRenderData.rdSwapchainImageViews);
@@ -634,13 +774,34 @@ bool VkRenderer::draw() {
 
   handleMovementKeys();
 
-  if (vkWaitForFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdRenderFence, VK_TRUE, UINT64_MAX) != VK_SUCCESS) {
+  /* the number of frames may have been lowered in the UI, every frame index is guarded by its own fence */
+  if (mRenderData.rdCurrentFrame >= static_cast<unsigned int>(mRenderData.rdFramesInFlight)) {
+    mRenderData.rdCurrentFrame = 0;
+  }
+  const unsigned int currentFrame = mRenderData.rdCurrentFrame;
+  VkFence renderFence = mRenderData.rdRenderFences.at(currentFrame);
+
+  /* wait only for the GPU work submitted rdFramesInFlight frames ago */
+  mWaitForFenceTimer.start();
+  if (vkWaitForFences(mRenderData.rdVkbDevice.device, 1, &renderFence, VK_TRUE, UINT64_MAX) != VK_SUCCESS) {
     Logger::log(1, "%s error: waiting for fence failed\n", __FUNCTION__);
     return false;
   }
+  mRenderData.rdWaitForFenceTime = mWaitForFenceTimer.stop();
 
-  if (vkResetFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdRenderFence) != VK_SUCCESS) {
-    Logger::log(1, "%s error:  fence reset failed\n", __FUNCTION__);
+  /* the copies of the last frame with this index are done */
+  StagingPool::beginFrame(mRenderData);
+  LineRing::beginFrame(mRenderData);
+
+  /* the queries and the culling of the last frame with this index are done, too */
+  GpuProfiler::beginFrame(mRenderData);
+  GpuCulling::beginFrame(mRenderData);
+  if (mRenderData.rdGpuCaptureRequested) {
+    GpuProfiler::startCapture(mRenderData, mRenderData.rdGpuCaptureFrames, mGpuProfileFileName);
+    mRenderData.rdGpuCaptureRequested = false;
+  }
+
+  if (!SecondaryCommandBuffer::beginFrame(mRenderData)) {
     return false;
   }
 
@@ -648,10 +809,11 @@ bool VkRenderer::draw() {
   VkResult result = vkAcquireNextImageKHR(mRenderData.rdVkbDevice.device,
       mRenderData.rdVkbSwapchain.swapchain,
       UINT64_MAX,
-      mRenderData.rdPresentSemaphore,
+      mRenderData.rdPresentSemaphores.at(currentFrame),
       VK_NULL_HANDLE,
       &imageIndex);
 
+  /* the fence stays signaled here, the next frame with this index must not wait forever */
   if (result == VK_ERROR_OUT_OF_DATE_KHR) {
     return recreateSwapchain();
   } else {
@@ -661,6 +823,13 @@ bool VkRenderer::draw() {
     }
   }
 
+  if (vkResetFences(mRenderData.rdVkbDevice.device, 1, &renderFence) != VK_SUCCESS) {
+    Logger::log(1, "%s error:  fence reset failed\n", __FUNCTION__);
+    return false;
+  }
+
+  mRenderData.rdCommandBuffer = mRenderData.rdCommandBuffers.at(currentFrame);
+
   VkClearValue colorClearValue;
   colorClearValue.color = { { 0.25f, 0.25f, 0.25f, 1.0f } };
 
@@ -746,6 +915,9 @@ bool VkRenderer::draw() {
     ikRootNode = mRenderData.rdIkRootNode;
   }
 
+  /* the crowd uses the node data of the model, so it is sampled before the model itself */
+  mCrowd.animateInstances(mRenderData, mGltfModel);
+
   /* animate */
   if (mRenderData.rdPlayAnimation) {
     if (mRenderData.rdBlendingMode == blendMode::crossfade ||
@@ -786,16 +958,15 @@ bool VkRenderer::draw() {
     }
     mRenderData.rdIKTime = mIKTimer.stop();
   }
+  mCrowd.setMainInstance(mRenderData, mGltfModel);
 
-  mLineMesh->vertices.clear();
+  /* the lines are written directly into the line ring, skeleton first, then arrows and spline */
 
   /* get gltTF skeleton */
   mSkeletonLineIndexCount = 0;
   if (mRenderData.rdDrawSkeleton) {
-    std::shared_ptr<VkMesh> mesh = mGltfModel->getSkeleton();
-    mSkeletonLineIndexCount += mesh->vertices.size();
-    mLineMesh->vertices.insert(mLineMesh->vertices.begin(),
-      mesh->vertices.begin(), mesh->vertices.end());
+    mGltfModel->addSkeletonLines(mRenderData);
+    mSkeletonLineIndexCount = LineRing::getVertexCount(mRenderData);
   }
 
   /* draw coordiante arrows on target position */
@@ -803,37 +974,32 @@ bool VkRenderer::draw() {
   if ((mRenderData.rdIkMode == ikMode::ccd ||
       mRenderData.rdIkMode == ikMode::fabrik) &&
       mRenderData.rdTargetCoordLines) {
-    mCoordArrowsMesh = mCoordArrowsModel.getVertexData();
-    mCoordArrowsLineIndexCount = mCoordArrowsMesh.vertices.size();
-    std::for_each(mCoordArrowsMesh.vertices.begin(), mCoordArrowsMesh.vertices.end(),
-      [=](auto &n){
-        n.color /= 2.0f;
-        n.position += mRenderData.rdIkTargetPos;
-    });
-
-    mLineMesh->vertices.insert(mLineMesh->vertices.end(),
-      mCoordArrowsMesh.vertices.begin(), mCoordArrowsMesh.vertices.end());
+    mCoordArrowsModel.addVertexData(mRenderData, mRenderData.rdIkTargetPos, 0.5f);
+    mCoordArrowsLineIndexCount = LineRing::getVertexCount(mRenderData) - mSkeletonLineIndexCount;
   }
 
+  /* spline data is only regenerated if the control points have changed */
+  mSplineModel.setControlPoints(
+    { mRenderData.rdSplineStartVertex, mRenderData.rdSplineEndVertex },
+    { mRenderData.rdSplineStartTangent, mRenderData.rdSplineEndTangent });
+
   /* draw spline */
   mSplineLineIndexCount = 0;
-  mSplineMesh.vertices.clear();
   if ((mRenderData.rdIkMode == ikMode::ccd ||
       mRenderData.rdIkMode == ikMode::fabrik) &&
       mRenderData.rdDrawSplineLines) {
-    mSplineMesh = mSplineModel.createVertexData(25,
-      mRenderData.rdSplineStartVertex, mRenderData.rdSplineStartTangent,
-      mRenderData.rdSplineEndVertex, mRenderData.rdSplineEndTangent);
-    mSplineLineIndexCount = mSplineMesh.vertices.size();
-    mLineMesh->vertices.insert(mLineMesh->vertices.end(),
-      mSplineMesh.vertices.begin(), mSplineMesh.vertices.end());
+    mSplineModel.addVertexData(mRenderData, 25);
+    mSplineLineIndexCount = LineRing::getVertexCount(mRenderData) -
+      mSkeletonLineIndexCount - mCoordArrowsLineIndexCount;
   }
+  LineRing::endFrame(mRenderData);
 
   /* position target on current spline position */
-  mRenderData.rdIkTargetPos = glm::hermite(
-    mRenderData.rdSplineStartVertex, mRenderData.rdSplineStartTangent,
-    mRenderData.rdSplineEndVertex, mRenderData.rdSplineEndTangent,
-    mRenderData.rdInterpValue);
+  if (mRenderData.rdSplineConstantSpeed) {
+    mRenderData.rdIkTargetPos = mSplineModel.getPositionByArcLength(mRenderData.rdInterpValue);
+  } else {
+    mRenderData.rdIkTargetPos = mSplineModel.getPosition(mRenderData.rdInterpValue);
+  }
 
   mRenderData.rdMatrixGenerateTime = mMatrixGenerateTimer.stop();
 
@@ -855,114 +1021,84 @@ bool VkRenderer::draw() {
   /* upload data to VBO */
   mUploadToVBOTimer.start();
 
-  if (mLineMesh->vertices.size() > 0) {
-    VertexBuffer::uploadData(mRenderData, mRenderData.rdVertexBufferData, *mLineMesh);
-  }
+  /* hands finished uploads over to the graphics queue */
+  UploadManager::update(mRenderData, mRenderData.rdCommandBuffer);
 
-  if (mModelUploadRequired) {
-    /* upload glTF model data */
-    mGltfModel->uploadVertexBuffers(mRenderData, mGltfRenderData);
-    mGltfModel->uploadIndexBuffer(mRenderData, mGltfRenderData);
-    mModelUploadRequired = false;
-  }
+  /* query resets are not allowed inside the render pass */
+  GpuProfiler::resetQueries(mRenderData, mRenderData.rdCommandBuffer);
 
   mRenderData.rdUploadToVBOTime = mUploadToVBOTimer.stop();
 
-  /* the rendering itself happens here */
-  vkCmdBeginRenderPass(mRenderData.rdCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-  /* required for dynamic viewport */
-  vkCmdSetViewport(mRenderData.rdCommandBuffer, 0, 1, &viewport);
-  vkCmdSetScissor(mRenderData.rdCommandBuffer, 0, 1, &scissor);
-
-  /* UBOs */
-  vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-    mRenderData.rdGltfPipelineLayout, 1, 1, &mRenderData.rdPerspViewMatrixUBO.rdUBODescriptorSet,
-    0, nullptr);
-  vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-    mRenderData.rdGltfPipelineLayout, 2, 1, &mRenderData.rdJointMatrixSSBO.rdSSBODescriptorSet,
-    0, nullptr);
-  vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-    mRenderData.rdGltfPipelineLayout, 3, 1, &mRenderData.rdJointDualQuatSSBO.rdSSBODescriptorSet,
-    0, nullptr);
-
-  /* draw glTF model */
-  if (mRenderData.rdDrawGltfModel) {
-    mGltfModel->draw(mRenderData, mGltfRenderData);
+  /* the dynamic offsets are needed to bind the descriptor sets, so the data is uploaded before the draws */
+  mUploadToUBOTimer.start();
+  UploadRing::beginFrame(mRenderData);
+  if (!UniformBuffer::uploadData(mRenderData, mRenderData.rdPerspViewMatrixUBO, mPerspViewMatrices)) {
+    return false;
   }
 
-  if (mCoordArrowsLineIndexCount > 0 || mSkeletonLineIndexCount > 0 || mSplineLineIndexCount > 0) {
-    /* line and box vertex buffer */
-    VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(mRenderData.rdCommandBuffer, 0, 1,
-      &mRenderData.rdVertexBufferData.rdVertexBuffer, &offset);
-    vkCmdSetLineWidth(mRenderData.rdCommandBuffer, 3.0f);
+  /* only the joint data of the active skinning mode is read by the shaders */
+  bool jointDataUploaded = false;
+  if (mRenderData.rdGPUDualQuatVertexSkinning == skinningMode::dualQuat) {
+    jointDataUploaded = ShaderStorageBuffer::uploadData(mRenderData, mRenderData.rdJointDualQuatSSBO,
+      mCrowd.getJointDualQuats());
+  } else {
+    jointDataUploaded = ShaderStorageBuffer::uploadData(mRenderData, mRenderData.rdJointMatrixSSBO,
+      mCrowd.getJointMatrices());
   }
-
-  /* draw the coordinate arrow WITH depth buffer */
-  if (mCoordArrowsLineIndexCount > 0) {
-    vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-      mRenderData.rdLinePipeline);
-    vkCmdDraw(mRenderData.rdCommandBuffer, mCoordArrowsLineIndexCount, 1,
-      mSkeletonLineIndexCount, 0);
+  if (!jointDataUploaded) {
+    return false;
   }
-
-  if (mSplineLineIndexCount > 0) {
-    vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-      mRenderData.rdLinePipeline);
-    vkCmdDraw(mRenderData.rdCommandBuffer, mSplineLineIndexCount, 1,
-      mCoordArrowsLineIndexCount + mSkeletonLineIndexCount, 0);
+  if (!ShaderStorageBuffer::uploadData(mRenderData, mRenderData.rdInstanceMatrixSSBO,
+      mCrowd.getInstanceMatrices())) {
+    return false;
   }
+  UploadRing::endFrame(mRenderData);
+  mRenderData.rdUploadToUBOTime = mUploadToUBOTimer.stop();
 
-  /* draw the skeleton last, disable depth test to overlay */
-  if (mSkeletonLineIndexCount > 0) {
-    vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-      mRenderData.rdGltfSkeletonPipeline);
-    vkCmdDraw(mRenderData.rdCommandBuffer, mSkeletonLineIndexCount, 1, 0, 0);
+  /* the culling needs the uploaded instance matrices, compute dispatches are not allowed inside the render pass */
+  bool drawGltfModel = mRenderData.rdDrawGltfModel && UploadManager::isBatchComplete(mRenderData, mModelUploadBatch);
+  if (drawGltfModel) {
+    GpuProfiler::beginScope(mRenderData, mRenderData.rdCommandBuffer, gpuScope::culling);
+    GpuCulling::cull(mRenderData, mRenderData.rdCommandBuffer, mPerspViewMatrices.at(1) * mPerspViewMatrices.at(0),
+      mGltfModel->getBoundingSphere(), static_cast<uint32_t>(mCrowd.getInstanceCount()),
+      mRenderData.rdGltfTriangleCount * 3);
+    GpuProfiler::endScope(mRenderData, mRenderData.rdCommandBuffer, gpuScope::culling);
   }
 
-  /* imgui overlay */
+  /* ImGui is not thread safe, the frame is generated here and only drawn by the UI recording job */
   mUIGenerateTimer.start();
   mUserInterface.createFrame(mRenderData);
   mRenderData.rdUIGenerateTime = mUIGenerateTimer.stop();
 
-  mUIDrawTimer.start();
-  mUserInterface.render(mRenderData);
-  mRenderData.rdUIDrawTime = mUIDrawTimer.stop();
+  /* every job records one secondary command buffer, they are executed in this order */
+  mRecordJobs.clear();
+  if (drawGltfModel) {
+    mRecordJobs.emplace_back([this](VkCommandBuffer commandBuffer) { recordGltfModel(commandBuffer); });
+  }
+  if (mCoordArrowsLineIndexCount > 0 || mSkeletonLineIndexCount > 0 || mSplineLineIndexCount > 0) {
+    mRecordJobs.emplace_back([this](VkCommandBuffer commandBuffer) { recordLines(commandBuffer); });
+  }
+  mRecordJobs.emplace_back([this](VkCommandBuffer commandBuffer) { recordUserInterface(commandBuffer); });
 
+  if (!recordSecondaryCommandBuffers(mRenderData.rdFramebuffers[imageIndex], viewport, scissor)) {
+    return false;
+  }
+
+  /* the rendering itself happens here */
+  vkCmdBeginRenderPass(mRenderData.rdCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+  vkCmdExecuteCommands(mRenderData.rdCommandBuffer, static_cast<uint32_t>(mSecondaryCommandBuffers.size()),
+    mSecondaryCommandBuffers.data());
   vkCmdEndRenderPass(mRenderData.rdCommandBuffer);
 
+  if (drawGltfModel) {
+    GpuCulling::copyVisibleCount(mRenderData, mRenderData.rdCommandBuffer);
+  }
+
   if (vkEndCommandBuffer(mRenderData.rdCommandBuffer) != VK_SUCCESS) {
     Logger::log(1, "%s error: failed to end command buffer\n", __FUNCTION__);
     return false;
   }
 
-  /* upload UBO data after commands are created */
-  mUploadToUBOTimer.start();
-  void* data;
-  vmaMapMemory(mRenderData.rdAllocator, mRenderData.rdPerspViewMatrixUBO.rdUboBufferAlloc,
-    &data);
-  memcpy(data, mPerspViewMatrices.data(),
-    static_cast<uint32_t>(mPerspViewMatrices.size() * sizeof(glm::mat4)));
-  vmaUnmapMemory(mRenderData.rdAllocator, mRenderData.rdPerspViewMatrixUBO.rdUboBufferAlloc);
-
-  if (mRenderData.rdGPUDualQuatVertexSkinning == skinningMode::dualQuat) {
-    std::vector<glm::mat2x4> jointDualQuats = mGltfModel->getJointDualQuats();
-    vmaMapMemory(mRenderData.rdAllocator, mRenderData.rdJointDualQuatSSBO.rdSsboBufferAlloc,
-      &data);
-    memcpy(data, jointDualQuats.data(),
-      static_cast<uint32_t>(jointDualQuats.size() * sizeof(glm::mat2x4)));
-    vmaUnmapMemory(mRenderData.rdAllocator, mRenderData.rdJointDualQuatSSBO.rdSsboBufferAlloc);
-  } else {
-    std::vector<glm::mat4> jointMatrices = mGltfModel->getJointMatrices();
-    vmaMapMemory(mRenderData.rdAllocator, mRenderData.rdJointMatrixSSBO.rdSsboBufferAlloc,
-      &data);
-    memcpy(data, jointMatrices.data(),
-      static_cast<uint32_t>(jointMatrices.size() * sizeof(glm::mat4)));
-    vmaUnmapMemory(mRenderData.rdAllocator, mRenderData.rdJointMatrixSSBO.rdSsboBufferAlloc);
-  }
-  mRenderData.rdUploadToUBOTime = mUploadToUBOTimer.stop();
-
   /* submit command buffer */
   VkSubmitInfo submitInfo{};
   submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -971,23 +1107,26 @@ bool VkRenderer::draw() {
   submitInfo.pWaitDstStageMask = &waitStage;
 
   submitInfo.waitSemaphoreCount = 1;
-  submitInfo.pWaitSemaphores = &mRenderData.rdPresentSemaphore;
+  submitInfo.pWaitSemaphores = &mRenderData.rdPresentSemaphores.at(currentFrame);
 
   submitInfo.signalSemaphoreCount = 1;
-  submitInfo.pSignalSemaphores = &mRenderData.rdRenderSemaphore;
+  submitInfo.pSignalSemaphores = &mRenderData.rdRenderSemaphores.at(currentFrame);
 
   submitInfo.commandBufferCount = 1;
   submitInfo.pCommandBuffers = &mRenderData.rdCommandBuffer;
 
-  if (vkQueueSubmit(mRenderData.rdGraphicsQueue, 1, &submitInfo, mRenderData.rdRenderFence) != VK_SUCCESS) {
+  if (vkQueueSubmit(mRenderData.rdGraphicsQueue, 1, &submitInfo, renderFence) != VK_SUCCESS) {
     Logger::log(1, "%s error: failed to submit draw command buffer\n", __FUNCTION__);
     return false;
   }
 
+  /* advance before presenting, a swapchain recreation below returns early */
+  mRenderData.rdCurrentFrame = (currentFrame + 1) % mRenderData.rdFramesInFlight;
+
   VkPresentInfoKHR presentInfo{};
   presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
   presentInfo.waitSemaphoreCount = 1;
-  presentInfo.pWaitSemaphores = &mRenderData.rdRenderSemaphore;
+  presentInfo.pWaitSemaphores = &mRenderData.rdRenderSemaphores.at(currentFrame);
 
   presentInfo.swapchainCount = 1;
   presentInfo.pSwapchains = &mRenderData.rdVkbSwapchain.swapchain;
@@ -1007,3 +1146,100 @@ bool VkRenderer::draw() {
 
   return true;
 }
+
+bool VkRenderer::recordSecondaryCommandBuffers(VkFramebuffer framebuffer, const VkViewport &viewport,
+    const VkRect2D &scissor) {
+  mSecondaryCommandBuffers.assign(mRecordJobs.size(), VK_NULL_HANDLE);
+
+  mRecordThreadPool->runJobs(mRecordJobs.size(), [&](unsigned int jobIndex, unsigned int threadIndex) {
+    VkCommandBuffer commandBuffer = SecondaryCommandBuffer::begin(mRenderData, threadIndex, framebuffer);
+    if (commandBuffer == VK_NULL_HANDLE) {
+      return;
+    }
+
+    /* dynamic state and descriptor sets are not inherited from the primary command buffer */
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    /* UBOs */
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+      mRenderData.rdGltfPipelineLayout, 1, 1, &mRenderData.rdPerspViewMatrixUBO.rdUBODescriptorSet,
+      1, &mRenderData.rdPerspViewMatrixUBO.rdUBODynamicOffset);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+      mRenderData.rdGltfPipelineLayout, 2, 1, &mRenderData.rdJointMatrixSSBO.rdSSBODescriptorSet,
+      1, &mRenderData.rdJointMatrixSSBO.rdSsboDynamicOffset);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+      mRenderData.rdGltfPipelineLayout, 3, 1, &mRenderData.rdJointDualQuatSSBO.rdSSBODescriptorSet,
+      1, &mRenderData.rdJointDualQuatSSBO.rdSsboDynamicOffset);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+      mRenderData.rdGltfPipelineLayout, 4, 1, &mRenderData.rdInstanceMatrixSSBO.rdSSBODescriptorSet,
+      1, &mRenderData.rdInstanceMatrixSSBO.rdSsboDynamicOffset);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+      mRenderData.rdGltfPipelineLayout, 5, 1, &mRenderData.rdGpuCulling.rdDescriptorSet,
+      static_cast<uint32_t>(mRenderData.rdGpuCulling.rdDynamicOffsets.size()),
+      mRenderData.rdGpuCulling.rdDynamicOffsets.data());
+
+    mRecordJobs.at(jobIndex)(commandBuffer);
+
+    if (SecondaryCommandBuffer::end(commandBuffer)) {
+      mSecondaryCommandBuffers.at(jobIndex) = commandBuffer;
+    }
+  });
+
+  for (const auto commandBuffer : mSecondaryCommandBuffers) {
+    if (commandBuffer == VK_NULL_HANDLE) {
+      Logger::log(1, "%s error: failed to record secondary command buffers\n", __FUNCTION__);
+      return false;
+    }
+  }
+  return true;
+}
+
+void VkRenderer::recordGltfModel(VkCommandBuffer commandBuffer) {
+  GpuProfiler::beginScope(mRenderData, commandBuffer, gpuScope::modelDraw);
+  mGltfModel->draw(mRenderData, mGltfRenderData, commandBuffer, mRenderData.rdGpuCulling.rdIndirectBuffer,
+    GpuCulling::getIndirectOffset(mRenderData));
+  GpuProfiler::endScope(mRenderData, commandBuffer, gpuScope::modelDraw);
+}
+
+void VkRenderer::recordLines(VkCommandBuffer commandBuffer) {
+  /* the draws start at the region of the current frame */
+  LineRing::bind(mRenderData, commandBuffer);
+  vkCmdSetLineWidth(commandBuffer, 3.0f);
+
+  if (mCoordArrowsLineIndexCount > 0 || mSplineLineIndexCount > 0) {
+    GpuProfiler::beginScope(mRenderData, commandBuffer, gpuScope::lines);
+  }
+
+  /* draw the coordinate arrow WITH depth buffer */
+  if (mCoordArrowsLineIndexCount > 0) {
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdLinePipeline);
+    vkCmdDraw(commandBuffer, mCoordArrowsLineIndexCount, 1, mSkeletonLineIndexCount, 0);
+  }
+
+  if (mSplineLineIndexCount > 0) {
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdLinePipeline);
+    vkCmdDraw(commandBuffer, mSplineLineIndexCount, 1, mCoordArrowsLineIndexCount + mSkeletonLineIndexCount, 0);
+  }
+
+  if (mCoordArrowsLineIndexCount > 0 || mSplineLineIndexCount > 0) {
+    GpuProfiler::endScope(mRenderData, commandBuffer, gpuScope::lines);
+  }
+
+  /* draw the skeleton last, disable depth test to overlay */
+  if (mSkeletonLineIndexCount > 0) {
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdGltfSkeletonPipeline);
+    GpuProfiler::beginScope(mRenderData, commandBuffer, gpuScope::skeleton);
+    vkCmdDraw(commandBuffer, mSkeletonLineIndexCount, 1, 0, 0);
+    GpuProfiler::endScope(mRenderData, commandBuffer, gpuScope::skeleton);
+  }
+}
+
+void VkRenderer::recordUserInterface(VkCommandBuffer commandBuffer) {
+  /* imgui overlay */
+  mUIDrawTimer.start();
+  GpuProfiler::beginScope(mRenderData, commandBuffer, gpuScope::userInterface);
+  mUserInterface.render(mRenderData, commandBuffer);
+  GpuProfiler::endScope(mRenderData, commandBuffer, gpuScope::userInterface);
+  mRenderData.rdUIDrawTime = mUIDrawTimer.stop();
+}
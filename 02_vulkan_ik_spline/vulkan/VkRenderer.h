@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <functional>
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 /* Vulkan also before GLFW */
@@ -15,24 +16,35 @@
 #include "Timer.h"
 #include "Renderpass.h"
 #include "Pipeline.h"
+#include "PipelineCache.h"
 #include "GltfPipeline.h"
 #include "GltfSkeletonPipeline.h"
 #include "GltfGPUPipeline.h"
+#include "ComputePipeline.h"
 #include "PipelineLayout.h"
 #include "Framebuffer.h"
 #include "CommandPool.h"
 #include "CommandBuffer.h"
 #include "SyncObjects.h"
 #include "Texture.h"
+#include "UploadRing.h"
+#include "LineRing.h"
+#include "GpuProfiler.h"
+#include "GpuCulling.h"
+#include "SecondaryCommandBuffer.h"
+#include "StagingPool.h"
+#include "UploadManager.h"
 #include "UniformBuffer.h"
 #include "ShaderStorageBuffer.h"
 #include "VertexBuffer.h"
 #include "IndexBuffer.h"
 #include "UserInterface.h"
 #include "Camera.h"
+#include "WorkerThreadPool.h"
 #include "CoordArrowsModel.h"
 #include "SplineModel.h"
 #include "GltfModel.h"
+#include "GltfCrowd.h"
 
 #include "VkRenderData.h"
 
@@ -57,18 +69,18 @@ class VkRenderer {
     Camera mCamera{};
 
     CoordArrowsModel mCoordArrowsModel{};
-    VkMesh mCoordArrowsMesh{};
 
     SplineModel mSplineModel{};
-    VkMesh mSplineMesh{};
 
-    std::shared_ptr<VkMesh> mLineMesh = nullptr;
+    /* skeleton, arrows and spline vertices per frame */
+    uint32_t mMaxLineVertices = 16384;
     unsigned int mSplineLineIndexCount = 0;
     unsigned int mSkeletonLineIndexCount = 0;
     unsigned int mCoordArrowsLineIndexCount = 0;
 
     std::shared_ptr<GltfModel> mGltfModel = nullptr;
-    bool mModelUploadRequired = true;
+    uint64_t mModelUploadBatch = 0;
+    GltfCrowd mCrowd{};
 
     bool mMouseLock = false;
     int mMouseXPos = 0;
@@ -82,12 +94,25 @@ class VkRenderer {
     int mCameraUpDown = 0;
 
     Timer mFrameTimer{};
+    Timer mWaitForFenceTimer{};
     Timer mMatrixGenerateTimer{};
     Timer mIKTimer{};
     Timer mUploadToVBOTimer{};
     Timer mUploadToUBOTimer{};
     Timer mUIGenerateTimer{};
     Timer mUIDrawTimer{};
+    Timer mPipelineCreationTimer{};
+
+    /* one recording job per secondary command buffer, run on the worker threads */
+    std::unique_ptr<WorkerThreadPool> mRecordThreadPool = nullptr;
+    const unsigned int mMaxRecordThreads = 3;
+    std::vector<std::function<void(VkCommandBuffer)>> mRecordJobs{};
+    std::vector<VkCommandBuffer> mSecondaryCommandBuffers{};
+
+    const std::string mPipelineCacheFileName = "pipeline_cache.bin";
+    const std::string mGpuProfileFileName = "gpu_profile.csv";
+    /* larger uploads get a block of their own */
+    const VkDeviceSize mStagingBlockSize = 4 * 1024 * 1024;
 
     VkSurfaceKHR mSurface = VK_NULL_HANDLE;
 
@@ -98,23 +123,28 @@ class VkRenderer {
     bool deviceInit();
     bool getQueue();
     bool createDepthBuffer();
-    bool createVBO();
+    bool createLineRing();
+    bool createStagingPool();
+    bool createGpuProfiler();
+    bool createGpuCulling();
+    bool createUploadRing();
     bool createUBO(VkUniformBufferData &UBOData,
-      std::vector<glm::mat4> matricesToUpload);
-    bool createSSBO(VkShaderStorageBufferData &SSBOData,
-      std::vector<glm::mat4> matricesToUpload);
-    bool createSSBO(VkShaderStorageBufferData &SSBOData,
-      std::vector<glm::mat2x4> matricesToUpload);
+      const std::vector<glm::mat4>& matricesToUpload);
+    bool createSSBO(VkShaderStorageBufferData &SSBOData, const size_t bufferSize);
     bool createSwapchain();
     bool createRenderPass();
     bool createGltfPipelineLayout();
+    bool createPipelineCache();
     bool createLinePipeline();
     bool createGltfSkeletonPipeline();
     bool createGltfGPUPipeline();
     bool createGltfGPUDQPipeline();
+    bool createCullPipeline();
     bool createFramebuffer();
     bool createCommandPool();
+    bool createUploadManager();
     bool createCommandBuffer();
+    bool createSecondaryCommandBuffers();
     bool createSyncObjects();
     bool loadTexture(VkTextureData &textureData);
     bool initUserInterface();
@@ -123,4 +153,10 @@ class VkRenderer {
     bool initVma();
 
     bool recreateSwapchain();
+
+    bool recordSecondaryCommandBuffers(VkFramebuffer framebuffer, const VkViewport &viewport,
+      const VkRect2D &scissor);
+    void recordGltfModel(VkCommandBuffer commandBuffer);
+    void recordLines(VkCommandBuffer commandBuffer);
+    void recordUserInterface(VkCommandBuffer commandBuffer);
 };
@@ -0,0 +1,132 @@
+/* collision benchmark, thousands of spheres falling onto a plane */
+#include <cstdio>
+#include <array>
+#include <vector>
+#include <memory>
+
+#include <glm/glm.hpp>
+
+#include "RigidBody.h"
+#include "RigidBodyWorld.h"
+#include "SpatialHashBroadphase.h"
+#include "ForceRegistry.h"
+#include "GravityForce.h"
+#include "Timer.h"
+#include "Logger.h"
+
+/* small deterministic generator, same scene on every platform */
+float nextRandom(unsigned int& seed) {
+  seed = seed * 1664525u + 1013904223u;
+  return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+}
+
+/* reference for the broadphase, tests all bounding boxes against each other */
+unsigned int countPairsBruteForce(const RigidBodyStorage& bodies) {
+  unsigned int numPairs = 0;
+  for (int i = 0; i < bodies.size(); ++i) {
+    if (bodies.rbShapes[i] == collisionShape::none) {
+      continue;
+    }
+    float firstRadius = bodies.getBoundingRadius(i);
+    for (int j = i + 1; j < bodies.size(); ++j) {
+      if (bodies.rbShapes[j] == collisionShape::none) {
+        continue;
+      }
+      if (!bodies.isActive(i) && !bodies.isActive(j)) {
+        continue;
+      }
+      glm::vec3 distance = glm::abs(bodies.rbPositions[i] - bodies.rbPositions[j]);
+      float radiusSum = firstRadius + bodies.getBoundingRadius(j);
+      if (distance.x <= radiusSum && distance.y <= radiusSum && distance.z <= radiusSum) {
+        ++numPairs;
+      }
+    }
+  }
+  return numPairs;
+}
+
+void runBenchmark(const unsigned int numSpheres, const unsigned int numFrames) {
+  const float radius = 0.25f;
+  const float deltaTime = 1.0f / 60.0f;
+
+  RigidBodyWorld world(numSpheres * 6);
+  world.addCollisionPlane(glm::vec3(0.0f, 1.0f, 0.0f), 0.0f);
+  world.setCollisionCellSize(radius * 2.0f);
+
+  ForceRegistry forceRegistry(world.getRigidBodyStorage());
+  std::shared_ptr<GravityForce> gravity = std::make_shared<GravityForce>(glm::vec3(0.0f, -10.0f, 0.0f));
+
+  /* loose column of spheres, wide enough to spread on the ground */
+  unsigned int seed = 42;
+  unsigned int spheresPerRow = 20;
+  for (unsigned int i = 0; i < numSpheres; ++i) {
+    std::shared_ptr<RigidBody> sphere = world.createRigidBody();
+    float x = static_cast<float>(i % spheresPerRow) * radius * 2.5f + nextRandom(seed) * 0.1f;
+    float z = static_cast<float>((i / spheresPerRow) % spheresPerRow) * radius * 2.5f + nextRandom(seed) * 0.1f;
+    float y = 1.0f + static_cast<float>(i / (spheresPerRow * spheresPerRow)) * radius * 3.0f;
+    sphere->setPosition(glm::vec3(x, y, z));
+    sphere->setMass(1.0f);
+    sphere->setLinearDaming(0.95f);
+    sphere->setCollisionShape(collisionShape::sphere, glm::vec3(radius));
+    forceRegistry.addEntry(sphere, gravity);
+  }
+
+  Timer stepTimer;
+  Timer pairTimer;
+  float stepTime = 0.0f;
+  float broadphaseTime = 0.0f;
+  float bruteForceTime = 0.0f;
+  unsigned long long numPairs = 0;
+  unsigned long long numContacts = 0;
+  unsigned int numChecks = 0;
+  bool samePairs = true;
+
+  SpatialHashBroadphase broadphase;
+  broadphase.setCellSize(radius * 2.0f);
+  std::vector<std::array<int, 2>> pairs;
+
+  for (unsigned int frame = 0; frame < numFrames; ++frame) {
+    stepTimer.start();
+    world.startFrame();
+    forceRegistry.updateForces(deltaTime);
+    world.runPhysics(deltaTime);
+    stepTime += stepTimer.stop();
+
+    numPairs += world.getNumCollisionPairs();
+    numContacts += world.getNumContacts();
+
+    /* compare the pair search against the brute force search from time to time */
+    if (frame % 30 == 0) {
+      const RigidBodyStorage& bodies = *world.getRigidBodyStorage();
+
+      pairTimer.start();
+      broadphase.findPairs(bodies, pairs);
+      broadphaseTime += pairTimer.stop();
+
+      pairTimer.start();
+      unsigned int bruteForcePairs = countPairsBruteForce(bodies);
+      bruteForceTime += pairTimer.stop();
+
+      samePairs = samePairs && bruteForcePairs == pairs.size();
+      ++numChecks;
+    }
+  }
+
+  std::printf("%7u  %11.3f  %10.1f  %14.1f  %12u  %13.3f  %15.3f  %s\n", numSpheres, stepTime / numFrames,
+    static_cast<double>(numPairs) / numFrames, static_cast<double>(numContacts) / numFrames, world.getNumAwakeBodies(),
+    broadphaseTime / numChecks, bruteForceTime / numChecks, samePairs ? "yes" : "no");
+}
+
+int main(int argc, char *argv[]) {
+  /* silence the setup messages */
+  Logger::setLogLevel(0);
+
+  const std::array<unsigned int, 4> sphereCounts = { 1000, 2000, 4000, 8000 };
+
+  std::printf("spheres  ms per step  pairs/step  contacts/step  awake at end  hash pairs ms  brute pairs ms  same pairs\n");
+  for (const auto numSpheres : sphereCounts) {
+    runBenchmark(numSpheres, 300);
+  }
+
+  return 0;
+}
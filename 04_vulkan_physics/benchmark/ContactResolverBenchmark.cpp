@@ -0,0 +1,316 @@
+/* contact resolver benchmark, compares the priority queue and adjacency lists against a linear search of the island contacts
+ * and the island-parallel resolver on many independent bridges against a single thread
+ * fails if the results differ, the number of threads can be given as first argument */
+#include <cstdio>
+#include <cstdlib>
+#include <cfloat>
+#include <array>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <numeric>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+#include "RigidBody.h"
+#include "RigidBodyStorage.h"
+#include "BodyContact.h"
+#include "ContactResolver.h"
+#include "ContactAdjacency.h"
+#include "ContactCableBatch.h"
+#include "ContactRodBatch.h"
+#include "Timer.h"
+#include "Logger.h"
+
+/* same bridge as in VkRenderer::init(), but without the free bodies
+ * multiple bridges are placed side by side, sharing no bodies */
+struct BridgeScene {
+  std::shared_ptr<RigidBodyStorage> bodies = nullptr;
+  ContactCableBatch cables{};
+  ContactRodBatch rods{};
+  std::vector<BodyContact> contacts{};
+  unsigned int numIterations = 0;
+};
+
+void addBridge(BridgeScene& scene, const unsigned int bridgePoints, const float zOffset) {
+  std::vector<std::shared_ptr<RigidBody>> bodies;
+
+  /* anchors */
+  float xPos = 2.0f;
+  for (unsigned int i = 0; i < bridgePoints * 2; ++i) {
+    std::shared_ptr<RigidBody> anchor = std::make_shared<RigidBody>(scene.bodies, scene.bodies->addBody());
+    float zPos = 0.0f;
+    if (i % 2 == 0) {
+      xPos += 1.0f;
+      zPos = 1.0f;
+    }
+    anchor->setPosition(glm::vec3(xPos, 2.0f, zPos + zOffset));
+    anchor->setMass(-1.0f);
+    anchor->setLinearDaming(0.95f);
+    bodies.emplace_back(anchor);
+  }
+
+  /* plank holders */
+  xPos = 2.0f;
+  for (unsigned int i = 0; i < bridgePoints * 2; ++i) {
+    std::shared_ptr<RigidBody> body = std::make_shared<RigidBody>(scene.bodies, scene.bodies->addBody());
+    float zPos = 0.0f;
+    if (i % 2 == 0) {
+      xPos += 1.0f;
+      zPos = 1.0f;
+    }
+    body->setPosition(glm::vec3(xPos, 0.0f, zPos + zOffset));
+    body->setMass(1.0f);
+    body->setLinearDaming(0.95f);
+    bodies.emplace_back(body);
+  }
+
+  for (unsigned int i = 0; i < bridgePoints * 2; ++i) {
+    scene.cables.addCable(bodies.at(i)->getHandle(), bodies.at(i + bridgePoints * 2)->getHandle(), 2.1f, 0.25f);
+  }
+
+  for (unsigned int i = bridgePoints * 2; i < bridgePoints * 4 - 2; ++i) {
+    scene.cables.addCable(bodies.at(i)->getHandle(), bodies.at(i + 2)->getHandle(), 0.75f, 0.1f);
+  }
+
+  for (unsigned int i = bridgePoints * 2; i < bridgePoints * 4; i += 2) {
+    scene.rods.addRod(bodies.at(i)->getHandle(), bodies.at(i + 1)->getHandle(), 0.75f);
+  }
+}
+
+BridgeScene createBridgeScene(const unsigned int bridgePoints, const unsigned int numBridges) {
+  BridgeScene scene;
+  scene.bodies = std::make_shared<RigidBodyStorage>();
+  scene.bodies->reserve(bridgePoints * 4 * numBridges);
+
+  for (unsigned int i = 0; i < numBridges; ++i) {
+    addBridge(scene, bridgePoints, i * 3.0f);
+  }
+
+  /* same limits as used by the renderer */
+  scene.contacts.resize(bridgePoints * 10 * numBridges);
+  scene.numIterations = bridgePoints * 20 * numBridges;
+
+  return scene;
+}
+
+/* contacts sharing a movable body belong to the same island, same as in ContactResolver::buildIslands()
+ * returns the contacts of every island in ascending order */
+std::vector<std::vector<unsigned int>> findContactIslands(const RigidBodyStorage& bodies,
+    const std::vector<BodyContact>& contacts, const unsigned int numContacts) {
+  std::vector<unsigned int> parents(numContacts);
+  std::iota(parents.begin(), parents.end(), 0);
+  auto findRoot = [&parents](unsigned int contactIndex) {
+    while (parents[contactIndex] != contactIndex) {
+      contactIndex = parents[contactIndex] = parents[parents[contactIndex]];
+    }
+    return contactIndex;
+  };
+
+  std::vector<int> firstBodyContacts(bodies.size(), -1);
+  for (unsigned int i = 0; i < numContacts; ++i) {
+    for (unsigned int j = 0; j < 2; ++j) {
+      int body = contacts.at(i).getBody(j);
+      if (body < 0 || bodies.hasInfiniteMass(body)) {
+        continue;
+      }
+      if (firstBodyContacts[body] < 0) {
+        firstBodyContacts[body] = i;
+        continue;
+      }
+      unsigned int firstRoot = findRoot(firstBodyContacts[body]);
+      unsigned int secondRoot = findRoot(i);
+      parents[std::max(firstRoot, secondRoot)] = std::min(firstRoot, secondRoot);
+    }
+  }
+
+  std::vector<std::vector<unsigned int>> islands;
+  std::vector<unsigned int> rootIslands(numContacts, 0);
+  for (unsigned int i = 0; i < numContacts; ++i) {
+    unsigned int root = findRoot(i);
+    if (root == i) {
+      rootIslands[i] = islands.size();
+      islands.emplace_back();
+    }
+    islands.at(rootIslands[root]).emplace_back(i);
+  }
+  return islands;
+}
+
+/* the previous implementation, searching all contacts of the island in every iteration
+ * every island gets its share of the iterations, same as in the queue resolver */
+unsigned int resolveContactsLinear(RigidBodyStorage& bodies, std::vector<BodyContact>& contacts,
+    const unsigned int numContacts, const unsigned int numIterations, const float deltaTime) {
+  unsigned int usedIterations = 0;
+
+  for (const auto& islandContacts : findContactIslands(bodies, contacts, numContacts)) {
+    unsigned int islandIterations = static_cast<unsigned int>(
+      (static_cast<unsigned long long>(numIterations) * islandContacts.size() + numContacts - 1) / numContacts);
+
+    for (unsigned int iteration = 0; iteration < islandIterations; ++iteration) {
+      float maxValue = FLT_MAX;
+      unsigned int maxIndex = numContacts;
+
+      for (const auto i : islandContacts) {
+        float separationVelocity = contacts.at(i).calculateSeparatingVelocity(bodies);
+        if (separationVelocity < maxValue && (separationVelocity < 0 || contacts.at(i).getInterPenetration() > 0)) {
+          maxValue = separationVelocity;
+          maxIndex = i;
+        }
+      }
+
+      if (maxIndex == numContacts) {
+        break;
+      }
+
+      contacts.at(maxIndex).resolveContact(bodies, deltaTime);
+
+      std::array<glm::vec3, 2> bodyMovements = contacts.at(maxIndex).getBodyMovements();
+      int firstBody = contacts.at(maxIndex).getBody(0);
+      int secondBody = contacts.at(maxIndex).getBody(1);
+
+      for (unsigned int i = 0; i < numContacts; ++i) {
+        if (contacts.at(i).getBody(0) == firstBody) {
+          contacts.at(i).setInterPenetration(
+            contacts.at(i).getInterPenetration() - glm::dot(bodyMovements.at(0), contacts.at(i).getContactNormal()));
+        } else if (contacts.at(i).getBody(0) == secondBody) {
+          contacts.at(i).setInterPenetration(
+            contacts.at(i).getInterPenetration() - glm::dot(bodyMovements.at(1), contacts.at(i).getContactNormal()));
+        }
+
+        if (contacts.at(i).getBody(1) >= 0) {
+          if (contacts.at(i).getBody(1) == firstBody) {
+            contacts.at(i).setInterPenetration(
+              contacts.at(i).getInterPenetration() + glm::dot(bodyMovements.at(0), contacts.at(i).getContactNormal()));
+          } else if (contacts.at(i).getBody(1) == secondBody) {
+            contacts.at(i).setInterPenetration(
+              contacts.at(i).getInterPenetration() + glm::dot(bodyMovements.at(1), contacts.at(i).getContactNormal()));
+          }
+        }
+      }
+      ++usedIterations;
+    }
+  }
+  return usedIterations;
+}
+
+struct BenchmarkResult {
+  float resolverTime = 0.0f;
+  unsigned long long contacts = 0;
+  unsigned long long iterations = 0;
+  std::vector<glm::vec3> positions{};
+};
+
+/* all bodies must end up at exactly the same position */
+bool isSameResult(const BenchmarkResult& first, const BenchmarkResult& second) {
+  return first.positions == second.positions;
+}
+
+BenchmarkResult runBenchmark(const unsigned int bridgePoints, const unsigned int numBridges, const unsigned int numFrames,
+    const bool useLinearSearch, const unsigned int numThreads) {
+  BridgeScene scene = createBridgeScene(bridgePoints, numBridges);
+  RigidBodyStorage& bodies = *scene.bodies;
+  ContactResolver resolver(scene.numIterations);
+  resolver.setNumThreads(numThreads);
+  ContactAdjacency adjacency;
+
+  const float deltaTime = 1.0f / 60.0f;
+  const glm::vec3 gravity = glm::vec3(0.0f, -10.0f, 0.0f);
+
+  BenchmarkResult result;
+  Timer resolverTimer;
+
+  for (unsigned int frame = 0; frame < numFrames; ++frame) {
+    for (int i = 0; i < bodies.size(); ++i) {
+      bodies.clearAccumulatedForce(i);
+      bodies.calculateDerivedData(i);
+      if (!bodies.hasInfiniteMass(i)) {
+        bodies.rbAccumulatedForces[i] += gravity / bodies.rbInverseMasses[i];
+      }
+    }
+
+    for (int i = 0; i < bodies.size(); ++i) {
+      bodies.integrate(i, deltaTime);
+    }
+
+    unsigned int limit = scene.contacts.size();
+    unsigned int contactIndex = 0;
+    contactIndex += scene.cables.addContacts(bodies, scene.contacts.data() + contactIndex, limit - contactIndex);
+    contactIndex += scene.rods.addContacts(bodies, scene.contacts.data() + contactIndex, limit - contactIndex);
+    adjacency.build(bodies.size(), scene.contacts, contactIndex);
+
+    resolverTimer.start();
+    if (useLinearSearch) {
+      result.iterations += resolveContactsLinear(bodies, scene.contacts, contactIndex, scene.numIterations, deltaTime);
+    } else {
+      result.iterations += resolver.resolveContacts(bodies, scene.contacts, contactIndex, adjacency, deltaTime);
+    }
+    result.resolverTime += resolverTimer.stop();
+    result.contacts += contactIndex;
+  }
+
+  result.positions = bodies.rbPositions;
+  return result;
+}
+
+int main(int argc, char *argv[]) {
+  /* silence the setup messages */
+  Logger::setLogLevel(0);
+
+  const unsigned int NUMBER_OF_BRIDGE_POINTS = 5;
+  const std::array<unsigned int, 3> scales = { 1, 10, 100 };
+
+  bool success = true;
+
+  std::printf("scale  bodies  contacts/frame  iterations/frame  linear ms/frame  queue ms/frame  speedup  same result\n");
+  for (const auto scale : scales) {
+    unsigned int bridgePoints = NUMBER_OF_BRIDGE_POINTS * scale;
+    /* the linear search is too slow for many frames at the largest scale */
+    unsigned int numFrames = scale >= 100 ? 20 : 200;
+
+    BenchmarkResult linearResult = runBenchmark(bridgePoints, 1, numFrames, true, 1);
+    BenchmarkResult queueResult = runBenchmark(bridgePoints, 1, numFrames, false, 1);
+
+    bool sameResult = isSameResult(linearResult, queueResult);
+    success = success && sameResult;
+
+    std::printf("%5u  %6u  %14.1f  %16.1f  %15.3f  %14.3f  %6.1fx  %s\n", scale, bridgePoints * 4,
+      static_cast<double>(queueResult.contacts) / numFrames,
+      static_cast<double>(queueResult.iterations) / numFrames,
+      linearResult.resolverTime / numFrames, queueResult.resolverTime / numFrames,
+      queueResult.resolverTime > 0.0f ? linearResult.resolverTime / queueResult.resolverTime : 0.0f,
+      sameResult ? "yes" : "no");
+  }
+
+  /* stress scene, every bridge is an island of its own */
+  unsigned int numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  if (argc > 1) {
+    numThreads = std::max(std::atoi(argv[1]), 1);
+  }
+  const std::array<unsigned int, 3> bridgeCounts = { 16, 64, 256 };
+  const unsigned int numFrames = 100;
+
+  std::printf("\nbridges  bodies  contacts/frame  iterations/frame  1 thread ms/frame  %u threads ms/frame  speedup  same result\n",
+    numThreads);
+  for (const auto numBridges : bridgeCounts) {
+    BenchmarkResult singleResult = runBenchmark(NUMBER_OF_BRIDGE_POINTS * 4, numBridges, numFrames, false, 1);
+    BenchmarkResult parallelResult = runBenchmark(NUMBER_OF_BRIDGE_POINTS * 4, numBridges, numFrames, false, numThreads);
+    bool sameResult = isSameResult(singleResult, parallelResult);
+    success = success && sameResult;
+
+    std::printf("%7u  %6u  %14.1f  %16.1f  %17.3f  %18.3f  %6.1fx  %s\n", numBridges,
+      NUMBER_OF_BRIDGE_POINTS * 16 * numBridges,
+      static_cast<double>(parallelResult.contacts) / numFrames,
+      static_cast<double>(parallelResult.iterations) / numFrames,
+      singleResult.resolverTime / numFrames, parallelResult.resolverTime / numFrames,
+      parallelResult.resolverTime > 0.0f ? singleResult.resolverTime / parallelResult.resolverTime : 0.0f,
+      sameResult ? "yes" : "no");
+  }
+
+  if (!success) {
+    std::printf("\nerror: the results of the resolvers differ\n");
+    return 1;
+  }
+  return 0;
+}
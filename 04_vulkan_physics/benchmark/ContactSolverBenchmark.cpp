@@ -0,0 +1,275 @@
+/* contact solver benchmark, compares the priority queue resolver against the sequential impulse solver
+ * by the remaining constraint error and the time needed to get there */
+#include <cstdio>
+#include <array>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "RigidBody.h"
+#include "RigidBodyStorage.h"
+#include "BodyContact.h"
+#include "ContactResolver.h"
+#include "SequentialImpulseSolver.h"
+#include "ContactAdjacency.h"
+#include "ContactCableBatch.h"
+#include "ContactRodBatch.h"
+#include "Timer.h"
+#include "Logger.h"
+
+/* bridges like in VkRenderer::init(), with a heavy weight hanging from the middle of every bridge
+ * unlike the demo bridge, all cable and rod lengths fit the initial positions, so the error can reach zero */
+struct BridgeScene {
+  std::shared_ptr<RigidBodyStorage> bodies = nullptr;
+  ContactCableBatch cables{};
+  ContactRodBatch rods{};
+  std::vector<BodyContact> contacts{};
+  /* contacts generated after solving, to measure the remaining error of the solved contacts */
+  std::vector<BodyContact> errorContacts{};
+};
+
+void addBridge(BridgeScene& scene, const unsigned int bridgePoints, const float zOffset) {
+  std::vector<std::shared_ptr<RigidBody>> bodies;
+
+  /* anchors */
+  float xPos = 2.0f;
+  for (unsigned int i = 0; i < bridgePoints * 2; ++i) {
+    std::shared_ptr<RigidBody> anchor = std::make_shared<RigidBody>(scene.bodies, scene.bodies->addBody());
+    float zPos = 0.0f;
+    if (i % 2 == 0) {
+      xPos += 1.0f;
+      zPos = 1.0f;
+    }
+    anchor->setPosition(glm::vec3(xPos, 2.0f, zPos + zOffset));
+    anchor->setMass(-1.0f);
+    anchor->setLinearDaming(0.95f);
+    bodies.emplace_back(anchor);
+  }
+
+  /* plank holders */
+  xPos = 2.0f;
+  for (unsigned int i = 0; i < bridgePoints * 2; ++i) {
+    std::shared_ptr<RigidBody> body = std::make_shared<RigidBody>(scene.bodies, scene.bodies->addBody());
+    float zPos = 0.0f;
+    if (i % 2 == 0) {
+      xPos += 1.0f;
+      zPos = 1.0f;
+    }
+    body->setPosition(glm::vec3(xPos, 0.0f, zPos + zOffset));
+    body->setMass(1.0f);
+    body->setLinearDaming(0.95f);
+    bodies.emplace_back(body);
+  }
+
+  for (unsigned int i = 0; i < bridgePoints * 2; ++i) {
+    scene.cables.addCable(bodies.at(i)->getHandle(), bodies.at(i + bridgePoints * 2)->getHandle(), 2.1f, 0.25f);
+  }
+
+  for (unsigned int i = bridgePoints * 2; i < bridgePoints * 4 - 2; ++i) {
+    scene.cables.addCable(bodies.at(i)->getHandle(), bodies.at(i + 2)->getHandle(), 1.05f, 0.1f);
+  }
+
+  for (unsigned int i = bridgePoints * 2; i < bridgePoints * 4; i += 2) {
+    scene.rods.addRod(bodies.at(i)->getHandle(), bodies.at(i + 1)->getHandle(), 1.0f);
+  }
+
+  /* the weight stretches the cables, so the constraint error is visible */
+  std::shared_ptr<RigidBody> weight = std::make_shared<RigidBody>(scene.bodies, scene.bodies->addBody());
+  weight->setPosition(bodies.at(bridgePoints * 3)->getPosition() - glm::vec3(0.0f, 1.5f, 0.0f));
+  weight->setMass(10.0f);
+  weight->setLinearDaming(0.95f);
+  scene.cables.addCable(bodies.at(bridgePoints * 3)->getHandle(), weight->getHandle(), 2.0f, 0.4f);
+}
+
+BridgeScene createBridgeScene(const unsigned int bridgePoints, const unsigned int numBridges) {
+  BridgeScene scene;
+  scene.bodies = std::make_shared<RigidBodyStorage>();
+  scene.bodies->reserve((bridgePoints * 4 + 1) * numBridges);
+
+  for (unsigned int i = 0; i < numBridges; ++i) {
+    addBridge(scene, bridgePoints, i * 3.0f);
+  }
+
+  scene.contacts.resize(scene.cables.size() + scene.rods.size());
+  scene.errorContacts.resize(scene.contacts.size());
+
+  return scene;
+}
+
+unsigned int generateContacts(const BridgeScene& scene, std::vector<BodyContact>& contacts) {
+  unsigned int limit = contacts.size();
+  unsigned int numContacts = scene.cables.addContacts(*scene.bodies, contacts.data(), limit);
+  numContacts += scene.rods.addContacts(*scene.bodies, contacts.data() + numContacts, limit - numContacts);
+  return numContacts;
+}
+
+enum class solverType {
+  priorityQueue,
+  sequentialImpulse,
+  sequentialImpulseWarm
+};
+
+struct BenchmarkConfig {
+  solverType type = solverType::priorityQueue;
+  /* resolver iterations per contact, or velocity and position sweeps */
+  unsigned int iterations = 0;
+};
+
+struct BenchmarkResult {
+  float solverTime = 0.0f;
+  unsigned long long contacts = 0;
+  unsigned long long iterations = 0;
+  unsigned long long contactUpdates = 0;
+  double error = 0.0;
+};
+
+BenchmarkResult runBenchmark(const BenchmarkConfig config, const unsigned int bridgePoints, const unsigned int numBridges,
+    const unsigned int numFrames, const unsigned int numWarmupFrames) {
+  BridgeScene scene = createBridgeScene(bridgePoints, numBridges);
+  RigidBodyStorage& bodies = *scene.bodies;
+
+  ContactResolver resolver(0);
+  ContactAdjacency adjacency;
+
+  SequentialImpulseSolver impulseSolver;
+  /* always run all sweeps, the error is measured instead */
+  impulseSolver.setIterations(config.iterations, config.iterations);
+  impulseSolver.setTolerances(0.0f, 0.0f);
+  impulseSolver.setWarmStarting(config.type == solverType::sequentialImpulseWarm);
+
+  const float deltaTime = 1.0f / 60.0f;
+  const glm::vec3 gravity = glm::vec3(0.0f, -10.0f, 0.0f);
+
+  BenchmarkResult result;
+  Timer solverTimer;
+
+  for (unsigned int frame = 0; frame < numWarmupFrames + numFrames; ++frame) {
+    for (int i = 0; i < bodies.size(); ++i) {
+      bodies.clearAccumulatedForce(i);
+      bodies.calculateDerivedData(i);
+      if (!bodies.hasInfiniteMass(i)) {
+        bodies.rbAccumulatedForces[i] += gravity / bodies.rbInverseMasses[i];
+      }
+    }
+
+    for (int i = 0; i < bodies.size(); ++i) {
+      bodies.integrate(i, deltaTime);
+    }
+
+    unsigned int numContacts = generateContacts(scene, scene.contacts);
+
+    unsigned int iterations = 0;
+    solverTimer.start();
+    if (config.type == solverType::priorityQueue) {
+      adjacency.build(bodies.size(), scene.contacts, numContacts);
+      resolver.setIterations(numContacts * config.iterations);
+      iterations = resolver.resolveContacts(bodies, scene.contacts, numContacts, adjacency, deltaTime);
+    } else {
+      iterations = impulseSolver.resolveContacts(bodies, scene.contacts, numContacts, deltaTime);
+    }
+    float frameTime = solverTimer.stop();
+
+    /* let the bridges settle before measuring */
+    if (frame < numWarmupFrames) {
+      continue;
+    }
+
+    result.solverTime += frameTime;
+    result.contacts += numContacts;
+    result.iterations += iterations;
+    result.contactUpdates += config.type == solverType::priorityQueue ? iterations : iterations * numContacts;
+
+    /* remaining error is the largest violation of a solved cable or rod length
+     * contacts are generated ordered by their source keys, so both lists can be walked together */
+    float maxError = 0.0f;
+    unsigned int numErrorContacts = generateContacts(scene, scene.errorContacts);
+    unsigned int solvedIndex = 0;
+    for (unsigned int i = 0; i < numErrorContacts; ++i) {
+      uint64_t sourceKey = scene.errorContacts.at(i).getSourceKey();
+      while (solvedIndex < numContacts && scene.contacts.at(solvedIndex).getSourceKey() < sourceKey) {
+        ++solvedIndex;
+      }
+      if (solvedIndex < numContacts && scene.contacts.at(solvedIndex).getSourceKey() == sourceKey) {
+        maxError = std::max(maxError, scene.errorContacts.at(i).getInterPenetration());
+      }
+    }
+    result.error += maxError;
+  }
+
+  return result;
+}
+
+const char* getSolverName(const solverType type) {
+  switch (type) {
+    case solverType::priorityQueue:
+      return "priority queue";
+    case solverType::sequentialImpulse:
+      return "impulse";
+    case solverType::sequentialImpulseWarm:
+      return "impulse warm";
+    default:
+      return "unknown";
+  }
+}
+
+int main(int argc, char *argv[]) {
+  /* silence the setup messages */
+  Logger::setLogLevel(0);
+
+  const unsigned int NUMBER_OF_BRIDGE_POINTS = 20;
+  const unsigned int NUMBER_OF_BRIDGES = 16;
+  const unsigned int numFrames = 300;
+  const unsigned int numWarmupFrames = 60;
+  /* mean of the largest cable or rod length error per frame */
+  const float targetError = 0.01f;
+
+  std::vector<BenchmarkConfig> configs;
+  for (const auto iterations : { 1, 2, 4, 8 }) {
+    configs.push_back({ solverType::priorityQueue, static_cast<unsigned int>(iterations) });
+  }
+  for (const auto type : { solverType::sequentialImpulse, solverType::sequentialImpulseWarm }) {
+    for (const auto iterations : { 1, 2, 4, 8, 16, 32 }) {
+      configs.push_back({ type, static_cast<unsigned int>(iterations) });
+    }
+  }
+
+  std::printf("%u bridges with %u bodies each, %u frames\n", NUMBER_OF_BRIDGES, NUMBER_OF_BRIDGE_POINTS * 4 + 1, numFrames);
+  std::printf("solver          iterations  contacts/frame  iterations/frame  contact updates/frame  ms/frame  mean max error\n");
+
+  /* cheapest configuration of every solver reaching the target error */
+  std::array<float, 3> bestTimes = { -1.0f, -1.0f, -1.0f };
+  std::array<unsigned int, 3> bestIterations = { 0, 0, 0 };
+
+  for (const auto& config : configs) {
+    BenchmarkResult result = runBenchmark(config, NUMBER_OF_BRIDGE_POINTS, NUMBER_OF_BRIDGES, numFrames, numWarmupFrames);
+    float frameTime = result.solverTime / numFrames;
+    double error = result.error / numFrames;
+
+    std::printf("%-14s  %10u  %14.1f  %16.1f  %21.1f  %8.3f  %14.5f\n", getSolverName(config.type),
+      config.iterations, static_cast<double>(result.contacts) / numFrames,
+      static_cast<double>(result.iterations) / numFrames, static_cast<double>(result.contactUpdates) / numFrames,
+      frameTime, error);
+
+    unsigned int typeIndex = static_cast<unsigned int>(config.type);
+    if (error <= targetError && (bestTimes.at(typeIndex) < 0.0f || frameTime < bestTimes.at(typeIndex))) {
+      bestTimes.at(typeIndex) = frameTime;
+      bestIterations.at(typeIndex) = config.iterations;
+    }
+  }
+
+  std::printf("\ncheapest configuration with a mean max error below %.3f\n", targetError);
+  for (const auto type : { solverType::priorityQueue, solverType::sequentialImpulse, solverType::sequentialImpulseWarm }) {
+    unsigned int typeIndex = static_cast<unsigned int>(type);
+    if (bestTimes.at(typeIndex) < 0.0f) {
+      std::printf("%-14s  not reached\n", getSolverName(type));
+    } else {
+      std::printf("%-14s  %u iterations, %.3f ms/frame\n", getSolverName(type), bestIterations.at(typeIndex),
+        bestTimes.at(typeIndex));
+    }
+  }
+
+  return 0;
+}
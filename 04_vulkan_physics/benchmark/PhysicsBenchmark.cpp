@@ -0,0 +1,259 @@
+/* headless physics benchmark, steps a parameterized scene with a fixed time step
+ * the checksum over the final body state must be the same for every run of the same build and parameters */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <glm/glm.hpp>
+
+#include "RigidBody.h"
+#include "RigidBodyWorld.h"
+#include "ForceRegistry.h"
+#include "GravityForce.h"
+#include "WindForce.h"
+#include "DragForce.h"
+#include "Timer.h"
+#include "Logger.h"
+
+struct BenchmarkSettings {
+  unsigned int bsNumBridges = 4;
+  unsigned int bsNumPlanks = 5;
+  unsigned int bsNumFreeBodies = 100;
+  unsigned int bsNumFrames = 600;
+  float bsDeltaTime = 1.0f / 60.0f;
+  unsigned int bsNumThreads = 1;
+  contactSolver bsSolver = contactSolver::priorityQueue;
+  bool bsWindEnabled = true;
+  bool bsPositionBasedLinks = false;
+  unsigned int bsPositionBasedIterations = 4;
+};
+
+/* small deterministic generator, same scene on every platform */
+float nextRandom(unsigned int& seed) {
+  seed = seed * 1664525u + 1013904223u;
+  return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+}
+
+/* FNV-1a over the bit patterns, any difference in the state changes the checksum */
+void addToChecksum(uint64_t& checksum, const float* values, const unsigned int numValues) {
+  for (unsigned int i = 0; i < numValues; ++i) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &values[i], sizeof(bits));
+    for (int j = 0; j < 4; ++j) {
+      checksum ^= (bits >> (j * 8)) & 0xff;
+      checksum *= 0x100000001b3ull;
+    }
+  }
+}
+
+uint64_t calculateChecksum(const RigidBodyStorage& bodies) {
+  uint64_t checksum = 0xcbf29ce484222325ull;
+  for (int i = 0; i < bodies.size(); ++i) {
+    addToChecksum(checksum, &bodies.rbPositions[i].x, 3);
+    addToChecksum(checksum, &bodies.rbVelocities[i].x, 3);
+    addToChecksum(checksum, &bodies.rbOrientations[i].x, 4);
+  }
+  return checksum;
+}
+
+/* same bridge as in VkRenderer::init(), moved along the z axis */
+void addBridge(RigidBodyWorld& world, ForceRegistry& forceRegistry, const std::shared_ptr<IForceGenerator>& gravity,
+    const std::shared_ptr<IForceGenerator>& wind, const unsigned int bridgePoints, const float zOffset) {
+  unsigned int firstBody = world.getNumRigidBodies();
+
+  /* anchors */
+  float xPos = 2.0f;
+  for (unsigned int i = 0; i < bridgePoints * 2; ++i) {
+    std::shared_ptr<RigidBody> anchor = world.createRigidBody();
+    float zPos = 0.0f;
+    if (i % 2 == 0) {
+      xPos += 1.0f;
+      zPos = 1.0f;
+    }
+    anchor->setPosition(glm::vec3(xPos, 2.0f, zPos + zOffset));
+    anchor->setMass(-1.0f);
+    anchor->setLinearDaming(0.95f);
+  }
+
+  /* plank holders */
+  xPos = 2.0f;
+  for (unsigned int i = 0; i < bridgePoints * 2; ++i) {
+    std::shared_ptr<RigidBody> body = world.createRigidBody();
+    float zPos = 0.0f;
+    if (i % 2 == 0) {
+      xPos += 1.0f;
+      zPos = 1.0f;
+    }
+    body->setPosition(glm::vec3(xPos, 0.0f, zPos + zOffset));
+    body->setMass(1.0f);
+    body->setLinearDaming(0.95f);
+    body->setCollisionShape(collisionShape::sphere, glm::vec3(0.1f));
+
+    forceRegistry.addEntry(body, gravity);
+    forceRegistry.addEntry(body, wind);
+  }
+
+  for (unsigned int i = 0; i < bridgePoints * 2; ++i) {
+    world.addCableContact(world.getRigidBody(firstBody + i), world.getRigidBody(firstBody + i + bridgePoints * 2), 2.1f, 0.25f);
+  }
+
+  for (unsigned int i = bridgePoints * 2; i < bridgePoints * 4 - 2; ++i) {
+    world.addCableContact(world.getRigidBody(firstBody + i), world.getRigidBody(firstBody + i + 2), 0.75f, 0.1f);
+  }
+
+  for (unsigned int i = bridgePoints * 2; i < bridgePoints * 4; i += 2) {
+    world.addRodContact(world.getRigidBody(firstBody + i), world.getRigidBody(firstBody + i + 1), 0.75f);
+  }
+}
+
+/* spheres and boxes dropped onto the bridges, the ground plane catches the bodies falling beside them */
+void addFreeBodies(RigidBodyWorld& world, ForceRegistry& forceRegistry, const std::shared_ptr<IForceGenerator>& gravity,
+    const std::shared_ptr<IForceGenerator>& wind, const std::shared_ptr<IForceGenerator>& drag,
+    const BenchmarkSettings& settings) {
+  unsigned int seed = 42;
+  float width = static_cast<float>(settings.bsNumPlanks) + 1.0f;
+  float depth = static_cast<float>(settings.bsNumBridges) * 3.0f;
+
+  for (unsigned int i = 0; i < settings.bsNumFreeBodies; ++i) {
+    std::shared_ptr<RigidBody> body = world.createRigidBody();
+    body->setPosition(glm::vec3(2.5f + nextRandom(seed) * width, 3.0f + nextRandom(seed) * 5.0f, nextRandom(seed) * depth));
+    body->setMass(1.0f);
+    body->setLinearDaming(0.95f);
+    body->setAngularDamping(0.95f);
+
+    if (i % 4 == 0) {
+      body->setCollisionShape(collisionShape::box, glm::vec3(0.2f));
+    } else {
+      body->setCollisionShape(collisionShape::sphere, glm::vec3(0.25f));
+    }
+
+    forceRegistry.addEntry(body, gravity);
+    forceRegistry.addEntry(body, wind);
+    forceRegistry.addEntry(body, drag);
+  }
+}
+
+bool parseArguments(int argc, char *argv[], BenchmarkSettings& settings) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--no-wind") {
+      settings.bsWindEnabled = false;
+      continue;
+    }
+    if (arg == "--xpbd") {
+      settings.bsPositionBasedLinks = true;
+      continue;
+    }
+
+    if (i + 1 >= argc) {
+      Logger::log(1, "%s error: missing value for argument '%s'\n", __FUNCTION__, arg.c_str());
+      return false;
+    }
+    std::string value = argv[++i];
+
+    if (arg == "--bridges") {
+      settings.bsNumBridges = std::atoi(value.c_str());
+    } else if (arg == "--planks") {
+      settings.bsNumPlanks = std::atoi(value.c_str());
+    } else if (arg == "--bodies") {
+      settings.bsNumFreeBodies = std::atoi(value.c_str());
+    } else if (arg == "--frames") {
+      settings.bsNumFrames = std::atoi(value.c_str());
+    } else if (arg == "--dt") {
+      settings.bsDeltaTime = std::atof(value.c_str());
+    } else if (arg == "--threads") {
+      settings.bsNumThreads = std::atoi(value.c_str());
+    } else if (arg == "--xpbd-iterations") {
+      settings.bsPositionBasedIterations = std::atoi(value.c_str());
+    } else if (arg == "--solver") {
+      if (value == "queue") {
+        settings.bsSolver = contactSolver::priorityQueue;
+      } else if (value == "impulse") {
+        settings.bsSolver = contactSolver::sequentialImpulse;
+      } else {
+        Logger::log(1, "%s error: unknown solver '%s'\n", __FUNCTION__, value.c_str());
+        return false;
+      }
+    } else {
+      Logger::log(1, "%s error: unknown argument '%s'\n", __FUNCTION__, arg.c_str());
+      return false;
+    }
+  }
+
+  if (settings.bsNumPlanks < 2 || settings.bsNumFrames == 0 || settings.bsDeltaTime <= 0.0f) {
+    Logger::log(1, "%s error: need at least 2 planks, one frame and a positive time step\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  BenchmarkSettings settings;
+  if (!parseArguments(argc, argv, settings)) {
+    std::printf("usage: %s [--bridges n] [--planks m] [--bodies k] [--frames f] [--dt seconds] [--threads t] "
+      "[--solver queue|impulse] [--xpbd] [--xpbd-iterations n] [--no-wind]\n", argv[0]);
+    return -1;
+  }
+
+  /* silence the setup messages */
+  Logger::setLogLevel(0);
+
+  /* same contact limit per bridge as the renderer, plus room for the collisions */
+  unsigned int maxContacts = settings.bsNumBridges * settings.bsNumPlanks * 10 + settings.bsNumFreeBodies * 6;
+  RigidBodyWorld world(maxContacts);
+  world.setNumResolverThreads(settings.bsNumThreads);
+  world.setContactSolver(settings.bsSolver);
+  world.setPositionBasedLinks(settings.bsPositionBasedLinks);
+  world.setPositionBasedIterations(settings.bsPositionBasedIterations);
+  world.addCollisionPlane(glm::vec3(0.0f, 1.0f, 0.0f), -5.0f);
+
+  ForceRegistry forceRegistry(world.getRigidBodyStorage());
+  std::shared_ptr<GravityForce> gravity = std::make_shared<GravityForce>(glm::vec3(0.0f, -10.0f, 0.0f));
+  std::shared_ptr<WindForce> wind = std::make_shared<WindForce>(glm::vec3(4.0f, 0.0f, 4.0f));
+  wind->enable(settings.bsWindEnabled);
+  std::shared_ptr<DragForce> drag = std::make_shared<DragForce>(0.25f, 0.01f);
+
+  for (unsigned int i = 0; i < settings.bsNumBridges; ++i) {
+    addBridge(world, forceRegistry, gravity, wind, settings.bsNumPlanks, i * 3.0f);
+  }
+  addFreeBodies(world, forceRegistry, gravity, wind, drag, settings);
+
+  unsigned long long numContacts = 0;
+  unsigned long long numIterations = 0;
+  unsigned long long numPairs = 0;
+
+  Timer stepTimer;
+  stepTimer.start();
+  for (unsigned int frame = 0; frame < settings.bsNumFrames; ++frame) {
+    world.startFrame();
+    forceRegistry.updateForces(settings.bsDeltaTime);
+    world.runPhysics(settings.bsDeltaTime);
+
+    numContacts += world.getNumContacts();
+    numIterations += world.getNumResolverIterations();
+    numPairs += world.getNumCollisionPairs();
+  }
+  float stepTime = stepTimer.stop();
+
+  std::printf("scene:                 %u bridges x %u planks, %u free bodies, %u bodies total\n", settings.bsNumBridges,
+    settings.bsNumPlanks, settings.bsNumFreeBodies, world.getNumRigidBodies());
+  std::printf("run:                   %u frames, dt %f, %s solver, %u threads, wind %s\n", settings.bsNumFrames,
+    settings.bsDeltaTime, settings.bsSolver == contactSolver::priorityQueue ? "queue" : "impulse",
+    settings.bsNumThreads, settings.bsWindEnabled ? "on" : "off");
+  if (settings.bsPositionBasedLinks) {
+    std::printf("links:                 position based, %u iterations\n", settings.bsPositionBasedIterations);
+  }
+  std::printf("steps/sec:             %.1f\n", stepTime > 0.0f ? settings.bsNumFrames * 1000.0f / stepTime : 0.0f);
+  std::printf("ms/step:               %.3f\n", stepTime / settings.bsNumFrames);
+  std::printf("contacts/frame:        %.1f\n", static_cast<double>(numContacts) / settings.bsNumFrames);
+  std::printf("iterations/frame:      %.1f\n", static_cast<double>(numIterations) / settings.bsNumFrames);
+  std::printf("collision pairs/frame: %.1f\n", static_cast<double>(numPairs) / settings.bsNumFrames);
+  std::printf("awake bodies at end:   %u\n", world.getNumAwakeBodies());
+  std::printf("checksum:              %016llx\n", static_cast<unsigned long long>(calculateChecksum(*world.getRigidBodyStorage())));
+
+  return 0;
+}
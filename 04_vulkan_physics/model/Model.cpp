@@ -25,6 +25,14 @@ glm::quat Model::getOrientation() const {
   return mRigidBody->getOrientation();
 }
 
+glm::vec3 Model::getInterpolatedPosition(const float alpha) const {
+  return mRigidBody->getInterpolatedPosition(alpha);
+}
+
+glm::quat Model::getInterpolatedOrientation(const float alpha) const {
+  return mRigidBody->getInterpolatedOrientation(alpha);
+}
+
 
 void Model::setPhysicsEnabled(const bool value) {
   mPhysicsEnabled = value;
@@ -21,6 +21,9 @@ class Model {
     void setPosition(const glm::vec3 pos);
 
     glm::quat getOrientation() const;
+
+    glm::vec3 getInterpolatedPosition(const float alpha) const;
+    glm::quat getInterpolatedOrientation(const float alpha) const;
     void setOrientation(const glm::quat orient);
 
     void setMass(const float mass);
@@ -8,7 +8,7 @@ class AnchoredBungeeForce : public IForceGenerator {
   public:
     AnchoredBungeeForce(const glm::vec3 anchor, const float springConstant, const float restLength);
 
-    virtual void updateForce(std::shared_ptr<RigidBody> body, float deltaTime) override;
+    virtual void updateForces(RigidBodyStorage& bodies, const int firstBody, const int numBodies, const float deltaTime) override;
 
   private:
     glm::vec3 mSpringAnchor = glm::vec3(0.0f);
@@ -1,9 +1,16 @@
 #include "BodyContact.h"
 #include "Logger.h"
 
-void BodyContact::resolveContact(const float deltaTime) {
-  resolveVelocity(deltaTime);
-  resolveInterPenetration(deltaTime);
+void BodyContact::resolveContact(RigidBodyStorage& bodies, const float deltaTime) {
+  /* a contact with an awake body wakes up the other body */
+  for (const auto body : mBodies) {
+    if (body >= 0 && !bodies.hasInfiniteMass(body)) {
+      bodies.setAwake(body, true);
+    }
+  }
+
+  resolveVelocity(bodies, deltaTime);
+  resolveInterPenetration(bodies, deltaTime);
 }
 
 float BodyContact::getInterPenetration() const {
@@ -42,54 +49,55 @@ glm::vec3 BodyContact::getContactPoint() const {
   return mContactPoint;
 }
 
-std::shared_ptr<RigidBody> BodyContact::getBody(const unsigned int index) const {
-  if (index > mBodies.size()) {
-    Logger::log(1, "%s error: tried to access beyound the body array size\n", __FUNCTION__);
-    return nullptr;
-  }
+void BodyContact::setSourceKey(const contactSource source, const unsigned int firstIndex, const unsigned int secondIndex) {
+  /* 8 bits source, 28 bits per index */
+  mSourceKey = static_cast<uint64_t>(source) << 56 |
+    static_cast<uint64_t>(firstIndex & 0xfffffff) << 28 |
+    static_cast<uint64_t>(secondIndex & 0xfffffff);
+}
+
+uint64_t BodyContact::getSourceKey() const {
+  return mSourceKey;
+}
 
-  if (!mBodies.at(index)) {
-    Logger::log(1, "%s error: no body at index %i\n", __FUNCTION__, index);
-    return nullptr;
+int BodyContact::getBody(const unsigned int index) const {
+  if (index >= mBodies.size()) {
+    Logger::log(1, "%s error: tried to access beyound the body array size\n", __FUNCTION__);
+    return -1;
   }
 
   return mBodies.at(index);
 }
 
-void BodyContact::setBody(const unsigned int index, const std::shared_ptr<RigidBody> body) {
-  if (index > mBodies.size()) {
+void BodyContact::setBody(const unsigned int index, const int bodyHandle) {
+  if (index >= mBodies.size()) {
     Logger::log(1, "%s error: tried to access beyound the body array size\n", __FUNCTION__);
     return;
   }
 
-  if (!body) {
-    Logger::log(1, "%s error: no body given\n", __FUNCTION__);
-    return;
-  }
-
-  mBodies.at(index) = body;
+  mBodies.at(index) = bodyHandle;
 }
 
-float BodyContact::calculateSeparatingVelocity() const {
-  if (!mBodies.at(0)) {
+float BodyContact::calculateSeparatingVelocity(const RigidBodyStorage& bodies) const {
+  if (mBodies[0] < 0) {
     Logger::log(1, "%s error: no first rigid body\n", __FUNCTION__);
     return 0.0f;
   }
 
-  glm::vec3 relativeVelocity = mBodies.at(0)->getVelocity();
-  if (mBodies.at(1)) {
-    relativeVelocity -= mBodies.at(1)->getVelocity();
+  glm::vec3 relativeVelocity = bodies.rbVelocities[mBodies[0]];
+  if (mBodies[1] >= 0) {
+    relativeVelocity -= bodies.rbVelocities[mBodies[1]];
   }
   return glm::dot(relativeVelocity, mContactNormal);
 }
 
-void BodyContact::resolveVelocity(const float deltaTime) {
-  if (!mBodies.at(0)) {
+void BodyContact::resolveVelocity(RigidBodyStorage& bodies, const float deltaTime) {
+  if (mBodies[0] < 0) {
     Logger::log(1, "%s error: no first rigid body\n", __FUNCTION__);
     return;
   }
 
-  float separatingVelocity = calculateSeparatingVelocity();
+  float separatingVelocity = calculateSeparatingVelocity(bodies);
 
   /* stationary or separating */
   if (separatingVelocity > 0) {
@@ -99,9 +107,9 @@ void BodyContact::resolveVelocity(const float deltaTime) {
   float newSeparationVelocity = -separatingVelocity * mRestitutionCoefficient;
 
   /* check accumulated velocity buildup due to accelration in direction of the contact normal (i.e., sliding on ground) */
-  glm::vec3 accumulatedVelocity = mBodies.at(0)->getAcceleration();
-  if (mBodies.at(1)) {
-    accumulatedVelocity -= mBodies.at(1)->getAcceleration();
+  glm::vec3 accumulatedVelocity = bodies.rbAccelerations[mBodies[0]];
+  if (mBodies[1] >= 0) {
+    accumulatedVelocity -= bodies.rbAccelerations[mBodies[1]];
   }
 
   float accumulatedSeparationVelocity = glm::dot(accumulatedVelocity, mContactNormal) * deltaTime;
@@ -118,9 +126,9 @@ void BodyContact::resolveVelocity(const float deltaTime) {
   float deltaVelocity = newSeparationVelocity - separatingVelocity;
 
   /* get total inverse mass to distribute the velocity update proportional */
-  float totalInverseMass = mBodies.at(0)->getInverseMass();
-  if (mBodies.at(1)) {
-    totalInverseMass += mBodies.at(1)->getInverseMass();
+  float totalInverseMass = bodies.rbInverseMasses[mBodies[0]];
+  if (mBodies[1] >= 0) {
+    totalInverseMass += bodies.rbInverseMasses[mBodies[1]];
   }
 
   /* infinite masses, do nothing */
@@ -132,31 +140,34 @@ void BodyContact::resolveVelocity(const float deltaTime) {
   float impulse = deltaVelocity / totalInverseMass;
   glm::vec3 impulsePerInverseMass = mContactNormal * impulse;
 
-  /* set velocity in direction of contact, proportional to the masses */
-  mBodies.at(0)->setVelocity(mBodies.at(0)->getVelocity() + impulsePerInverseMass * mBodies.at(0)->getInverseMass());
+  /* set velocity in direction of contact, proportional to the masses
+   * bodies with infinite mass are not written, they may be shared with contacts resolved on other threads */
+  if (bodies.rbInverseMasses[mBodies[0]] > 0.0f) {
+    bodies.rbVelocities[mBodies[0]] += impulsePerInverseMass * bodies.rbInverseMasses[mBodies[0]];
+  }
 
   /* the opposite body gets a negative velocity */
-  if (mBodies.at(1)) {
-    mBodies.at(1)->setVelocity(mBodies.at(1)->getVelocity() + impulsePerInverseMass * -mBodies.at(1)->getInverseMass());
+  if (mBodies[1] >= 0 && bodies.rbInverseMasses[mBodies[1]] > 0.0f) {
+    bodies.rbVelocities[mBodies[1]] += impulsePerInverseMass * -bodies.rbInverseMasses[mBodies[1]];
   }
 }
 
-void BodyContact::resolveInterPenetration(float deltaTime) {
+void BodyContact::resolveInterPenetration(RigidBodyStorage& bodies, float deltaTime) {
   /* nothing to do */
   if (mInterPenetration <= 0.0f) {
     Logger::log(2, "%s: no interpenetration, do nothing\n", __FUNCTION__);
     return;
   }
 
-  if (!mBodies.at(0)) {
+  if (mBodies[0] < 0) {
     Logger::log(1, "%s error: no first rigid body\n", __FUNCTION__);
     return;
   }
 
   /* get total inverse mass to distribute the velocity update proportional */
-  float totalInverseMass = mBodies.at(0)->getInverseMass();
-  if (mBodies.at(1)) {
-    totalInverseMass += mBodies.at(1)->getInverseMass();
+  float totalInverseMass = bodies.rbInverseMasses[mBodies[0]];
+  if (mBodies[1] >= 0) {
+    totalInverseMass += bodies.rbInverseMasses[mBodies[1]];
   }
 
   /* infinite masses, do nothing */
@@ -166,18 +177,20 @@ void BodyContact::resolveInterPenetration(float deltaTime) {
 
   glm::vec3 movePerInverseMass = mContactNormal * (mInterPenetration / totalInverseMass);
   /* calculate the movement needed to separate the bodies */
-  mBodyMovement.at(0) = movePerInverseMass * mBodies.at(0)->getInverseMass();
-  if (mBodies.at(1)) {
-    mBodyMovement.at(1) = movePerInverseMass * -mBodies.at(1)->getInverseMass();
+  mBodyMovement.at(0) = movePerInverseMass * bodies.rbInverseMasses[mBodies[0]];
+  if (mBodies[1] >= 0) {
+    mBodyMovement.at(1) = movePerInverseMass * -bodies.rbInverseMasses[mBodies[1]];
   } else {
     mBodyMovement.at(1) = glm::vec3(0.0f);
   }
 
   /* apply inter-penetration resolution */
-  mBodies.at(0)->setPosition(mBodies.at(0)->getPosition() + mBodyMovement.at(0));
+  if (bodies.rbInverseMasses[mBodies[0]] > 0.0f) {
+    bodies.rbPositions[mBodies[0]] += mBodyMovement.at(0);
+  }
 
-  if (mBodies.at(1)) {
-    mBodies.at(1)->setPosition(mBodies.at(1)->getPosition() + mBodyMovement.at(1));
+  if (mBodies[1] >= 0 && bodies.rbInverseMasses[mBodies[1]] > 0.0f) {
+    bodies.rbPositions[mBodies[1]] += mBodyMovement.at(1);
   }
 }
 
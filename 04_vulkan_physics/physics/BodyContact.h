@@ -2,25 +2,36 @@
 
 #include <memory>
 #include <array>
+#include <cstdint>
 #include <glm/glm.hpp>
 
-#include "RigidBody.h"
+#include "RigidBodyStorage.h"
+
+/* what created a contact, part of the key to find the same contact again in the next frame */
+enum class contactSource : uint8_t {
+  none = 0,
+  cable,
+  rod,
+  plane,
+  collision
+};
 
 class BodyContact {
   public:
-    void resolveContact(const float deltaTime);
-    float calculateSeparatingVelocity() const;
+    void resolveContact(RigidBodyStorage& bodies, const float deltaTime);
+    float calculateSeparatingVelocity(const RigidBodyStorage& bodies) const;
 
     float getInterPenetration() const;
     void setInterPenetration(const float value);
 
-    void resolveInterPenetration(float deltaTime);
+    void resolveInterPenetration(RigidBodyStorage& bodies, float deltaTime);
 
     float getRestitutionCoeff() const;
     void setRestiutionCoeff(const float value);
 
-    std::shared_ptr<RigidBody> getBody(const unsigned int index) const;
-    void setBody(const unsigned int index, const std::shared_ptr<RigidBody> body);
+    /* bodies are referenced by their handle in the storage, -1 means no body */
+    int getBody(const unsigned int index) const;
+    void setBody(const unsigned int index, const int bodyHandle);
 
     std::array<glm::vec3, 2> getBodyMovements() const;
 
@@ -30,10 +41,14 @@ class BodyContact {
     void setContactPoint(const glm::vec3 point);
     glm::vec3 getContactPoint() const;
 
+    /* stable over frames, i.e. source cable plus the cable index, or a collision plus both body handles */
+    void setSourceKey(const contactSource source, const unsigned int firstIndex, const unsigned int secondIndex);
+    uint64_t getSourceKey() const;
+
   private:
-    void resolveVelocity(const float deltaTime);
+    void resolveVelocity(RigidBodyStorage& bodies, const float deltaTime);
 
-    std::array<std::shared_ptr<RigidBody>, 2> mBodies {};
+    std::array<int, 2> mBodies { -1, -1 };
     std::array<glm::vec3, 2> mBodyMovement{};
 
     /* bouncy-ness */
@@ -45,4 +60,6 @@ class BodyContact {
     glm::vec3 mContactNormal = glm::vec3(0.0f);
     /* amount of penetration between the two bodies */
     float mInterPenetration = 0;
+
+    uint64_t mSourceKey = 0;
 };
@@ -0,0 +1,121 @@
+#include "BodyIntegrator.h"
+
+#include <cmath>
+
+#include "Logger.h"
+
+unsigned int BodyIntegrator::integrate(RigidBodyStorage& bodies, const float deltaTime) {
+  if (deltaTime <= 0.0f) {
+    Logger::log(1, "%s error: deltaTime must be greater than zero\n", __FUNCTION__);
+    return 0;
+  }
+
+  updateDampingFactors(bodies, deltaTime);
+
+  /* infinite mass or sleeping bodies are not touched */
+  mActiveBodies.clear();
+  for (int i = 0; i < bodies.size(); ++i) {
+    if (bodies.isActive(i)) {
+      mActiveBodies.emplace_back(i);
+    }
+  }
+
+  const unsigned int numBodies = mActiveBodies.size();
+  for (unsigned int i = 0; i < numBodies; i += GROUP_SIZE) {
+    unsigned int numLanes = numBodies - i < GROUP_SIZE ? numBodies - i : GROUP_SIZE;
+    integrateGroup(bodies, i, numLanes, deltaTime);
+  }
+
+  return numBodies;
+}
+
+void BodyIntegrator::updateDampingFactors(const RigidBodyStorage& bodies, const float deltaTime) {
+  const int numBodies = bodies.size();
+
+  /* a new time step invalidates all factors, new bodies get their factors below */
+  if (deltaTime != mDampingDeltaTime) {
+    mLinearDampings.clear();
+    mAngularDampings.clear();
+    mLinearDampingFactors.clear();
+    mAngularDampingFactors.clear();
+    mDampingDeltaTime = deltaTime;
+  }
+
+  const int numCachedBodies = mLinearDampings.size();
+  mLinearDampings.resize(numBodies);
+  mAngularDampings.resize(numBodies);
+  mLinearDampingFactors.resize(numBodies);
+  mAngularDampingFactors.resize(numBodies);
+
+  for (int i = 0; i < numBodies; ++i) {
+    if (i >= numCachedBodies || bodies.rbLinearDampings[i] != mLinearDampings[i]) {
+      mLinearDampings[i] = bodies.rbLinearDampings[i];
+      mLinearDampingFactors[i] = std::pow(mLinearDampings[i], deltaTime);
+    }
+    if (i >= numCachedBodies || bodies.rbAngularDampings[i] != mAngularDampings[i]) {
+      mAngularDampings[i] = bodies.rbAngularDampings[i];
+      mAngularDampingFactors[i] = std::pow(mAngularDampings[i], deltaTime);
+    }
+  }
+}
+
+void BodyIntegrator::integrateGroup(RigidBodyStorage& bodies, const unsigned int firstIndex,
+    const unsigned int numLanes, const float deltaTime) {
+  /* one lane per body, unused lanes stay zero */
+  float linearAcceleration[3][GROUP_SIZE] = {};
+  float velocity[3][GROUP_SIZE] = {};
+  float position[3][GROUP_SIZE] = {};
+  float torque[3][GROUP_SIZE] = {};
+  float tensor[3][3][GROUP_SIZE] = {};
+  float rotation[3][GROUP_SIZE] = {};
+  float linearFactor[GROUP_SIZE] = {};
+  float angularFactor[GROUP_SIZE] = {};
+
+  for (unsigned int lane = 0; lane < numLanes; ++lane) {
+    int body = mActiveBodies[firstIndex + lane];
+
+    glm::vec3 scaledAccumForce = bodies.rbAccumulatedForces[body] * bodies.rbInverseMasses[body];
+    glm::vec3 lastFrameAcceleration = bodies.rbAccelerations[body] + scaledAccumForce;
+    const glm::mat3& worldTensor = bodies.rbInverseInertiaTensorsWorldSpace[body];
+
+    for (int axis = 0; axis < 3; ++axis) {
+      linearAcceleration[axis][lane] = lastFrameAcceleration[axis];
+      velocity[axis][lane] = bodies.rbVelocities[body][axis];
+      position[axis][lane] = bodies.rbPositions[body][axis];
+      torque[axis][lane] = bodies.rbAccumulatedTorques[body][axis];
+      rotation[axis][lane] = bodies.rbRotations[body][axis];
+      for (int row = 0; row < 3; ++row) {
+        tensor[axis][row][lane] = worldTensor[axis][row];
+      }
+    }
+    linearFactor[lane] = mLinearDampingFactors[body];
+    angularFactor[lane] = mAngularDampingFactors[body];
+  }
+
+  /* same operations and order as RigidBodyStorage::integrate(), the torque is multiplied as row vector */
+  for (int axis = 0; axis < 3; ++axis) {
+    for (unsigned int lane = 0; lane < GROUP_SIZE; ++lane) {
+      velocity[axis][lane] += linearAcceleration[axis][lane] * deltaTime;
+      velocity[axis][lane] *= linearFactor[lane];
+      position[axis][lane] += velocity[axis][lane] * deltaTime;
+
+      float angularAcceleration = torque[0][lane] * tensor[axis][0][lane] + torque[1][lane] * tensor[axis][1][lane] +
+        torque[2][lane] * tensor[axis][2][lane];
+      rotation[axis][lane] += angularAcceleration * deltaTime;
+      rotation[axis][lane] *= angularFactor[lane];
+    }
+  }
+
+  for (unsigned int lane = 0; lane < numLanes; ++lane) {
+    int body = mActiveBodies[firstIndex + lane];
+
+    bodies.rbVelocities[body] = glm::vec3(velocity[0][lane], velocity[1][lane], velocity[2][lane]);
+    bodies.rbPositions[body] = glm::vec3(position[0][lane], position[1][lane], position[2][lane]);
+    bodies.rbRotations[body] = glm::vec3(rotation[0][lane], rotation[1][lane], rotation[2][lane]);
+
+    /* the quaternion update does not fit into lanes */
+    glm::vec3 scaledRotation = bodies.rbRotations[body] * deltaTime;
+    glm::quat rotationQuat = glm::normalize(glm::quat(1.0f, scaledRotation));
+    bodies.rbOrientations[body] *= rotationQuat;
+  }
+}
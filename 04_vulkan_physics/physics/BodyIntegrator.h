@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+#include "RigidBodyStorage.h"
+
+/* integrates all awake bodies of a storage in one pass
+ * the damping factors pow(damping, deltaTime) are only recalculated if the time step or the damping changes,
+ * and the bodies are processed in groups of GROUP_SIZE lanes, the fixed size inner loops map to SIMD registers.
+ * the result is the same as calling RigidBodyStorage::integrate() for every body */
+class BodyIntegrator {
+  public:
+    /* returns the number of integrated bodies */
+    unsigned int integrate(RigidBodyStorage& bodies, const float deltaTime);
+
+  private:
+    static constexpr unsigned int GROUP_SIZE = 4;
+
+    void updateDampingFactors(const RigidBodyStorage& bodies, const float deltaTime);
+    void integrateGroup(RigidBodyStorage& bodies, const unsigned int firstIndex, const unsigned int numLanes,
+      const float deltaTime);
+
+    /* damping values the factors were calculated from */
+    float mDampingDeltaTime = 0.0f;
+    std::vector<float> mLinearDampings{};
+    std::vector<float> mAngularDampings{};
+    std::vector<float> mLinearDampingFactors{};
+    std::vector<float> mAngularDampingFactors{};
+
+    /* handles of the awake bodies with finite mass, rebuilt in every step */
+    std::vector<int> mActiveBodies{};
+};
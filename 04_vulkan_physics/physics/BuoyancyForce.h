@@ -6,7 +6,7 @@ class BuoyancyForce : public IForceGenerator {
   public:
     BuoyancyForce(const float maxDepth, const float bodyVolume, const float waterHeight, const float liquidDensity = 1000.0f);
 
-    virtual void updateForce(std::shared_ptr<RigidBody> body, float deltaTime) override;
+    virtual void updateForces(RigidBodyStorage& bodies, const int firstBody, const int numBodies, const float deltaTime) override;
 
   private:
     /* TODO: make these two variables independent of the body */
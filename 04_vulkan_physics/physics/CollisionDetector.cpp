@@ -0,0 +1,199 @@
+#include "CollisionDetector.h"
+
+#include <cmath>
+#include <algorithm>
+
+void CollisionDetector::setRestitution(const float restitution) {
+  mRestitution = restitution;
+}
+
+unsigned int CollisionDetector::addPlaneContacts(const RigidBodyStorage& bodies, const std::vector<CollisionPlane>& planes,
+    BodyContact* contacts, const unsigned int contactLimit) const {
+  unsigned int numContacts = 0;
+
+  for (int i = 0; i < bodies.size() && numContacts < contactLimit; ++i) {
+    /* planes are static, so the body must be able to move */
+    if (!bodies.isActive(i)) {
+      continue;
+    }
+
+    for (unsigned int j = 0; j < planes.size(); ++j) {
+      if (numContacts == contactLimit) {
+        break;
+      }
+
+      bool hasContact = false;
+      switch (bodies.rbShapes[i]) {
+        case collisionShape::sphere:
+          hasContact = collideSpherePlane(bodies, i, planes[j], contacts[numContacts]);
+          break;
+        case collisionShape::box:
+          hasContact = collideBoxPlane(bodies, i, planes[j], contacts[numContacts]);
+          break;
+        default:
+          break;
+      }
+
+      if (hasContact) {
+        contacts[numContacts].setSourceKey(contactSource::plane, j, i);
+        ++numContacts;
+      }
+    }
+  }
+
+  return numContacts;
+}
+
+unsigned int CollisionDetector::addPairContacts(const RigidBodyStorage& bodies, const std::vector<std::array<int, 2>>& pairs,
+    BodyContact* contacts, const unsigned int contactLimit) const {
+  unsigned int numContacts = 0;
+
+  for (const auto& pair : pairs) {
+    if (numContacts == contactLimit) {
+      break;
+    }
+
+    collisionShape firstShape = bodies.rbShapes[pair[0]];
+    collisionShape secondShape = bodies.rbShapes[pair[1]];
+
+    bool hasContact = false;
+    if (firstShape == collisionShape::sphere && secondShape == collisionShape::sphere) {
+      hasContact = collideSphereSphere(bodies, pair[0], pair[1], contacts[numContacts]);
+    } else if (firstShape == collisionShape::sphere && secondShape == collisionShape::box) {
+      hasContact = collideSphereBox(bodies, pair[0], pair[1], contacts[numContacts]);
+    } else if (firstShape == collisionShape::box && secondShape == collisionShape::sphere) {
+      hasContact = collideSphereBox(bodies, pair[1], pair[0], contacts[numContacts]);
+    }
+
+    if (hasContact) {
+      contacts[numContacts].setSourceKey(contactSource::collision, std::min(pair[0], pair[1]), std::max(pair[0], pair[1]));
+      ++numContacts;
+    }
+  }
+
+  return numContacts;
+}
+
+bool CollisionDetector::collideSphereSphere(const RigidBodyStorage& bodies, const int firstSphere, const int secondSphere, BodyContact& contact) const {
+  glm::vec3 distance = bodies.rbPositions[firstSphere] - bodies.rbPositions[secondSphere];
+  float distanceLength = glm::length(distance);
+  float radiusSum = bodies.rbShapeSizes[firstSphere].x + bodies.rbShapeSizes[secondSphere].x;
+
+  if (distanceLength >= radiusSum) {
+    return false;
+  }
+
+  /* same center, no direction to separate, push upwards */
+  glm::vec3 contactNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+  if (distanceLength > 0.0f) {
+    contactNormal = distance / distanceLength;
+  }
+
+  contact.setBody(0, firstSphere);
+  contact.setBody(1, secondSphere);
+  contact.setContactNormal(contactNormal);
+  contact.setContactPoint(bodies.rbPositions[secondSphere] + contactNormal * bodies.rbShapeSizes[secondSphere].x);
+  contact.setInterPenetration(radiusSum - distanceLength);
+  contact.setRestiutionCoeff(mRestitution);
+  return true;
+}
+
+bool CollisionDetector::collideSphereBox(const RigidBodyStorage& bodies, const int sphere, const int box, BodyContact& contact) const {
+  glm::vec3 center = bodies.rbPositions[sphere];
+  float radius = bodies.rbShapeSizes[sphere].x;
+  glm::vec3 halfSize = bodies.rbShapeSizes[box];
+  glm::quat boxOrientation = bodies.rbOrientations[box];
+
+  /* sphere center in box coordinates */
+  glm::vec3 localCenter = glm::conjugate(boxOrientation) * (center - bodies.rbPositions[box]);
+  glm::vec3 closestLocalPoint = glm::clamp(localCenter, -halfSize, halfSize);
+
+  glm::vec3 contactNormal;
+  float penetration;
+
+  if (closestLocalPoint != localCenter) {
+    glm::vec3 closestPoint = bodies.rbPositions[box] + boxOrientation * closestLocalPoint;
+    glm::vec3 distance = center - closestPoint;
+    float distanceLength = glm::length(distance);
+    if (distanceLength >= radius) {
+      return false;
+    }
+
+    contactNormal = distance / distanceLength;
+    penetration = radius - distanceLength;
+    contact.setContactPoint(closestPoint);
+  } else {
+    /* center inside the box, push out through the nearest face */
+    glm::vec3 faceDistances = halfSize - glm::abs(localCenter);
+    int axis = 0;
+    if (faceDistances.y < faceDistances[axis]) {
+      axis = 1;
+    }
+    if (faceDistances.z < faceDistances[axis]) {
+      axis = 2;
+    }
+
+    glm::vec3 localNormal = glm::vec3(0.0f);
+    localNormal[axis] = localCenter[axis] < 0.0f ? -1.0f : 1.0f;
+    contactNormal = boxOrientation * localNormal;
+    penetration = radius + faceDistances[axis];
+    contact.setContactPoint(center);
+  }
+
+  contact.setBody(0, sphere);
+  contact.setBody(1, box);
+  contact.setContactNormal(contactNormal);
+  contact.setInterPenetration(penetration);
+  contact.setRestiutionCoeff(mRestitution);
+  return true;
+}
+
+bool CollisionDetector::collideSpherePlane(const RigidBodyStorage& bodies, const int sphere, const CollisionPlane& plane, BodyContact& contact) const {
+  float radius = bodies.rbShapeSizes[sphere].x;
+  float distance = glm::dot(bodies.rbPositions[sphere], plane.cpNormal) - plane.cpOffset - radius;
+
+  if (distance >= 0.0f) {
+    return false;
+  }
+
+  contact.setBody(0, sphere);
+  contact.setBody(1, -1);
+  contact.setContactNormal(plane.cpNormal);
+  contact.setContactPoint(bodies.rbPositions[sphere] - plane.cpNormal * (radius + distance));
+  contact.setInterPenetration(-distance);
+  contact.setRestiutionCoeff(mRestitution);
+  return true;
+}
+
+bool CollisionDetector::collideBoxPlane(const RigidBodyStorage& bodies, const int box, const CollisionPlane& plane, BodyContact& contact) const {
+  glm::vec3 halfSize = bodies.rbShapeSizes[box];
+
+  /* the resolver only moves the body along the normal, so the deepest corner is enough */
+  float minDistance = 0.0f;
+  glm::vec3 deepestVertex = glm::vec3(0.0f);
+  for (int i = 0; i < 8; ++i) {
+    glm::vec3 localVertex = glm::vec3(
+      (i & 1) ? halfSize.x : -halfSize.x,
+      (i & 2) ? halfSize.y : -halfSize.y,
+      (i & 4) ? halfSize.z : -halfSize.z);
+    glm::vec3 vertex = bodies.rbPositions[box] + bodies.rbOrientations[box] * localVertex;
+
+    float distance = glm::dot(vertex, plane.cpNormal) - plane.cpOffset;
+    if (distance < minDistance) {
+      minDistance = distance;
+      deepestVertex = vertex;
+    }
+  }
+
+  if (minDistance >= 0.0f) {
+    return false;
+  }
+
+  contact.setBody(0, box);
+  contact.setBody(1, -1);
+  contact.setContactNormal(plane.cpNormal);
+  contact.setContactPoint(deepestVertex);
+  contact.setInterPenetration(-minDistance);
+  contact.setRestiutionCoeff(mRestitution);
+  return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "BodyContact.h"
+#include "RigidBodyStorage.h"
+
+/* infinite static plane, all points p with dot(p, cpNormal) == cpOffset. the normal points to the free side */
+struct CollisionPlane {
+  glm::vec3 cpNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+  float cpOffset = 0.0f;
+};
+
+/* narrowphase, creates contacts between the collision shapes of the bodies */
+class CollisionDetector {
+  public:
+    void setRestitution(const float restitution);
+
+    /* all awake bodies with a shape against all planes */
+    unsigned int addPlaneContacts(const RigidBodyStorage& bodies, const std::vector<CollisionPlane>& planes,
+      BodyContact* contacts, const unsigned int contactLimit) const;
+    /* candidate pairs found by the broadphase, box-box pairs are not supported yet */
+    unsigned int addPairContacts(const RigidBodyStorage& bodies, const std::vector<std::array<int, 2>>& pairs,
+      BodyContact* contacts, const unsigned int contactLimit) const;
+
+  private:
+    bool collideSphereSphere(const RigidBodyStorage& bodies, const int firstSphere, const int secondSphere, BodyContact& contact) const;
+    bool collideSphereBox(const RigidBodyStorage& bodies, const int sphere, const int box, BodyContact& contact) const;
+    bool collideSpherePlane(const RigidBodyStorage& bodies, const int sphere, const CollisionPlane& plane, BodyContact& contact) const;
+    bool collideBoxPlane(const RigidBodyStorage& bodies, const int box, const CollisionPlane& plane, BodyContact& contact) const;
+
+    /* "bouncy-ness" of all collision contacts */
+    float mRestitution = 0.4f;
+};
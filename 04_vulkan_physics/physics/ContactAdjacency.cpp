@@ -0,0 +1,45 @@
+#include "ContactAdjacency.h"
+
+void ContactAdjacency::build(const int numBodies, const std::vector<BodyContact>& contacts, const unsigned int numContacts) {
+  mOffsets.assign(numBodies + 1, 0);
+
+  /* count contacts per body, shifted by one to get the offsets afterwards */
+  for (unsigned int i = 0; i < numContacts; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      int body = contacts.at(i).getBody(j);
+      if (body >= 0) {
+        ++mOffsets.at(body + 1);
+      }
+    }
+  }
+
+  for (int i = 0; i < numBodies; ++i) {
+    mOffsets.at(i + 1) += mOffsets.at(i);
+  }
+
+  /* fill in the contact indices, ascending per body */
+  mContactIndices.resize(mOffsets.back());
+  mFillPositions.assign(mOffsets.begin(), mOffsets.end() - 1);
+  for (unsigned int i = 0; i < numContacts; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      int body = contacts.at(i).getBody(j);
+      if (body >= 0) {
+        mContactIndices.at(mFillPositions.at(body)++) = i;
+      }
+    }
+  }
+}
+
+unsigned int ContactAdjacency::getNumContacts(const int bodyHandle) const {
+  if (bodyHandle < 0 || bodyHandle + 1 >= static_cast<int>(mOffsets.size())) {
+    return 0;
+  }
+  return mOffsets[bodyHandle + 1] - mOffsets[bodyHandle];
+}
+
+const unsigned int* ContactAdjacency::getContacts(const int bodyHandle) const {
+  if (getNumContacts(bodyHandle) == 0) {
+    return nullptr;
+  }
+  return mContactIndices.data() + mOffsets[bodyHandle];
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+#include "BodyContact.h"
+
+/* per-frame list of the contacts touching each body, stored as one flat array
+ * the contacts of body n are at mContactIndices[mOffsets[n]] to mContactIndices[mOffsets[n + 1] - 1] */
+class ContactAdjacency {
+  public:
+    void build(const int numBodies, const std::vector<BodyContact>& contacts, const unsigned int numContacts);
+
+    unsigned int getNumContacts(const int bodyHandle) const;
+    const unsigned int* getContacts(const int bodyHandle) const;
+
+  private:
+    std::vector<unsigned int> mOffsets{};
+    std::vector<unsigned int> mContactIndices{};
+    /* next free slot per body while building, kept to avoid allocations */
+    std::vector<unsigned int> mFillPositions{};
+};
@@ -0,0 +1,60 @@
+#include "ContactCableBatch.h"
+
+void ContactCableBatch::addCable(const int firstBody, const int secondBody, const float maxLength, const float restitution,
+    const float compliance) {
+  mFirstBodies.emplace_back(firstBody);
+  mSecondBodies.emplace_back(secondBody);
+  mMaxCableLengths.emplace_back(maxLength);
+  mCableRestitutions.emplace_back(restitution);
+  mCableCompliances.emplace_back(compliance);
+}
+
+unsigned int ContactCableBatch::size() const {
+  return mFirstBodies.size();
+}
+
+void ContactCableBatch::getLinks(std::vector<std::array<int, 2>>& links) const {
+  for (unsigned int i = 0; i < mFirstBodies.size(); ++i) {
+    links.push_back({ mFirstBodies[i], mSecondBodies[i] });
+  }
+}
+
+void ContactCableBatch::addDistanceConstraints(DistanceConstraintSolver& solver) const {
+  for (unsigned int i = 0; i < mFirstBodies.size(); ++i) {
+    solver.addConstraint(mFirstBodies[i], mSecondBodies[i], mMaxCableLengths[i], mCableCompliances[i], true);
+  }
+}
+
+unsigned int ContactCableBatch::addContacts(const RigidBodyStorage& bodies, BodyContact* contacts, const unsigned int contactLimit) const {
+  unsigned int numContacts = 0;
+  const unsigned int numCables = mFirstBodies.size();
+
+  for (unsigned int i = 0; i < numCables && numContacts < contactLimit; ++i) {
+    /* both ends sleeping or static, nothing can move */
+    if (!bodies.isActive(mFirstBodies[i]) && !bodies.isActive(mSecondBodies[i])) {
+      continue;
+    }
+
+    glm::vec3 distance = bodies.rbPositions[mSecondBodies[i]] - bodies.rbPositions[mFirstBodies[i]];
+    float currentCableLength = glm::length(distance);
+
+    /* below max length, do nothing */
+    if (currentCableLength < mMaxCableLengths[i]) {
+      continue;
+    }
+
+    BodyContact& contact = contacts[numContacts];
+    contact.setBody(0, mFirstBodies[i]);
+    contact.setBody(1, mSecondBodies[i]);
+    contact.setSourceKey(contactSource::cable, i, 0);
+    contact.setContactNormal(glm::normalize(distance));
+
+    /* amount to bounce back*/
+    contact.setInterPenetration(currentCableLength - mMaxCableLengths[i]);
+    contact.setRestiutionCoeff(mCableRestitutions[i]);
+
+    ++numContacts;
+  }
+
+  return numContacts;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "BodyContact.h"
+#include "RigidBodyStorage.h"
+#include "DistanceConstraintSolver.h"
+
+/* all cables of a world, stored as contiguous arrays
+ * a cable only creates a contact if the bodies are farther apart than the cable length */
+class ContactCableBatch {
+  public:
+    /* the compliance is only used by the position based solver */
+    void addCable(const int firstBody, const int secondBody, const float maxLength, const float restitution,
+      const float compliance = 0.0f);
+    unsigned int size() const;
+    /* append the body pairs, i.e. to build the simulation islands */
+    void getLinks(std::vector<std::array<int, 2>>& links) const;
+    /* append all cables to the position based solver */
+    void addDistanceConstraints(DistanceConstraintSolver& solver) const;
+
+    /* writes up to contactLimit contacts, returns number of contacts written
+     * links without any awake, movable body are skipped */
+    unsigned int addContacts(const RigidBodyStorage& bodies, BodyContact* contacts, const unsigned int contactLimit) const;
+
+  private:
+    /* handles of the bodies inside the storage of the world */
+    std::vector<int> mFirstBodies{};
+    std::vector<int> mSecondBodies{};
+
+    std::vector<float> mMaxCableLengths{};
+    /* "bouncy-ness" */
+    std::vector<float> mCableRestitutions{};
+    std::vector<float> mCableCompliances{};
+};
@@ -0,0 +1,89 @@
+#include "ContactPriorityQueue.h"
+
+#include <utility>
+
+void ContactPriorityQueue::build(const std::vector<float>& keys) {
+  mKeys = keys;
+  mHeap.resize(mKeys.size());
+  mHeapPositions.resize(mKeys.size());
+
+  for (unsigned int i = 0; i < mKeys.size(); ++i) {
+    mHeap.at(i) = i;
+    mHeapPositions.at(i) = i;
+  }
+
+  /* bottom-up heap construction */
+  for (unsigned int i = mHeap.size() / 2; i > 0; --i) {
+    siftDown(i - 1);
+  }
+}
+
+void ContactPriorityQueue::update(const unsigned int contactIndex, const float key) {
+  float oldKey = mKeys.at(contactIndex);
+  mKeys.at(contactIndex) = key;
+
+  if (key < oldKey) {
+    siftUp(mHeapPositions.at(contactIndex));
+  } else {
+    siftDown(mHeapPositions.at(contactIndex));
+  }
+}
+
+unsigned int ContactPriorityQueue::top() const {
+  return mHeap.at(0);
+}
+
+float ContactPriorityQueue::topKey() const {
+  return mKeys.at(mHeap.at(0));
+}
+
+unsigned int ContactPriorityQueue::size() const {
+  return mHeap.size();
+}
+
+bool ContactPriorityQueue::isLess(const unsigned int firstContact, const unsigned int secondContact) const {
+  if (mKeys[firstContact] != mKeys[secondContact]) {
+    return mKeys[firstContact] < mKeys[secondContact];
+  }
+  return firstContact < secondContact;
+}
+
+void ContactPriorityQueue::swapEntries(const unsigned int firstPos, const unsigned int secondPos) {
+  std::swap(mHeap[firstPos], mHeap[secondPos]);
+  mHeapPositions[mHeap[firstPos]] = firstPos;
+  mHeapPositions[mHeap[secondPos]] = secondPos;
+}
+
+void ContactPriorityQueue::siftUp(unsigned int heapPos) {
+  while (heapPos > 0) {
+    unsigned int parentPos = (heapPos - 1) / 2;
+    if (!isLess(mHeap[heapPos], mHeap[parentPos])) {
+      break;
+    }
+    swapEntries(heapPos, parentPos);
+    heapPos = parentPos;
+  }
+}
+
+void ContactPriorityQueue::siftDown(unsigned int heapPos) {
+  unsigned int heapSize = mHeap.size();
+
+  while (true) {
+    unsigned int leftPos = heapPos * 2 + 1;
+    unsigned int rightPos = leftPos + 1;
+    unsigned int smallestPos = heapPos;
+
+    if (leftPos < heapSize && isLess(mHeap[leftPos], mHeap[smallestPos])) {
+      smallestPos = leftPos;
+    }
+    if (rightPos < heapSize && isLess(mHeap[rightPos], mHeap[smallestPos])) {
+      smallestPos = rightPos;
+    }
+
+    if (smallestPos == heapPos) {
+      break;
+    }
+    swapEntries(heapPos, smallestPos);
+    heapPos = smallestPos;
+  }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+
+/* indexed binary min heap over contact indices
+ * the key of every contact can be changed in O(log n), ties are broken by the lower contact index */
+class ContactPriorityQueue {
+  public:
+    /* builds the heap from one key per contact in O(n) */
+    void build(const std::vector<float>& keys);
+    void update(const unsigned int contactIndex, const float key);
+
+    unsigned int top() const;
+    float topKey() const;
+    unsigned int size() const;
+
+  private:
+    bool isLess(const unsigned int firstContact, const unsigned int secondContact) const;
+    void swapEntries(const unsigned int firstPos, const unsigned int secondPos);
+    void siftUp(unsigned int heapPos);
+    void siftDown(unsigned int heapPos);
+
+    /* heap position -> contact index */
+    std::vector<unsigned int> mHeap{};
+    /* contact index -> heap position */
+    std::vector<unsigned int> mHeapPositions{};
+    /* contact index -> key */
+    std::vector<float> mKeys{};
+};
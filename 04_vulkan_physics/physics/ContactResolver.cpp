@@ -1,6 +1,6 @@
 #include "ContactResolver.h"
 
-#include <array>
+#include <cfloat>
 
 ContactResolver::ContactResolver(const unsigned int numIterations) : mNumInterations(numIterations) { }
 
@@ -12,60 +12,218 @@ unsigned int ContactResolver::getNumUsedIterations() const {
   return mUsedIterations;
 }
 
-unsigned int ContactResolver::resolveContacts(std::vector<std::shared_ptr<BodyContact>>& contacts, const unsigned int numContacts, const float deltaTime) {
-  mUsedIterations = 0;
+void ContactResolver::setNumThreads(const unsigned int numThreads) {
+  if (numThreads == getNumThreads() || (numThreads == 0 && !mThreadPool)) {
+    return;
+  }
+
+  mThreadPool.reset();
+  if (numThreads > 1) {
+    mThreadPool = std::make_unique<WorkerThreadPool>(numThreads);
+  }
+  mSolverStates.resize(getNumThreads());
+}
 
-  while (mUsedIterations < mNumInterations) {
-    /* TODO: heap/prio queue or similar to have the entries already sorted? */
-    /* or other ways to get the highest separating velocity? */
+unsigned int ContactResolver::getNumThreads() const {
+  if (!mThreadPool) {
+    return 1;
+  }
+  return mThreadPool->getNumThreads();
+}
 
-    /* find contact with max closing velocity */
-    float maxValue = FLT_MAX;
-    unsigned int maxIndex = numContacts;
+unsigned int ContactResolver::getNumIslands() const {
+  if (mIslandOffsets.empty()) {
+    return 0;
+  }
+  return mIslandOffsets.size() - 1;
+}
+
+float ContactResolver::calculateContactKey(const RigidBodyStorage& bodies, const BodyContact& contact) const {
+  float separationVelocity = contact.calculateSeparatingVelocity(bodies);
+
+  /* contacts that are neither closing nor penetrating are not resolved */
+  if (separationVelocity < 0 || contact.getInterPenetration() > 0) {
+    return separationVelocity;
+  }
+  return FLT_MAX;
+}
+
+void ContactResolver::updateInterPenetration(BodyContact& contact, const int firstBody, const int secondBody,
+    const std::array<glm::vec3, 2>& bodyMovements) {
+  if (contact.getBody(0) == firstBody) {
+    contact.setInterPenetration(contact.getInterPenetration() - glm::dot(bodyMovements.at(0), contact.getContactNormal()));
+  } else if (contact.getBody(0) == secondBody) {
+    contact.setInterPenetration(contact.getInterPenetration() - glm::dot(bodyMovements.at(1), contact.getContactNormal()));
+  }
 
-    for (unsigned int i = 0; i < numContacts; ++i) {
-      float separationVelocity = contacts.at(i)->calculateSeparatingVelocity();
-      if (separationVelocity < maxValue && (separationVelocity < 0 || contacts.at(i)->getInterPenetration() > 0)) {
-        maxValue = separationVelocity;
-        maxIndex = i;
+  if (contact.getBody(1) >= 0) {
+    if (contact.getBody(1) == firstBody) {
+      contact.setInterPenetration(contact.getInterPenetration() + glm::dot(bodyMovements.at(0), contact.getContactNormal()));
+    } else if (contact.getBody(1) == secondBody) {
+      contact.setInterPenetration(contact.getInterPenetration() + glm::dot(bodyMovements.at(1), contact.getContactNormal()));
+    }
+  }
+}
+
+unsigned int ContactResolver::findIslandRoot(unsigned int contactIndex) {
+  while (mContactParents[contactIndex] != contactIndex) {
+    /* path halving keeps the trees flat */
+    mContactParents[contactIndex] = mContactParents[mContactParents[contactIndex]];
+    contactIndex = mContactParents[contactIndex];
+  }
+  return contactIndex;
+}
+
+void ContactResolver::buildIslands(const RigidBodyStorage& bodies, const unsigned int numContacts,
+    const ContactAdjacency& adjacency) {
+  mContactParents.resize(numContacts);
+  for (unsigned int i = 0; i < numContacts; ++i) {
+    mContactParents[i] = i;
+  }
+
+  /* all contacts of a movable body belong to the same island, the lowest contact index is the root */
+  for (int body = 0; body < bodies.size(); ++body) {
+    if (bodies.hasInfiniteMass(body)) {
+      continue;
+    }
+
+    const unsigned int* bodyContacts = adjacency.getContacts(body);
+    for (unsigned int i = 1; i < adjacency.getNumContacts(body); ++i) {
+      unsigned int firstRoot = findIslandRoot(bodyContacts[0]);
+      unsigned int secondRoot = findIslandRoot(bodyContacts[i]);
+      if (firstRoot < secondRoot) {
+        mContactParents[secondRoot] = firstRoot;
+      } else if (secondRoot < firstRoot) {
+        mContactParents[firstRoot] = secondRoot;
       }
     }
+  }
+
+  /* number the islands in order of their first contact, a root always comes before its children */
+  mContactIslands.resize(numContacts);
+  mIslandOffsets.assign(1, 0);
+  for (unsigned int i = 0; i < numContacts; ++i) {
+    unsigned int root = findIslandRoot(i);
+    if (root == i) {
+      mContactIslands[i] = mIslandOffsets.size() - 1;
+      mIslandOffsets.emplace_back(0);
+    } else {
+      mContactIslands[i] = mContactIslands[root];
+    }
+    ++mIslandOffsets[mContactIslands[i] + 1];
+  }
+
+  for (unsigned int i = 1; i < mIslandOffsets.size(); ++i) {
+    mIslandOffsets[i] += mIslandOffsets[i - 1];
+  }
+
+  /* fill in the contacts, ascending per island, reusing the parents as fill positions */
+  mIslandContacts.resize(numContacts);
+  mLocalContactIndices.resize(numContacts);
+  mContactParents.assign(mIslandOffsets.begin(), mIslandOffsets.end() - 1);
+  for (unsigned int i = 0; i < numContacts; ++i) {
+    unsigned int island = mContactIslands[i];
+    mLocalContactIndices[i] = mContactParents[island] - mIslandOffsets[island];
+    mIslandContacts[mContactParents[island]++] = i;
+  }
+}
+
+unsigned int ContactResolver::resolveIsland(RigidBodyStorage& bodies, std::vector<BodyContact>& contacts,
+    const ContactAdjacency& adjacency, const unsigned int island, const float deltaTime, SolverState& state) {
+  const unsigned int* islandContacts = mIslandContacts.data() + mIslandOffsets[island];
+  unsigned int numIslandContacts = mIslandOffsets[island + 1] - mIslandOffsets[island];
+
+  /* every island gets its share of the iterations, rounded up */
+  unsigned long long numContacts = mIslandContacts.size();
+  unsigned int numIterations = static_cast<unsigned int>(
+    (static_cast<unsigned long long>(mNumInterations) * numIslandContacts + numContacts - 1) / numContacts);
 
+  /* sort all contacts once, afterwards only the contacts of moved bodies are updated */
+  state.ssContactKeys.resize(numIslandContacts);
+  for (unsigned int i = 0; i < numIslandContacts; ++i) {
+    state.ssContactKeys[i] = calculateContactKey(bodies, contacts.at(islandContacts[i]));
+  }
+  state.ssContactQueue.build(state.ssContactKeys);
+
+  unsigned int usedIterations = 0;
+  while (usedIterations < numIterations) {
     /* nothing found to resolve, return */
-    if (maxIndex == numContacts) {
+    if (state.ssContactQueue.topKey() == FLT_MAX) {
       break;
     }
 
+    /* contact with max closing velocity is on top of the queue */
+    BodyContact& maxContact = contacts.at(islandContacts[state.ssContactQueue.top()]);
+
     /* resolve the contact between the bodies */
-    contacts.at(maxIndex)->resolveContact(deltaTime);
-
-    /* and move the bodies according to the values from contact resolving  */
-    /* TODO: this is a quite expensive search, just to find the two rigid bodies.
-     * Maybe some sort of hash maps would help? */
-    std::array<glm::vec3, 2> bodyMovements = contacts.at(maxIndex)->getBodyMovements();
-
-    for (unsigned int i = 0; i < numContacts; ++i) {
-      if (contacts.at(i)->getBody(0) == contacts.at(maxIndex)->getBody(0)) {
-        contacts.at(i)->setInterPenetration(
-          contacts.at(i)->getInterPenetration() - glm::dot(bodyMovements.at(0), contacts.at(i)->getContactNormal()));
-      } else if (contacts.at(i)->getBody(0) == contacts.at(maxIndex)->getBody(1)) {
-        contacts.at(i)->setInterPenetration(
-          contacts.at(i)->getInterPenetration() - glm::dot(bodyMovements.at(1), contacts.at(i)->getContactNormal()));
+    maxContact.resolveContact(bodies, deltaTime);
+
+    /* and move the bodies according to the values from contact resolving,
+     * only the contacts touching one of the two bodies are affected
+     * bodies with infinite mass never move, so their contacts of other islands are left alone */
+    std::array<glm::vec3, 2> bodyMovements = maxContact.getBodyMovements();
+    int firstBody = maxContact.getBody(0);
+    int secondBody = maxContact.getBody(1);
+    bool firstBodyMoved = !bodies.hasInfiniteMass(firstBody);
+
+    if (firstBodyMoved) {
+      const unsigned int* firstContacts = adjacency.getContacts(firstBody);
+      for (unsigned int i = 0; i < adjacency.getNumContacts(firstBody); ++i) {
+        updateInterPenetration(contacts.at(firstContacts[i]), firstBody, secondBody, bodyMovements);
+
+        /* velocity and penetration changed, re-sort the contact */
+        state.ssContactQueue.update(mLocalContactIndices[firstContacts[i]],
+          calculateContactKey(bodies, contacts.at(firstContacts[i])));
       }
+    }
 
-      if (contacts.at(i)->getBody(1)) {
-        if (contacts.at(i)->getBody(1) == contacts.at(maxIndex)->getBody(0)) {
-          contacts.at(i)->setInterPenetration(
-            contacts.at(i)->getInterPenetration() + glm::dot(bodyMovements.at(0), contacts.at(i)->getContactNormal()));
-        } else if (contacts.at(i)->getBody(1) == contacts.at(maxIndex)->getBody(1)) {
-          contacts.at(i)->setInterPenetration(
-            contacts.at(i)->getInterPenetration() + glm::dot(bodyMovements.at(1), contacts.at(i)->getContactNormal()));
+    if (secondBody >= 0 && !bodies.hasInfiniteMass(secondBody)) {
+      const unsigned int* secondContacts = adjacency.getContacts(secondBody);
+      for (unsigned int i = 0; i < adjacency.getNumContacts(secondBody); ++i) {
+        BodyContact& contact = contacts.at(secondContacts[i]);
+
+        /* contacts between both bodies were already handled above */
+        if (firstBodyMoved && (contact.getBody(0) == firstBody || contact.getBody(1) == firstBody)) {
+          continue;
         }
+
+        updateInterPenetration(contact, firstBody, secondBody, bodyMovements);
+        state.ssContactQueue.update(mLocalContactIndices[secondContacts[i]], calculateContactKey(bodies, contact));
       }
     }
 
-    ++mUsedIterations;
+    ++usedIterations;
   }
-  return mUsedIterations;
+  return usedIterations;
 }
 
+unsigned int ContactResolver::resolveContacts(RigidBodyStorage& bodies, std::vector<BodyContact>& contacts, const unsigned int numContacts,
+    const ContactAdjacency& adjacency, const float deltaTime) {
+  mUsedIterations = 0;
+
+  if (numContacts == 0) {
+    mIslandOffsets.clear();
+    return mUsedIterations;
+  }
+
+  buildIslands(bodies, numContacts, adjacency);
+  unsigned int numIslands = getNumIslands();
+  mIslandIterations.assign(numIslands, 0);
+
+  /* islands share no movable body, every island only writes its own bodies and contacts */
+  if (mThreadPool && numIslands > 1 && numContacts >= mMinParallelContacts) {
+    mThreadPool->runJobs(numIslands, [&](unsigned int island, unsigned int threadIndex) {
+      mIslandIterations[island] = resolveIsland(bodies, contacts, adjacency, island, deltaTime,
+        mSolverStates[threadIndex]);
+    });
+  } else {
+    for (unsigned int island = 0; island < numIslands; ++island) {
+      mIslandIterations[island] = resolveIsland(bodies, contacts, adjacency, island, deltaTime, mSolverStates[0]);
+    }
+  }
+
+  for (const auto iterations : mIslandIterations) {
+    mUsedIterations += iterations;
+  }
+  return mUsedIterations;
+}
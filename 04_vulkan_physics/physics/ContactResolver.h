@@ -1,9 +1,14 @@
 #pragma once
 
-#include <memory>
+#include <array>
 #include <vector>
+#include <memory>
 
 #include "BodyContact.h"
+#include "ContactAdjacency.h"
+#include "ContactPriorityQueue.h"
+#include "RigidBodyStorage.h"
+#include "WorkerThreadPool.h"
 
 class ContactResolver {
   public:
@@ -11,10 +16,52 @@ class ContactResolver {
     void setIterations(const unsigned int numIterations);
     unsigned int getNumUsedIterations() const;
 
-    /* only work on up to numContacts contacts, the remaining entries may be invalid */
-    unsigned int resolveContacts(std::vector<std::shared_ptr<BodyContact>>& contacts, const unsigned int numContacts, const float deltaTime);
+    /* contacts sharing no movable body are split into islands, which are resolved in parallel
+     * every island gets its share of the iterations, so the result does not depend on the number of threads,
+     * one thread resolves all islands inline */
+    void setNumThreads(const unsigned int numThreads);
+    unsigned int getNumThreads() const;
+    unsigned int getNumIslands() const;
+
+    /* only work on up to numContacts contacts, the remaining entries may be invalid
+     * the adjacency must be built from the same contacts */
+    unsigned int resolveContacts(RigidBodyStorage& bodies, std::vector<BodyContact>& contacts, const unsigned int numContacts,
+      const ContactAdjacency& adjacency, const float deltaTime);
 
   private:
+    /* queue and keys are reused between frames, one set per thread */
+    struct SolverState {
+      ContactPriorityQueue ssContactQueue{};
+      std::vector<float> ssContactKeys{};
+    };
+
+    /* group the contacts connected by movable bodies, static bodies are never changed by the resolver */
+    void buildIslands(const RigidBodyStorage& bodies, const unsigned int numContacts, const ContactAdjacency& adjacency);
+    unsigned int findIslandRoot(unsigned int contactIndex);
+    unsigned int resolveIsland(RigidBodyStorage& bodies, std::vector<BodyContact>& contacts,
+      const ContactAdjacency& adjacency, const unsigned int island, const float deltaTime, SolverState& state);
+
+    /* contacts with the most negative separating velocity are resolved first */
+    float calculateContactKey(const RigidBodyStorage& bodies, const BodyContact& contact) const;
+    /* apply the movement of the two resolved bodies to a contact sharing at least one of them */
+    void updateInterPenetration(BodyContact& contact, const int firstBody, const int secondBody,
+      const std::array<glm::vec3, 2>& bodyMovements);
+
     unsigned int mNumInterations = 0;
     unsigned int mUsedIterations = 0;
+
+    std::unique_ptr<WorkerThreadPool> mThreadPool = nullptr;
+    std::vector<SolverState> mSolverStates = std::vector<SolverState>(1);
+    /* below this number of contacts, waking up the worker threads costs more than it saves */
+    unsigned int mMinParallelContacts = 256;
+
+    /* union-find parents while building, island contacts in ascending order afterwards
+     * the contacts of island n are at mIslandContacts[mIslandOffsets[n]] to mIslandContacts[mIslandOffsets[n + 1] - 1] */
+    std::vector<unsigned int> mContactParents{};
+    std::vector<unsigned int> mIslandOffsets{};
+    std::vector<unsigned int> mIslandContacts{};
+    /* contact index -> island and position inside the island */
+    std::vector<unsigned int> mContactIslands{};
+    std::vector<unsigned int> mLocalContactIndices{};
+    std::vector<unsigned int> mIslandIterations{};
 };
@@ -0,0 +1,66 @@
+#include "ContactRodBatch.h"
+
+void ContactRodBatch::addRod(const int firstBody, const int secondBody, const float length, const float compliance) {
+  mFirstBodies.emplace_back(firstBody);
+  mSecondBodies.emplace_back(secondBody);
+  mRodLengths.emplace_back(length);
+  mRodCompliances.emplace_back(compliance);
+}
+
+unsigned int ContactRodBatch::size() const {
+  return mFirstBodies.size();
+}
+
+void ContactRodBatch::getLinks(std::vector<std::array<int, 2>>& links) const {
+  for (unsigned int i = 0; i < mFirstBodies.size(); ++i) {
+    links.push_back({ mFirstBodies[i], mSecondBodies[i] });
+  }
+}
+
+void ContactRodBatch::addDistanceConstraints(DistanceConstraintSolver& solver) const {
+  for (unsigned int i = 0; i < mFirstBodies.size(); ++i) {
+    solver.addConstraint(mFirstBodies[i], mSecondBodies[i], mRodLengths[i], mRodCompliances[i], false);
+  }
+}
+
+unsigned int ContactRodBatch::addContacts(const RigidBodyStorage& bodies, BodyContact* contacts, const unsigned int contactLimit) const {
+  unsigned int numContacts = 0;
+  const unsigned int numRods = mFirstBodies.size();
+
+  for (unsigned int i = 0; i < numRods && numContacts < contactLimit; ++i) {
+    /* both ends sleeping or static, nothing can move */
+    if (!bodies.isActive(mFirstBodies[i]) && !bodies.isActive(mSecondBodies[i])) {
+      continue;
+    }
+
+    glm::vec3 distance = bodies.rbPositions[mSecondBodies[i]] - bodies.rbPositions[mFirstBodies[i]];
+    float currentRodLength = glm::length(distance);
+
+    /* desired length, do nothing */
+    if (currentRodLength == mRodLengths[i]) {
+      continue;
+    }
+
+    BodyContact& contact = contacts[numContacts];
+    contact.setBody(0, mFirstBodies[i]);
+    contact.setBody(1, mSecondBodies[i]);
+    contact.setSourceKey(contactSource::rod, i, 0);
+
+    /* extend or compress? */
+    glm::vec3 contactNormal = glm::normalize(distance);
+    if (currentRodLength > mRodLengths[i]) {
+      contact.setContactNormal(contactNormal);
+      contact.setInterPenetration(currentRodLength - mRodLengths[i]);
+    } else {
+      contact.setContactNormal(contactNormal * -1.0f);
+      contact.setInterPenetration(mRodLengths[i] - currentRodLength);
+    }
+
+    /* do not bounce*/
+    contact.setRestiutionCoeff(0.0f);
+
+    ++numContacts;
+  }
+
+  return numContacts;
+}
@@ -0,0 +1,105 @@
+#include "DistanceConstraintSolver.h"
+
+#include <algorithm>
+
+void DistanceConstraintSolver::clear() {
+  mFirstBodies.clear();
+  mSecondBodies.clear();
+  mLengths.clear();
+  mCompliances.clear();
+  mIsCable.clear();
+  mLambdas.clear();
+}
+
+void DistanceConstraintSolver::addConstraint(const int firstBody, const int secondBody, const float length,
+    const float compliance, const bool isCable) {
+  mFirstBodies.emplace_back(firstBody);
+  mSecondBodies.emplace_back(secondBody);
+  mLengths.emplace_back(length);
+  mCompliances.emplace_back(std::max(compliance, 0.0f));
+  mIsCable.emplace_back(isCable ? 1 : 0);
+  mLambdas.emplace_back(0.0f);
+}
+
+unsigned int DistanceConstraintSolver::size() const {
+  return mFirstBodies.size();
+}
+
+void DistanceConstraintSolver::setIterations(const unsigned int numIterations) {
+  mNumIterations = numIterations;
+}
+
+unsigned int DistanceConstraintSolver::solveConstraints(RigidBodyStorage& bodies, const float deltaTime) {
+  const unsigned int numConstraints = mFirstBodies.size();
+  if (numConstraints == 0 || deltaTime <= 0.0f) {
+    return 0;
+  }
+
+  std::fill(mLambdas.begin(), mLambdas.end(), 0.0f);
+  const float inverseDeltaTime = 1.0f / deltaTime;
+  const float inverseDeltaTimeSquared = inverseDeltaTime * inverseDeltaTime;
+
+  for (unsigned int iteration = 0; iteration < mNumIterations; ++iteration) {
+    for (unsigned int i = 0; i < numConstraints; ++i) {
+      int firstBody = mFirstBodies[i];
+      int secondBody = mSecondBodies[i];
+
+      /* both ends sleeping or static, nothing can move */
+      if (!bodies.isActive(firstBody) && !bodies.isActive(secondBody)) {
+        continue;
+      }
+
+      glm::vec3 distance = bodies.rbPositions[secondBody] - bodies.rbPositions[firstBody];
+      float currentLength = glm::length(distance);
+      if (currentLength <= 0.0f) {
+        continue;
+      }
+
+      /* a slack cable is only skipped if it did not pull in an earlier iteration */
+      float constraintError = currentLength - mLengths[i];
+      if (mIsCable[i] && constraintError <= 0.0f && mLambdas[i] == 0.0f) {
+        continue;
+      }
+
+      float firstInverseMass = bodies.rbInverseMasses[firstBody];
+      float secondInverseMass = bodies.rbInverseMasses[secondBody];
+      float scaledCompliance = mCompliances[i] * inverseDeltaTimeSquared;
+      float totalInverseMass = firstInverseMass + secondInverseMass + scaledCompliance;
+
+      /* infinite masses, do nothing */
+      if (totalInverseMass <= 0.0f) {
+        continue;
+      }
+
+      float deltaLambda = (-constraintError - scaledCompliance * mLambdas[i]) / totalInverseMass;
+
+      /* the sum of all corrections of a cable may only pull the bodies together */
+      if (mIsCable[i]) {
+        deltaLambda = std::min(mLambdas[i] + deltaLambda, 0.0f) - mLambdas[i];
+      }
+      mLambdas[i] += deltaLambda;
+
+      if (deltaLambda == 0.0f) {
+        continue;
+      }
+
+      /* move along the constraint direction, proportional to the inverse masses,
+       * and change the velocity by the same amount to keep the integrated velocity consistent */
+      glm::vec3 correction = distance * (deltaLambda / currentLength);
+      if (firstInverseMass > 0.0f) {
+        glm::vec3 movement = correction * -firstInverseMass;
+        bodies.rbPositions[firstBody] += movement;
+        bodies.rbVelocities[firstBody] += movement * inverseDeltaTime;
+        bodies.setAwake(firstBody, true);
+      }
+      if (secondInverseMass > 0.0f) {
+        glm::vec3 movement = correction * secondInverseMass;
+        bodies.rbPositions[secondBody] += movement;
+        bodies.rbVelocities[secondBody] += movement * inverseDeltaTime;
+        bodies.setAwake(secondBody, true);
+      }
+    }
+  }
+
+  return mNumIterations;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "RigidBodyStorage.h"
+
+/* position based (XPBD) solver for cables and rods
+ * the bodies are moved directly to the constraint lengths after integration, and the velocities follow the movement.
+ * with a fixed number of iterations the cost only depends on the number of constraints, not on the stretch */
+class DistanceConstraintSolver {
+  public:
+    void clear();
+    /* cables only pull, rods keep the length in both directions
+     * compliance is the inverse stiffness (m/N), zero means rigid */
+    void addConstraint(const int firstBody, const int secondBody, const float length, const float compliance,
+      const bool isCable);
+    unsigned int size() const;
+
+    void setIterations(const unsigned int numIterations);
+
+    /* bodies must already be integrated for this step, returns the number of iterations used */
+    unsigned int solveConstraints(RigidBodyStorage& bodies, const float deltaTime);
+
+  private:
+    unsigned int mNumIterations = 4;
+
+    /* handles of the bodies inside the storage of the world */
+    std::vector<int> mFirstBodies{};
+    std::vector<int> mSecondBodies{};
+    std::vector<float> mLengths{};
+    std::vector<float> mCompliances{};
+    /* no std::vector<bool> here, we need addressable elements */
+    std::vector<uint8_t> mIsCable{};
+
+    /* accumulated lagrange multiplier of every constraint, reset in every step */
+    std::vector<float> mLambdas{};
+};
@@ -1,29 +1,21 @@
 #include "DragForce.h"
-#include "Logger.h"
 
 DragForce::DragForce(const float linearCoeff, const float squareCoeff): mLinearDragCoefficient(linearCoeff), mSquareDragCoefficient(squareCoeff) { }
 
-void DragForce::updateForce(std::shared_ptr<RigidBody> body, float deltaTime) {
-  if (!body) {
-    Logger::log(1, "%s error: no body given\n", __FUNCTION__);
-    return;
+void DragForce::updateForces(RigidBodyStorage& bodies, const int firstBody, const int numBodies, const float deltaTime) {
+  const float* inverseMasses = bodies.rbInverseMasses.data() + firstBody;
+  const uint8_t* isAwake = bodies.rbIsAwake.data() + firstBody;
+  const glm::vec3* velocities = bodies.rbVelocities.data() + firstBody;
+  glm::vec3* forces = bodies.rbAccumulatedForces.data() + firstBody;
+
+  for (int i = 0; i < numBodies; ++i) {
+    /* infinite mass or resting, no drag */
+    float mass = inverseMasses[i] > 0.0f ? 1.0f / inverseMasses[i] : 0.0f;
+
+    /* velocity / speed * (linear * speed + square * speed^2), without the division a body
+     * at rest needs no special case */
+    float speed = glm::length(velocities[i]);
+    float dragCoeff = mLinearDragCoefficient + mSquareDragCoefficient * speed;
+    forces[i] -= velocities[i] * (dragCoeff * (mass * isAwake[i]));
   }
-
-  if (body->hasInfiniteMass()) {
-    return;
-  }
-
-  glm::vec3 velocity = body->getVelocity();
-  float velocityLength = glm::length(velocity);
-
-  float dragCoeff = mLinearDragCoefficient * velocityLength + mSquareDragCoefficient * velocityLength * velocityLength;
-  glm::vec3 force = glm::normalize(velocity) * -dragCoeff;
-
-  if (glm::any(glm::isnan(force))) {
-    Logger::log(1, "%s error: drag force vector contains NaN value(s)\n", __FUNCTION__);
-    return;
-  }
-
-  body->addForce(force * body->getMass());
 }
-
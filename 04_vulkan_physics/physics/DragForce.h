@@ -6,7 +6,7 @@ class DragForce : public IForceGenerator {
   public:
     DragForce(const float linearCoeff, const float squareCoeff);
 
-    virtual void updateForce(std::shared_ptr<RigidBody> body, float deltaTime) override;
+    virtual void updateForces(RigidBodyStorage& bodies, const int firstBody, const int numBodies, const float deltaTime) override;
 
   private:
     float mLinearDragCoefficient = 0.0f;
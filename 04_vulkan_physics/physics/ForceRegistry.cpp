@@ -1,21 +1,99 @@
 #include "ForceRegistry.h"
 
+#include <algorithm>
+
 #include "Logger.h"
 
+ForceRegistry::ForceRegistry(const std::shared_ptr<RigidBodyStorage> storage) : mStorage(storage) { }
+
+std::vector<ForceEntry>::iterator ForceRegistry::findEntry(const std::shared_ptr<IForceGenerator>& force) {
+  return std::find_if(mEntries.begin(), mEntries.end(), [&](const ForceEntry& entry) {
+    return entry.feForce == force;
+  });
+}
+
 void ForceRegistry::addEntry(const std::shared_ptr<RigidBody> body, const std::shared_ptr<IForceGenerator> force) {
-  mEntries.emplace(std::make_pair(body, force));
+  if (!body || !force) {
+    Logger::log(1, "%s error: no body or force given\n", __FUNCTION__);
+    return;
+  }
+
+  /* a body outside the world gets a new handle when it is added, the old handle would receive the forces */
+  if (body->getStorage() != mStorage) {
+    Logger::log(1, "%s error: body is not part of the world, add it to the world before registering forces\n", __FUNCTION__);
+    return;
+  }
+
+  auto entry = findEntry(force);
+  if (entry == mEntries.end()) {
+    ForceEntry newEntry;
+    newEntry.feForce = force;
+    mEntries.emplace_back(newEntry);
+    entry = mEntries.end() - 1;
+  }
+
+  /* every body is registered only once per generator */
+  std::vector<int>& handles = entry->feBodyHandles;
+  auto pos = std::lower_bound(handles.begin(), handles.end(), body->getHandle());
+  if (pos == handles.end() || *pos != body->getHandle()) {
+    handles.insert(pos, body->getHandle());
+    entry->feRangesDirty = true;
+  }
 }
 
 void ForceRegistry::deleteEntry(const std::shared_ptr<RigidBody> body, const std::shared_ptr<IForceGenerator> force) {
-  mEntries.erase(std::make_pair(body, force));
+  if (!body || !force) {
+    Logger::log(1, "%s error: no body or force given\n", __FUNCTION__);
+    return;
+  }
+
+  /* never registered */
+  if (body->getStorage() != mStorage) {
+    return;
+  }
+
+  auto entry = findEntry(force);
+  if (entry == mEntries.end()) {
+    return;
+  }
+
+  std::vector<int>& handles = entry->feBodyHandles;
+  auto pos = std::lower_bound(handles.begin(), handles.end(), body->getHandle());
+  if (pos != handles.end() && *pos == body->getHandle()) {
+    handles.erase(pos);
+    entry->feRangesDirty = true;
+  }
+
+  if (handles.empty()) {
+    mEntries.erase(entry);
+  }
 }
 
 void ForceRegistry::clear() {
   mEntries.clear();
 }
 
+void ForceRegistry::buildRanges(ForceEntry& entry) {
+  entry.feBodyRanges.clear();
+  for (const auto handle : entry.feBodyHandles) {
+    if (!entry.feBodyRanges.empty() &&
+        entry.feBodyRanges.back().fbFirstBody + entry.feBodyRanges.back().fbNumBodies == handle) {
+      ++entry.feBodyRanges.back().fbNumBodies;
+    } else {
+      entry.feBodyRanges.push_back({ handle, 1 });
+    }
+  }
+  entry.feRangesDirty = false;
+}
+
 void ForceRegistry::updateForces(const float deltaTime) {
-  for (const auto& [body, force] : mEntries) {
-    force->updateForce(body, deltaTime);
+  for (auto& entry : mEntries) {
+    if (entry.feRangesDirty) {
+      buildRanges(entry);
+    }
+
+    for (const auto& range : entry.feBodyRanges) {
+      entry.feForce->updateForces(*mStorage, range.fbFirstBody, range.fbNumBodies, deltaTime);
+    }
   }
 }
@@ -1,27 +1,43 @@
 #pragma once
 
-#include <unordered_set>
-#include <tuple>
+#include <vector>
 #include <memory>
 
 #include "IForceGenerator.h"
 #include "RigidBody.h"
+#include "RigidBodyStorage.h"
 
-struct EntryHash {
-  template <typename T, typename U>
-  auto operator()(const std::pair<T, U> &p) const -> size_t {
-   return std::hash<T>{} (p.first) ^ std::hash<U>{} (p.second);
-  }
+/* consecutive body handles, evaluated with a single call of the generator */
+struct ForceBodyRange {
+  int fbFirstBody = 0;
+  int fbNumBodies = 0;
+};
+
+/* all bodies of one generator, handles are kept sorted */
+struct ForceEntry {
+  std::shared_ptr<IForceGenerator> feForce = nullptr;
+  std::vector<int> feBodyHandles{};
+  std::vector<ForceBodyRange> feBodyRanges{};
+  bool feRangesDirty = true;
 };
 
 class ForceRegistry {
   public:
+    /* forces work on the handles inside the storage of the world, bodies in any other storage are rejected */
+    ForceRegistry(const std::shared_ptr<RigidBodyStorage> storage);
+
+    /* the body must be added to the world before */
     void addEntry(const std::shared_ptr<RigidBody> body, const std::shared_ptr<IForceGenerator> force);
     void deleteEntry(const std::shared_ptr<RigidBody> body, const std::shared_ptr<IForceGenerator> force);
     void clear();
 
+    /* one call per generator and range of consecutive bodies */
     void updateForces(const float deltaTime);
 
   private:
-    std::unordered_set<std::pair<std::shared_ptr<RigidBody>, std::shared_ptr<IForceGenerator>>, EntryHash> mEntries;
+    std::vector<ForceEntry>::iterator findEntry(const std::shared_ptr<IForceGenerator>& force);
+    void buildRanges(ForceEntry& entry);
+
+    std::shared_ptr<RigidBodyStorage> mStorage = nullptr;
+    std::vector<ForceEntry> mEntries{};
 };
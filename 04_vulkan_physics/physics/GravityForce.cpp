@@ -1,18 +1,16 @@
 #include "GravityForce.h"
 
-#include "Logger.h"
-
 GravityForce::GravityForce(const glm::vec3 gravity) : mGravityConstant(gravity) {};
 
-void GravityForce::updateForce(std::shared_ptr<RigidBody> body, float deltaTime) {
-  if (!body) {
-    Logger::log(1, "%s error: no body given\n", __FUNCTION__);
-    return;
-  }
+void GravityForce::updateForces(RigidBodyStorage& bodies, const int firstBody, const int numBodies, const float deltaTime) {
+  const float* inverseMasses = bodies.rbInverseMasses.data() + firstBody;
+  const uint8_t* isAwake = bodies.rbIsAwake.data() + firstBody;
+  glm::vec3* forces = bodies.rbAccumulatedForces.data() + firstBody;
 
-  if (body->hasInfiniteMass()) {
-    return;
+  /* infinite mass or resting, no gravity
+   * the force is scaled to zero instead of skipping the body, so the loop has no branch and can be vectorized */
+  for (int i = 0; i < numBodies; ++i) {
+    float mass = inverseMasses[i] > 0.0f ? 1.0f / inverseMasses[i] : 0.0f;
+    forces[i] += mGravityConstant * (mass * isAwake[i]);
   }
-
-  body->addForce(mGravityConstant * body->getMass());
 }
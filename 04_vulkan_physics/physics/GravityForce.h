@@ -1,16 +1,14 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <memory>
 
 #include "IForceGenerator.h"
-#include "RigidBody.h"
 
 class GravityForce : public IForceGenerator {
   public:
     GravityForce(const glm::vec3 gravity);
 
-    virtual void updateForce(std::shared_ptr<RigidBody> body, float deltaTime) override;
+    virtual void updateForces(RigidBodyStorage& bodies, const int firstBody, const int numBodies, const float deltaTime) override;
 
   private:
     glm::vec3 mGravityConstant;
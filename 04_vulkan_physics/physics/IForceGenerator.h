@@ -1,12 +1,14 @@
 #pragma once
 
-#include <memory>
+#include "RigidBodyStorage.h"
 
-#include "RigidBody.h"
-
-/* Interface style base class */
+/* Interface style base class
+ * a generator is evaluated over a range of consecutive body handles in one call. it must only
+ * write the accumulated force and torque of the given bodies, so disjoint ranges can be
+ * updated in parallel. adding a force wakes up a sleeping body, so generators for constant
+ * forces like gravity should skip the sleeping bodies */
 class IForceGenerator {
   public:
-    virtual void updateForce(std::shared_ptr<RigidBody> body, float deltaTime) = 0;
+    virtual void updateForces(RigidBodyStorage& bodies, const int firstBody, const int numBodies, const float deltaTime) = 0;
     virtual ~IForceGenerator() = default;
 };
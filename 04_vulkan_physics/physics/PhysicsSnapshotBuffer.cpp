@@ -0,0 +1,47 @@
+#include "PhysicsSnapshotBuffer.h"
+
+void PhysicsSnapshot::copyBodies(const RigidBodyStorage& bodies) {
+  snPreviousPositions.assign(bodies.rbPreviousPositions.begin(), bodies.rbPreviousPositions.end());
+  snPositions.assign(bodies.rbPositions.begin(), bodies.rbPositions.end());
+  snPreviousOrientations.assign(bodies.rbPreviousOrientations.begin(), bodies.rbPreviousOrientations.end());
+  snOrientations.assign(bodies.rbOrientations.begin(), bodies.rbOrientations.end());
+}
+
+glm::vec3 PhysicsSnapshot::getInterpolatedPosition(const int handle, const float alpha) const {
+  /* no snapshot published yet */
+  if (handle < 0 || handle >= static_cast<int>(snPositions.size())) {
+    return glm::vec3(0.0f);
+  }
+  return glm::mix(snPreviousPositions[handle], snPositions[handle], alpha);
+}
+
+glm::quat PhysicsSnapshot::getInterpolatedOrientation(const int handle, const float alpha) const {
+  if (handle < 0 || handle >= static_cast<int>(snOrientations.size())) {
+    return glm::quat();
+  }
+  return glm::slerp(snPreviousOrientations[handle], snOrientations[handle], alpha);
+}
+
+PhysicsSnapshot& PhysicsSnapshotBuffer::getWriteSnapshot() {
+  return mSnapshots[mWriteIndex];
+}
+
+void PhysicsSnapshotBuffer::publish() {
+  /* release: the reader must see the complete snapshot after the swap */
+  unsigned int oldMiddle = mMiddleIndex.exchange(mWriteIndex | NEW_SNAPSHOT_BIT, std::memory_order_acq_rel);
+  mWriteIndex = oldMiddle & INDEX_MASK;
+}
+
+bool PhysicsSnapshotBuffer::update() {
+  if (!(mMiddleIndex.load(std::memory_order_relaxed) & NEW_SNAPSHOT_BIT)) {
+    return false;
+  }
+
+  unsigned int oldMiddle = mMiddleIndex.exchange(mReadIndex, std::memory_order_acq_rel);
+  mReadIndex = oldMiddle & INDEX_MASK;
+  return true;
+}
+
+const PhysicsSnapshot& PhysicsSnapshotBuffer::getReadSnapshot() const {
+  return mSnapshots[mReadIndex];
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+#include "RigidBodyStorage.h"
+
+/* body transforms and statistics after a physics update, indexed by the body handles of the world */
+struct PhysicsSnapshot {
+  void copyBodies(const RigidBodyStorage& bodies);
+
+  glm::vec3 getInterpolatedPosition(const int handle, const float alpha) const;
+  glm::quat getInterpolatedOrientation(const int handle, const float alpha) const;
+
+  std::vector<glm::vec3> snPreviousPositions{};
+  std::vector<glm::vec3> snPositions{};
+  std::vector<glm::quat> snPreviousOrientations{};
+  std::vector<glm::quat> snOrientations{};
+
+  /* time left over after the last step, counted from the publish time */
+  std::chrono::time_point<std::chrono::steady_clock> snPublishTime{};
+  float snAccumulatedTime = 0.0f;
+  float snFixedTimeStep = 1.0f / 60.0f;
+
+  /* steps and milliseconds used for them since the last snapshot */
+  unsigned int snSteps = 0;
+  float snStepTime = 0.0f;
+
+  /* statistics of the last step */
+  unsigned int snContacts = 0;
+  unsigned int snResolverIterations = 0;
+  unsigned int snCollisionPairs = 0;
+  unsigned int snAwakeBodies = 0;
+  unsigned int snIslands = 0;
+  unsigned int snAwakeIslands = 0;
+};
+
+/* lock-free triple buffer for one writer and one reader thread
+ * the writer fills the write snapshot and swaps it with the middle one, the reader swaps the middle one
+ * with its read snapshot if the writer published a new one. no thread ever waits for the other */
+class PhysicsSnapshotBuffer {
+  public:
+    /* writer side */
+    PhysicsSnapshot& getWriteSnapshot();
+    void publish();
+
+    /* reader side, returns true if a new snapshot was published since the last call */
+    bool update();
+    const PhysicsSnapshot& getReadSnapshot() const;
+
+  private:
+    /* index of the middle snapshot, plus a flag for new data */
+    static constexpr unsigned int NEW_SNAPSHOT_BIT = 4;
+    static constexpr unsigned int INDEX_MASK = 3;
+
+    std::array<PhysicsSnapshot, 3> mSnapshots{};
+
+    unsigned int mWriteIndex = 0;
+    std::atomic<unsigned int> mMiddleIndex = 1;
+    unsigned int mReadIndex = 2;
+};
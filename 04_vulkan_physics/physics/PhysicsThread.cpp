@@ -0,0 +1,192 @@
+#include "PhysicsThread.h"
+
+#include <chrono>
+
+#include "Timer.h"
+#include "Logger.h"
+
+PhysicsThread::~PhysicsThread() {
+  stop();
+}
+
+bool PhysicsThread::start(RigidBodyWorld& world, ForceRegistry& forceRegistry) {
+  if (mThread.joinable()) {
+    Logger::log(1, "%s error: physics thread already running\n", __FUNCTION__);
+    return false;
+  }
+
+  mWorld = &world;
+  mForceRegistry = &forceRegistry;
+  mShutdown = false;
+
+  /* the renderer needs the bodies before the first update */
+  publishSnapshot(0, 0.0f);
+
+  mThread = std::thread(&PhysicsThread::run, this);
+  Logger::log(1, "%s: physics thread started\n", __FUNCTION__);
+  return true;
+}
+
+void PhysicsThread::stop() {
+  if (!mThread.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mCommandMutex);
+    mShutdown = true;
+  }
+  mCommandCondition.notify_one();
+  mThread.join();
+
+  /* commands that did not run anymore are dropped */
+  mCommands.clear();
+  Logger::log(1, "%s: physics thread stopped\n", __FUNCTION__);
+}
+
+void PhysicsThread::enqueueCommand(const std::function<void()>& command) {
+  {
+    std::lock_guard<std::mutex> lock(mCommandMutex);
+    mCommands.emplace_back(command);
+  }
+  mCommandCondition.notify_one();
+}
+
+void PhysicsThread::setSettings(const PhysicsSettings& settings) {
+  if (mSettingsSent &&
+      settings.psStepsPerSecond == mSentSettings.psStepsPerSecond &&
+      settings.psMaxSubSteps == mSentSettings.psMaxSubSteps &&
+      settings.psContactSolver == mSentSettings.psContactSolver &&
+      settings.psImpulseSolverIterations == mSentSettings.psImpulseSolverIterations &&
+      settings.psImpulseSolverWarmStarting == mSentSettings.psImpulseSolverWarmStarting &&
+      settings.psPositionBasedLinks == mSentSettings.psPositionBasedLinks &&
+      settings.psPositionBasedIterations == mSentSettings.psPositionBasedIterations) {
+    return;
+  }
+
+  mSentSettings = settings;
+  mSettingsSent = true;
+  enqueueCommand([this, settings]() { applySettings(settings); });
+}
+
+void PhysicsThread::setPaused(const bool paused) {
+  if (paused == mSentPaused) {
+    return;
+  }
+
+  mSentPaused = paused;
+  enqueueCommand([this, paused]() { mPaused = paused; });
+}
+
+bool PhysicsThread::updateSnapshot() {
+  return mSnapshots.update();
+}
+
+const PhysicsSnapshot& PhysicsThread::getSnapshot() const {
+  return mSnapshots.getReadSnapshot();
+}
+
+float PhysicsThread::getInterpolationFactor() const {
+  const PhysicsSnapshot& snapshot = mSnapshots.getReadSnapshot();
+  if (snapshot.snFixedTimeStep <= 0.0f) {
+    return 1.0f;
+  }
+
+  std::chrono::duration<float> sincePublish = std::chrono::steady_clock::now() - snapshot.snPublishTime;
+  return glm::clamp((snapshot.snAccumulatedTime + sincePublish.count()) / snapshot.snFixedTimeStep, 0.0f, 1.0f);
+}
+
+void PhysicsThread::run() {
+  std::chrono::time_point<std::chrono::steady_clock> lastTime = std::chrono::steady_clock::now();
+  Timer stepTimer;
+
+  while (true) {
+    bool commandsDone = runCommands();
+
+    std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+    std::chrono::duration<float> deltaTime = now - lastTime;
+    lastTime = now;
+
+    unsigned int numSteps = 0;
+    float stepTime = 0.0f;
+    if (!mPaused) {
+      numSteps = mWorld->accumulateTime(deltaTime.count());
+      float timeStep = mWorld->getFixedTimeStep();
+
+      stepTimer.start();
+      for (unsigned int i = 0; i < numSteps; ++i) {
+        mWorld->startFrame();
+        mForceRegistry->updateForces(timeStep);
+        mWorld->runPhysics(timeStep);
+      }
+      stepTime = stepTimer.stop();
+    }
+
+    if (numSteps > 0 || commandsDone) {
+      publishSnapshot(numSteps, stepTime);
+    }
+
+    /* sleep until the next step is due, new commands and stop() wake us up earlier */
+    std::unique_lock<std::mutex> lock(mCommandMutex);
+    auto wakeUp = [this]() { return mShutdown || !mCommands.empty(); };
+    if (mPaused) {
+      mCommandCondition.wait(lock, wakeUp);
+      /* the paused time must not be simulated after resuming */
+      lastTime = std::chrono::steady_clock::now();
+    } else {
+      float timeStep = mWorld->getFixedTimeStep();
+      float remainingTime = (1.0f - mWorld->getInterpolationFactor()) * timeStep;
+      mCommandCondition.wait_for(lock, std::chrono::duration<float>(remainingTime), wakeUp);
+    }
+
+    if (mShutdown) {
+      break;
+    }
+  }
+}
+
+bool PhysicsThread::runCommands() {
+  {
+    std::lock_guard<std::mutex> lock(mCommandMutex);
+    mRunningCommands.swap(mCommands);
+  }
+
+  /* run outside of the lock, so the render thread never waits for a command */
+  for (const auto& command : mRunningCommands) {
+    command();
+  }
+
+  bool commandsDone = !mRunningCommands.empty();
+  mRunningCommands.clear();
+  return commandsDone;
+}
+
+void PhysicsThread::applySettings(const PhysicsSettings& settings) {
+  mWorld->setFixedTimeStep(1.0f / static_cast<float>(settings.psStepsPerSecond), settings.psMaxSubSteps);
+  mWorld->setContactSolver(settings.psContactSolver);
+  mWorld->setImpulseSolverIterations(settings.psImpulseSolverIterations, settings.psImpulseSolverIterations);
+  mWorld->setImpulseSolverWarmStarting(settings.psImpulseSolverWarmStarting);
+  mWorld->setPositionBasedLinks(settings.psPositionBasedLinks);
+  mWorld->setPositionBasedIterations(settings.psPositionBasedIterations);
+}
+
+void PhysicsThread::publishSnapshot(const unsigned int numSteps, const float stepTime) {
+  PhysicsSnapshot& snapshot = mSnapshots.getWriteSnapshot();
+  snapshot.copyBodies(*mWorld->getRigidBodyStorage());
+
+  snapshot.snPublishTime = std::chrono::steady_clock::now();
+  snapshot.snFixedTimeStep = mWorld->getFixedTimeStep();
+  snapshot.snAccumulatedTime = mWorld->getInterpolationFactor() * snapshot.snFixedTimeStep;
+
+  snapshot.snSteps = numSteps;
+  snapshot.snStepTime = stepTime;
+
+  snapshot.snContacts = mWorld->getNumContacts();
+  snapshot.snResolverIterations = mWorld->getNumResolverIterations();
+  snapshot.snCollisionPairs = mWorld->getNumCollisionPairs();
+  snapshot.snAwakeBodies = mWorld->getNumAwakeBodies();
+  snapshot.snIslands = mWorld->getNumIslands();
+  snapshot.snAwakeIslands = mWorld->getNumAwakeIslands();
+
+  mSnapshots.publish();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "RigidBodyWorld.h"
+#include "ForceRegistry.h"
+#include "PhysicsSnapshotBuffer.h"
+
+/* world settings changeable while the physics thread runs */
+struct PhysicsSettings {
+  int psStepsPerSecond = 60;
+  int psMaxSubSteps = 5;
+  contactSolver psContactSolver = contactSolver::priorityQueue;
+  int psImpulseSolverIterations = 10;
+  bool psImpulseSolverWarmStarting = true;
+  bool psPositionBasedLinks = false;
+  int psPositionBasedIterations = 4;
+};
+
+/* steps a world and its force registry on a separate thread with the fixed time step of the world
+ * the bodies are published as snapshots after every update, the world and the force registry must
+ * only be changed by commands while the thread runs. all public functions are called by the render thread */
+class PhysicsThread {
+  public:
+    ~PhysicsThread();
+
+    bool start(RigidBodyWorld& world, ForceRegistry& forceRegistry);
+    void stop();
+
+    /* runs on the physics thread before the next update */
+    void enqueueCommand(const std::function<void()>& command);
+
+    /* only send changed values to the physics thread */
+    void setSettings(const PhysicsSettings& settings);
+    void setPaused(const bool paused);
+
+    /* fetch the newest snapshot, returns true if there is a new one */
+    bool updateSnapshot();
+    const PhysicsSnapshot& getSnapshot() const;
+    /* position between the previous and the current state of the snapshot, for the current time */
+    float getInterpolationFactor() const;
+
+  private:
+    void run();
+    bool runCommands();
+    void applySettings(const PhysicsSettings& settings);
+    void publishSnapshot(const unsigned int numSteps, const float stepTime);
+
+    RigidBodyWorld* mWorld = nullptr;
+    ForceRegistry* mForceRegistry = nullptr;
+
+    std::thread mThread{};
+    std::mutex mCommandMutex{};
+    std::condition_variable mCommandCondition{};
+    std::vector<std::function<void()>> mCommands{};
+    bool mShutdown = false;
+
+    /* physics thread only */
+    std::vector<std::function<void()>> mRunningCommands{};
+    bool mPaused = true;
+
+    /* render thread only */
+    PhysicsSettings mSentSettings{};
+    bool mSettingsSent = false;
+    bool mSentPaused = true;
+
+    PhysicsSnapshotBuffer mSnapshots{};
+};
@@ -1,167 +1,159 @@
 #include "RigidBody.h"
 #include "Logger.h"
 
+RigidBody::RigidBody() {
+  mStorage = std::make_shared<RigidBodyStorage>();
+  mHandle = mStorage->addBody();
+}
+
+RigidBody::RigidBody(const std::shared_ptr<RigidBodyStorage> storage, const int handle) :
+  mStorage(storage), mHandle(handle) { }
+
+int RigidBody::moveToStorage(const std::shared_ptr<RigidBodyStorage> storage) {
+  if (!storage) {
+    Logger::log(1, "%s error: no storage given\n", __FUNCTION__);
+    return mHandle;
+  }
+
+  if (storage == mStorage) {
+    return mHandle;
+  }
+
+  int newHandle = storage->addBody();
+  storage->copyBody(newHandle, *mStorage, mHandle);
+
+  mStorage = storage;
+  mHandle = newHandle;
+
+  return mHandle;
+}
+
+std::shared_ptr<RigidBodyStorage> RigidBody::getStorage() const {
+  return mStorage;
+}
+
+int RigidBody::getHandle() const {
+  return mHandle;
+}
 
 void RigidBody::setMass(const float mass) {
   /* infinite mass */
   if (mass <= 0.0f) {
-    mInverseMass = 0.0f;
+    mStorage->rbInverseMasses.at(mHandle) = 0.0f;
     return;
   }
 
-  mInverseMass = 1.0f / mass;
+  mStorage->rbInverseMasses.at(mHandle) = 1.0f / mass;
 }
 
 float RigidBody::getMass() const {
-  return 1.0f / mInverseMass;
+  return 1.0f / mStorage->rbInverseMasses.at(mHandle);
 }
 
 bool RigidBody::hasInfiniteMass() {
-  if (mInverseMass <= 0.0f ) {
-    return true;
-  }
-  return false;
+  return mStorage->hasInfiniteMass(mHandle);
 }
 
 float RigidBody::getInverseMass() const {
-  return mInverseMass;
+  return mStorage->rbInverseMasses.at(mHandle);
 }
 
+/* setting the position directly moves the body, no interpolation from the old position */
 void RigidBody::setPosition(const glm::vec3 pos) {
-  mPosition = pos;
+  mStorage->rbPositions.at(mHandle) = pos;
+  mStorage->rbPreviousPositions.at(mHandle) = pos;
+  mStorage->setAwake(mHandle, true);
 }
 
 glm::vec3 RigidBody::getPosition() const {
-  return mPosition;
+  return mStorage->rbPositions.at(mHandle);
 }
 
 void RigidBody::setOrientation(const glm::quat orient) {
-  mOrientation = orient;
+  mStorage->rbOrientations.at(mHandle) = orient;
+  mStorage->rbPreviousOrientations.at(mHandle) = orient;
+  mStorage->setAwake(mHandle, true);
 }
 
 glm::quat RigidBody::getOrientation() const {
-  return mOrientation;
+  return mStorage->rbOrientations.at(mHandle);
+}
+
+glm::vec3 RigidBody::getInterpolatedPosition(const float alpha) const {
+  return mStorage->getInterpolatedPosition(mHandle, alpha);
+}
+
+glm::quat RigidBody::getInterpolatedOrientation(const float alpha) const {
+  return mStorage->getInterpolatedOrientation(mHandle, alpha);
 }
 
 void RigidBody::setVelocity(const glm::vec3 velo) {
-  mVelocity = velo;
+  mStorage->rbVelocities.at(mHandle) = velo;
+  mStorage->setAwake(mHandle, true);
 }
 
 glm::vec3 RigidBody::getVelocity() const {
-  return mVelocity;
+  return mStorage->rbVelocities.at(mHandle);
 }
 
 void RigidBody::setAcceleration(const glm::vec3 accel) {
-  mAcceleration = accel;
+  mStorage->rbAccelerations.at(mHandle) = accel;
 }
 
 glm::vec3 RigidBody::getAcceleration() const {
-  return mAcceleration;
+  return mStorage->rbAccelerations.at(mHandle);
 }
 
 void RigidBody::setLinearDaming(const float damp) {
-  mLinearDamping = damp;
+  mStorage->rbLinearDampings.at(mHandle) = damp;
 }
 
 void RigidBody::setAngularDamping(const float damp) {
-  mAngularDamping = damp;
+  mStorage->rbAngularDampings.at(mHandle) = damp;
 }
 
 void RigidBody::addForce(const glm::vec3 force) {
-  mAccumulatedForce += force;
-  mIsAwake = true;
+  mStorage->rbAccumulatedForces.at(mHandle) += force;
+  mStorage->setAwake(mHandle, true);
 }
 
 void RigidBody::addTorque(const glm::vec3 torque) {
-  mAccumulatedTorque += torque;
-  mIsAwake = true;
+  mStorage->rbAccumulatedTorques.at(mHandle) += torque;
+  mStorage->setAwake(mHandle, true);
 }
 
-void RigidBody::addForceToBodyPoint(const glm::vec3 force, const glm::vec3 point) {
-  addForceToWorldPoint(force, convertBodyToWorldSpace(point));
+void RigidBody::setCollisionShape(const collisionShape shape, const glm::vec3 size) {
+  mStorage->setCollisionShape(mHandle, shape, size);
 }
 
-void RigidBody::addForceToWorldPoint(const glm::vec3 force, const glm::vec3 point) {
-  mAccumulatedForce += force;
-  mAccumulatedTorque += glm::cross(point - mPosition, force);
-
-  mIsAwake = true;
+collisionShape RigidBody::getCollisionShape() const {
+  return mStorage->rbShapes.at(mHandle);
 }
 
-glm::vec3 RigidBody::convertBodyToWorldSpace(const glm::vec3 bodyPoint) {
-  return mTransformMatrix * glm::vec4(bodyPoint, 1.0f);
+void RigidBody::setAwake(const bool awake) {
+  mStorage->setAwake(mHandle, awake);
 }
 
-void RigidBody::clearAccumulatedForce() {
-  mAccumulatedForce = glm::vec3(0.0f);
-  mAccumulatedTorque = glm::vec3(0.0f);
+bool RigidBody::isAwake() const {
+  return mStorage->rbIsAwake.at(mHandle);
 }
 
-void RigidBody::calculateDerivedData() {
-  mOrientation = glm::normalize(mOrientation);
-
-  calculateTransformMatrix(mPosition, mOrientation);
-
-  transformInertiaTensorToWorldSpace();
+void RigidBody::addForceToBodyPoint(const glm::vec3 force, const glm::vec3 point) {
+  addForceToWorldPoint(force, mStorage->convertBodyToWorldSpace(mHandle, point));
 }
 
-void RigidBody::calculateTransformMatrix(const glm::vec3& position, const glm::quat& orientation) {
-  /* quaternion delivers rotation part only */
-  mTransformMatrix = glm::mat4_cast(orientation);
-
-  /* add translation to the matrix */
-  mTransformMatrix = glm::translate(mTransformMatrix, position);
+void RigidBody::addForceToWorldPoint(const glm::vec3 force, const glm::vec3 point) {
+  mStorage->addForceToWorldPoint(mHandle, force, point);
 }
 
-void RigidBody::setInertiaTensor(const glm::mat3& tensorMatrix) {
-  mInverseInertiaTensor = glm::inverse(tensorMatrix);
+void RigidBody::clearAccumulatedForce() {
+  mStorage->clearAccumulatedForce(mHandle);
 }
 
-void RigidBody::transformInertiaTensorToWorldSpace() {
-  mInverseInertiaTensorWorldSpace = glm::mat3(mTransformMatrix) * glm::inverse(mInverseInertiaTensor);
+void RigidBody::calculateDerivedData() {
+  mStorage->calculateDerivedData(mHandle);
 }
 
 void RigidBody::integrate(const float deltaTime) {
-  /* infinite mass, don't do anything */
-  if (mInverseMass <= 0.0f) {
-    return;
-  }
-
-  if (deltaTime <= 0.0f) {
-    Logger::log(1, "%s error: deltaTime must be greater than zero\n", __FUNCTION__);
-    return;
-  }
-
-  glm::vec3 mLastFrameAcceleration = mAcceleration;
-
-  glm::vec3 scaledAccumForce = mAccumulatedForce * mInverseMass;
-  mLastFrameAcceleration += scaledAccumForce;
-
-  /* scale acceleration  and add to velocity */
-  glm::vec3 scaledAcceleration = mLastFrameAcceleration * deltaTime;
-  mVelocity += scaledAcceleration;
-
-  /* agular counterpart */
-  glm::vec3 angularAcceleration = glm::vec4(mAccumulatedTorque, 1.0f) * mInverseInertiaTensorWorldSpace;
-  // glm::vec3 angularAcceleration = mInverseInertiaTensorWorldSpace * glm::vec4(mAccumulatedTorque, 1.0f);
-
-  glm::vec3 scaledAngularAccelerateion = angularAcceleration * deltaTime;
-  mRotation += scaledAngularAccelerateion;
-
-  /* apply damping (i.e. drag by air) */
-  mVelocity *= std::pow(mLinearDamping, deltaTime);
-  mRotation *= std::pow(mAngularDamping, deltaTime);
-
-  /* scale the velocity according to the delta time and update position */
-  glm::vec3 scaledVelocity = mVelocity * deltaTime;
-  mPosition += scaledVelocity;
-
-  glm::vec3 scaledRotation = mRotation * deltaTime;
-  glm::quat rotationQuat = glm::normalize(glm::quat(1.0f, scaledRotation));
-  mOrientation *= rotationQuat;
-
-  /* clear summed up force */
-  // now done at the start of a frame
-  // clearAccumulatedForce();
-  // calculateDerivedData();
+  mStorage->integrate(mHandle, deltaTime);
 }
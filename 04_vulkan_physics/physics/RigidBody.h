@@ -1,10 +1,24 @@
 #pragma once
 
+#include <memory>
+
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include "RigidBodyStorage.h"
+
+/* view into a RigidBodyStorage, the body data itself lives in the storage arrays */
 class RigidBody {
   public:
+    /* creates a private storage containing only this body */
+    RigidBody();
+    RigidBody(const std::shared_ptr<RigidBodyStorage> storage, const int handle);
+
+    /* copy the current state to a new slot in the storage and use the new slot afterwards */
+    int moveToStorage(const std::shared_ptr<RigidBodyStorage> storage);
+    std::shared_ptr<RigidBodyStorage> getStorage() const;
+    int getHandle() const;
+
     void integrate(const float deltaTime);
 
     void setPosition(const glm::vec3 pos);
@@ -13,9 +27,20 @@ class RigidBody {
     void setOrientation(const glm::quat orient);
     glm::quat getOrientation() const;
 
+    /* state between the last two physics steps, alpha in [0.0, 1.0] */
+    glm::vec3 getInterpolatedPosition(const float alpha) const;
+    glm::quat getInterpolatedOrientation(const float alpha) const;
+
     void setMass(const float mass);
     float getMass() const;
     bool hasInfiniteMass();
+
+    /* sphere uses the x value as radius, box uses all three values as half size */
+    void setCollisionShape(const collisionShape shape, const glm::vec3 size);
+    collisionShape getCollisionShape() const;
+
+    void setAwake(const bool awake);
+    bool isAwake() const;
     float getInverseMass() const;
 
     void setVelocity(const glm::vec3 velo);
@@ -41,43 +66,6 @@ class RigidBody {
     void calculateDerivedData();
 
   private:
-    void calculateTransformMatrix(const glm::vec3& position, const glm::quat& orientation);
-    void setInertiaTensor(const glm::mat3& tensorMatrix);
-    void transformInertiaTensorToWorldSpace();
-
-    glm::vec3 convertBodyToWorldSpace(const glm::vec3 bodyPoint);
-
-    /* using the inverse of the mass is easier (i.e., inverse zero -> infinit mass) */
-    float mInverseMass = 0.0f;
-
-    /* linear position */
-    glm::vec3 mPosition = glm::vec3(0.0f);
-    /* linear velocity */
-    glm::vec3 mVelocity = glm::vec3(0.0f);
-
-    glm::vec3 mAcceleration = glm::vec3(0.0f);
-
-    float mLinearDamping = 1.0;
-
-    glm::vec3 mAccumulatedForce = glm::vec3(0.0f);
-
-    /* angular orientation */
-    glm::quat mOrientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
-    /* angular velocity */
-    glm::vec3 mRotation = glm::vec3(0.0f);
-
-    float mAngularDamping = 1.0;
-
-    glm::vec3 mAccumulatedTorque = glm::vec3(0.0f);
-
-    /* convert body to world/world to body space */
-    glm::mat4 mTransformMatrix = glm::mat4(1.0f);
-
-    /* store inverse tensor for easier usage, in body space coords */
-    //glm::mat3 mInverseInertiaTensor = glm::mat3(1.0f);
-    glm::mat3 mInverseInertiaTensor = glm::inverse(glm::mat3(1.0f));
-    /* the same tensor in world space coordinates */
-    glm::mat3 mInverseInertiaTensorWorldSpace = glm::inverse(glm::mat3(1.0f));
-
-    bool mIsAwake = true;
+    std::shared_ptr<RigidBodyStorage> mStorage = nullptr;
+    int mHandle = -1;
 };
@@ -0,0 +1,240 @@
+#include <cmath>
+#include <cfloat>
+
+#include "RigidBodyStorage.h"
+#include "Logger.h"
+
+int RigidBodyStorage::addBody() {
+  rbInverseMasses.emplace_back(0.0f);
+
+  rbPositions.emplace_back(glm::vec3(0.0f));
+  rbVelocities.emplace_back(glm::vec3(0.0f));
+  rbAccelerations.emplace_back(glm::vec3(0.0f));
+  rbLinearDampings.emplace_back(1.0f);
+  rbAccumulatedForces.emplace_back(glm::vec3(0.0f));
+
+  rbOrientations.emplace_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+  rbRotations.emplace_back(glm::vec3(0.0f));
+  rbAngularDampings.emplace_back(1.0f);
+  rbAccumulatedTorques.emplace_back(glm::vec3(0.0f));
+
+  rbTransformMatrices.emplace_back(glm::mat4(1.0f));
+
+  rbInverseInertiaTensors.emplace_back(glm::inverse(glm::mat3(1.0f)));
+  rbInertiaTensors.emplace_back(glm::inverse(rbInverseInertiaTensors.back()));
+  rbInverseInertiaTensorsWorldSpace.emplace_back(glm::inverse(glm::mat3(1.0f)));
+
+  rbShapes.emplace_back(collisionShape::none);
+  rbShapeSizes.emplace_back(glm::vec3(0.0f));
+
+  rbPreviousPositions.emplace_back(glm::vec3(0.0f));
+  rbPreviousOrientations.emplace_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+
+  rbIsAwake.emplace_back(1);
+  rbMotions.emplace_back(FLT_MAX);
+
+  return static_cast<int>(rbInverseMasses.size()) - 1;
+}
+
+int RigidBodyStorage::size() const {
+  return static_cast<int>(rbInverseMasses.size());
+}
+
+void RigidBodyStorage::reserve(const int numBodies) {
+  rbInverseMasses.reserve(numBodies);
+
+  rbPositions.reserve(numBodies);
+  rbVelocities.reserve(numBodies);
+  rbAccelerations.reserve(numBodies);
+  rbLinearDampings.reserve(numBodies);
+  rbAccumulatedForces.reserve(numBodies);
+
+  rbOrientations.reserve(numBodies);
+  rbRotations.reserve(numBodies);
+  rbAngularDampings.reserve(numBodies);
+  rbAccumulatedTorques.reserve(numBodies);
+
+  rbTransformMatrices.reserve(numBodies);
+
+  rbInverseInertiaTensors.reserve(numBodies);
+  rbInertiaTensors.reserve(numBodies);
+  rbInverseInertiaTensorsWorldSpace.reserve(numBodies);
+
+  rbShapes.reserve(numBodies);
+  rbShapeSizes.reserve(numBodies);
+
+  rbPreviousPositions.reserve(numBodies);
+  rbPreviousOrientations.reserve(numBodies);
+
+  rbIsAwake.reserve(numBodies);
+  rbMotions.reserve(numBodies);
+}
+
+void RigidBodyStorage::copyBody(const int destHandle, const RigidBodyStorage& source, const int sourceHandle) {
+  if (destHandle < 0 || destHandle >= size() || sourceHandle < 0 || sourceHandle >= source.size()) {
+    Logger::log(1, "%s error: invalid body handle(s) %i and %i\n", __FUNCTION__, destHandle, sourceHandle);
+    return;
+  }
+
+  rbInverseMasses.at(destHandle) = source.rbInverseMasses.at(sourceHandle);
+
+  rbPositions.at(destHandle) = source.rbPositions.at(sourceHandle);
+  rbVelocities.at(destHandle) = source.rbVelocities.at(sourceHandle);
+  rbAccelerations.at(destHandle) = source.rbAccelerations.at(sourceHandle);
+  rbLinearDampings.at(destHandle) = source.rbLinearDampings.at(sourceHandle);
+  rbAccumulatedForces.at(destHandle) = source.rbAccumulatedForces.at(sourceHandle);
+
+  rbOrientations.at(destHandle) = source.rbOrientations.at(sourceHandle);
+  rbRotations.at(destHandle) = source.rbRotations.at(sourceHandle);
+  rbAngularDampings.at(destHandle) = source.rbAngularDampings.at(sourceHandle);
+  rbAccumulatedTorques.at(destHandle) = source.rbAccumulatedTorques.at(sourceHandle);
+
+  rbTransformMatrices.at(destHandle) = source.rbTransformMatrices.at(sourceHandle);
+
+  rbInverseInertiaTensors.at(destHandle) = source.rbInverseInertiaTensors.at(sourceHandle);
+  rbInertiaTensors.at(destHandle) = source.rbInertiaTensors.at(sourceHandle);
+  rbInverseInertiaTensorsWorldSpace.at(destHandle) = source.rbInverseInertiaTensorsWorldSpace.at(sourceHandle);
+
+  rbShapes.at(destHandle) = source.rbShapes.at(sourceHandle);
+  rbShapeSizes.at(destHandle) = source.rbShapeSizes.at(sourceHandle);
+
+  rbPreviousPositions.at(destHandle) = source.rbPreviousPositions.at(sourceHandle);
+  rbPreviousOrientations.at(destHandle) = source.rbPreviousOrientations.at(sourceHandle);
+
+  rbIsAwake.at(destHandle) = source.rbIsAwake.at(sourceHandle);
+  rbMotions.at(destHandle) = source.rbMotions.at(sourceHandle);
+}
+
+bool RigidBodyStorage::hasInfiniteMass(const int handle) const {
+  return rbInverseMasses[handle] <= 0.0f;
+}
+
+void RigidBodyStorage::setAwake(const int handle, const bool awake) {
+  if (awake) {
+    /* give a woken body some time before it can fall asleep again */
+    if (!rbIsAwake[handle]) {
+      rbIsAwake[handle] = 1;
+      rbMotions[handle] = FLT_MAX;
+    }
+    return;
+  }
+
+  rbIsAwake[handle] = 0;
+  rbVelocities[handle] = glm::vec3(0.0f);
+  rbRotations[handle] = glm::vec3(0.0f);
+  clearAccumulatedForce(handle);
+
+  /* no interpolation while sleeping */
+  storePreviousState(handle);
+}
+
+void RigidBodyStorage::setCollisionShape(const int handle, const collisionShape shape, const glm::vec3 size) {
+  rbShapes[handle] = shape;
+  rbShapeSizes[handle] = size;
+}
+
+float RigidBodyStorage::getBoundingRadius(const int handle) const {
+  switch (rbShapes[handle]) {
+    case collisionShape::sphere:
+      return rbShapeSizes[handle].x;
+    case collisionShape::box:
+      return glm::length(rbShapeSizes[handle]);
+    default:
+      return 0.0f;
+  }
+}
+
+bool RigidBodyStorage::isActive(const int handle) const {
+  return rbIsAwake[handle] && rbInverseMasses[handle] > 0.0f;
+}
+
+void RigidBodyStorage::addForce(const int handle, const glm::vec3 force) {
+  rbAccumulatedForces[handle] += force;
+  setAwake(handle, true);
+}
+
+void RigidBodyStorage::addForceToWorldPoint(const int handle, const glm::vec3 force, const glm::vec3 point) {
+  rbAccumulatedForces[handle] += force;
+  rbAccumulatedTorques[handle] += glm::cross(point - rbPositions[handle], force);
+
+  setAwake(handle, true);
+}
+
+glm::vec3 RigidBodyStorage::convertBodyToWorldSpace(const int handle, const glm::vec3 bodyPoint) const {
+  return rbTransformMatrices[handle] * glm::vec4(bodyPoint, 1.0f);
+}
+
+void RigidBodyStorage::clearAccumulatedForce(const int handle) {
+  rbAccumulatedForces[handle] = glm::vec3(0.0f);
+  rbAccumulatedTorques[handle] = glm::vec3(0.0f);
+}
+
+void RigidBodyStorage::setInertiaTensor(const int handle, const glm::mat3& tensorMatrix) {
+  rbInverseInertiaTensors[handle] = glm::inverse(tensorMatrix);
+  rbInertiaTensors[handle] = glm::inverse(rbInverseInertiaTensors[handle]);
+}
+
+void RigidBodyStorage::calculateDerivedData(const int handle) {
+  rbOrientations[handle] = glm::normalize(rbOrientations[handle]);
+
+  /* quaternion delivers rotation part only */
+  rbTransformMatrices[handle] = glm::mat4_cast(rbOrientations[handle]);
+
+  /* add translation to the matrix */
+  rbTransformMatrices[handle] = glm::translate(rbTransformMatrices[handle], rbPositions[handle]);
+
+  /* transform inertia tensor to world space */
+  rbInverseInertiaTensorsWorldSpace[handle] = glm::mat3(rbTransformMatrices[handle]) * rbInertiaTensors[handle];
+}
+
+void RigidBodyStorage::integrate(const int handle, const float deltaTime) {
+  /* infinite mass or sleeping, don't do anything */
+  if (rbInverseMasses[handle] <= 0.0f || !rbIsAwake[handle]) {
+    return;
+  }
+
+  if (deltaTime <= 0.0f) {
+    Logger::log(1, "%s error: deltaTime must be greater than zero\n", __FUNCTION__);
+    return;
+  }
+
+  glm::vec3 lastFrameAcceleration = rbAccelerations[handle];
+
+  glm::vec3 scaledAccumForce = rbAccumulatedForces[handle] * rbInverseMasses[handle];
+  lastFrameAcceleration += scaledAccumForce;
+
+  /* scale acceleration  and add to velocity */
+  glm::vec3 scaledAcceleration = lastFrameAcceleration * deltaTime;
+  rbVelocities[handle] += scaledAcceleration;
+
+  /* agular counterpart */
+  glm::vec3 angularAcceleration = glm::vec4(rbAccumulatedTorques[handle], 1.0f) * rbInverseInertiaTensorsWorldSpace[handle];
+
+  glm::vec3 scaledAngularAccelerateion = angularAcceleration * deltaTime;
+  rbRotations[handle] += scaledAngularAccelerateion;
+
+  /* apply damping (i.e. drag by air) */
+  rbVelocities[handle] *= std::pow(rbLinearDampings[handle], deltaTime);
+  rbRotations[handle] *= std::pow(rbAngularDampings[handle], deltaTime);
+
+  /* scale the velocity according to the delta time and update position */
+  glm::vec3 scaledVelocity = rbVelocities[handle] * deltaTime;
+  rbPositions[handle] += scaledVelocity;
+
+  glm::vec3 scaledRotation = rbRotations[handle] * deltaTime;
+  glm::quat rotationQuat = glm::normalize(glm::quat(1.0f, scaledRotation));
+  rbOrientations[handle] *= rotationQuat;
+}
+
+void RigidBodyStorage::storePreviousState(const int handle) {
+  rbPreviousPositions[handle] = rbPositions[handle];
+  rbPreviousOrientations[handle] = rbOrientations[handle];
+}
+
+glm::vec3 RigidBodyStorage::getInterpolatedPosition(const int handle, const float alpha) const {
+  return glm::mix(rbPreviousPositions[handle], rbPositions[handle], alpha);
+}
+
+glm::quat RigidBodyStorage::getInterpolatedOrientation(const int handle, const float alpha) const {
+  return glm::slerp(rbPreviousOrientations[handle], rbOrientations[handle], alpha);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+/* shape used by the collision detection, bodies without a shape only collide via cables and rods */
+enum class collisionShape : uint8_t {
+  none = 0,
+  sphere,
+  box
+};
+
+/* contiguous structure-of-arrays storage for rigid bodies
+ * a body is addressed by its handle, i.e. the index into the arrays.
+ * bodies are never removed, so handles stay valid for the lifetime of the storage */
+struct RigidBodyStorage {
+  int addBody();
+  int size() const;
+  void reserve(const int numBodies);
+
+  /* copy complete state from a body in another storage */
+  void copyBody(const int destHandle, const RigidBodyStorage& source, const int sourceHandle);
+
+  bool hasInfiniteMass(const int handle) const;
+
+  /* sphere uses the x value as radius, box uses all three values as half size */
+  void setCollisionShape(const int handle, const collisionShape shape, const glm::vec3 size);
+  /* radius of a sphere around the body containing the complete shape */
+  float getBoundingRadius(const int handle) const;
+
+  /* sleeping bodies are not integrated, putting a body to sleep also stops it */
+  void setAwake(const int handle, const bool awake);
+  /* awake and not of infinite mass */
+  bool isActive(const int handle) const;
+
+  void addForce(const int handle, const glm::vec3 force);
+  void addForceToWorldPoint(const int handle, const glm::vec3 force, const glm::vec3 point);
+  glm::vec3 convertBodyToWorldSpace(const int handle, const glm::vec3 bodyPoint) const;
+  void clearAccumulatedForce(const int handle);
+
+  void setInertiaTensor(const int handle, const glm::mat3& tensorMatrix);
+  void calculateDerivedData(const int handle);
+  void integrate(const int handle, const float deltaTime);
+
+  /* remember the current state before the next physics step */
+  void storePreviousState(const int handle);
+  glm::vec3 getInterpolatedPosition(const int handle, const float alpha) const;
+  glm::quat getInterpolatedOrientation(const int handle, const float alpha) const;
+
+  /* using the inverse of the mass is easier (i.e., inverse zero -> infinit mass) */
+  std::vector<float> rbInverseMasses{};
+
+  /* linear position, velocity and acceleration */
+  std::vector<glm::vec3> rbPositions{};
+  std::vector<glm::vec3> rbVelocities{};
+  std::vector<glm::vec3> rbAccelerations{};
+  std::vector<float> rbLinearDampings{};
+  std::vector<glm::vec3> rbAccumulatedForces{};
+
+  /* angular orientation and velocity */
+  std::vector<glm::quat> rbOrientations{};
+  std::vector<glm::vec3> rbRotations{};
+  std::vector<float> rbAngularDampings{};
+  std::vector<glm::vec3> rbAccumulatedTorques{};
+
+  /* convert body to world/world to body space */
+  std::vector<glm::mat4> rbTransformMatrices{};
+
+  /* store inverse tensor for easier usage, in body space coords */
+  std::vector<glm::mat3> rbInverseInertiaTensors{};
+  /* inverse of the inverse tensor, cached to avoid the inversion in every calculateDerivedData() */
+  std::vector<glm::mat3> rbInertiaTensors{};
+  /* the same tensor in world space coordinates */
+  std::vector<glm::mat3> rbInverseInertiaTensorsWorldSpace{};
+
+  /* collision shape and size */
+  std::vector<collisionShape> rbShapes{};
+  std::vector<glm::vec3> rbShapeSizes{};
+
+  /* state before the last physics step, used to interpolate between steps for drawing */
+  std::vector<glm::vec3> rbPreviousPositions{};
+  std::vector<glm::quat> rbPreviousOrientations{};
+
+  /* no std::vector<bool> here, we need addressable elements */
+  std::vector<uint8_t> rbIsAwake{};
+  /* recency-weighted average of the squared velocities, used to find resting bodies */
+  std::vector<float> rbMotions{};
+};
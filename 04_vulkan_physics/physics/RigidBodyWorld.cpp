@@ -2,53 +2,189 @@
 #include <algorithm>
 
 #include "Logger.h"
-#include "ContactCable.h"
-#include "ContactRod.h"
 
 RigidBodyWorld::RigidBodyWorld(const unsigned int maxContacts, const unsigned int numIterations) : mMaxContacts(maxContacts), mNumIterations(numIterations) {
   mResolver = std::make_shared<ContactResolver>(numIterations);
+  mBodyStorage = std::make_shared<RigidBodyStorage>();
 
   /* resize and init array */
   mBodyContacts.resize(maxContacts);
-  for (auto& contact: mBodyContacts){
-    contact = std::make_shared<BodyContact>();
-  }
 }
 
 /* clear accumulated forces of all bodies */
 void RigidBodyWorld::startFrame() {
-  for (auto& body : mBodies) {
-    body->clearAccumulatedForce();
-    body->calculateDerivedData();
+  for (int i = 0; i < mBodyStorage->size(); ++i) {
+    /* sleeping bodies were cleared when falling asleep */
+    if (!mBodyStorage->rbIsAwake[i]) {
+      continue;
+    }
+    mBodyStorage->storePreviousState(i);
+    mBodyStorage->clearAccumulatedForce(i);
+    mBodyStorage->calculateDerivedData(i);
   }
 }
 
 void RigidBodyWorld::integrate(const float deltaTime) {
-  for (auto& body : mBodies) {
-    body->integrate(deltaTime);
-  }
+  mIntegrator.integrate(*mBodyStorage, deltaTime);
 }
 
-void RigidBodyWorld::runPhysics(VkRenderData& renderData, const float deltaTime) {
+void RigidBodyWorld::runPhysics(const float deltaTime) {
+  if (mIslandsDirty) {
+    std::vector<std::array<int, 2>> links;
+    mCables.getLinks(links);
+    mRods.getLinks(links);
+    mIslands.build(*mBodyStorage, links);
+    mIslandsDirty = false;
+  }
+
+  /* forces may have woken up single bodies */
+  mIslands.wakeUpIslands(*mBodyStorage);
+
   integrate(deltaTime);
 
-  unsigned int usedContacts = generateContacts();
-  renderData.rdContactsIssued = usedContacts;
+  if (mPositionBasedLinks) {
+    if (mDistanceConstraintsDirty) {
+      mDistanceSolver.clear();
+      mCables.addDistanceConstraints(mDistanceSolver);
+      mRods.addDistanceConstraints(mDistanceSolver);
+      mDistanceConstraintsDirty = false;
+    }
+    mDistanceSolver.solveConstraints(*mBodyStorage, deltaTime);
+  }
 
-  if (usedContacts) {
+  mUsedContacts = generateContacts();
+  mUsedIterations = 0;
+
+  if (mContactSolver == contactSolver::sequentialImpulse) {
+    /* called without contacts too, to drop the impulses of the last frame */
+    mUsedIterations = mImpulseSolver.resolveContacts(*mBodyStorage, mBodyContacts, mUsedContacts, deltaTime);
+  } else if (mUsedContacts) {
     if (!mNumIterations) {
-      mResolver->setIterations(usedContacts * 2);
+      mResolver->setIterations(mUsedContacts * 2);
     }
-    renderData.rdContactResolverIterations = mResolver->resolveContacts(mBodyContacts, usedContacts, deltaTime);
+    mUsedIterations = mResolver->resolveContacts(*mBodyStorage, mBodyContacts, mUsedContacts, mContactAdjacency, deltaTime);
+  }
+
+  mIslands.updateSleepState(*mBodyStorage, deltaTime, mSleepEpsilon);
+}
+
+void RigidBodyWorld::setFixedTimeStep(const float timeStep, const unsigned int maxSubSteps) {
+  if (timeStep <= 0.0f || maxSubSteps == 0) {
+    Logger::log(1, "%s error: invalid time step %f or max sub steps %i\n", __FUNCTION__, timeStep, maxSubSteps);
+    return;
+  }
+
+  mFixedTimeStep = timeStep;
+  mMaxSubSteps = maxSubSteps;
+}
+
+unsigned int RigidBodyWorld::accumulateTime(const float deltaTime) {
+  mAccumulatedTime += deltaTime;
+
+  unsigned int numSteps = static_cast<unsigned int>(mAccumulatedTime / mFixedTimeStep);
+  if (numSteps > mMaxSubSteps) {
+    /* we can't catch up, drop the remaining time instead of doing even more steps next frame */
+    numSteps = mMaxSubSteps;
+    mAccumulatedTime = numSteps * mFixedTimeStep;
   }
+
+  mAccumulatedTime -= numSteps * mFixedTimeStep;
+  return numSteps;
+}
+
+float RigidBodyWorld::getFixedTimeStep() const {
+  return mFixedTimeStep;
+}
+
+float RigidBodyWorld::getInterpolationFactor() const {
+  return glm::clamp(mAccumulatedTime / mFixedTimeStep, 0.0f, 1.0f);
+}
+
+unsigned int RigidBodyWorld::getNumContacts() const {
+  return mUsedContacts;
+}
+
+unsigned int RigidBodyWorld::getNumResolverIterations() const {
+  return mUsedIterations;
+}
+
+unsigned int RigidBodyWorld::getNumAwakeBodies() const {
+  return mIslands.getNumAwakeBodies();
+}
+
+unsigned int RigidBodyWorld::getNumIslands() const {
+  return mIslands.getNumIslands();
+}
+
+unsigned int RigidBodyWorld::getNumAwakeIslands() const {
+  return mIslands.getNumAwakeIslands();
+}
+
+void RigidBodyWorld::setSleepEpsilon(const float epsilon) {
+  mSleepEpsilon = epsilon;
+}
+
+void RigidBodyWorld::setNumResolverThreads(const unsigned int numThreads) {
+  mResolver->setNumThreads(numThreads);
+}
+
+void RigidBodyWorld::setContactSolver(const contactSolver solver) {
+  if (solver == mContactSolver) {
+    return;
+  }
+
+  /* cached impulses are outdated after running the other solver */
+  if (solver == contactSolver::sequentialImpulse) {
+    mImpulseSolver.clearImpulseCache();
+  }
+  mContactSolver = solver;
+}
+
+void RigidBodyWorld::setImpulseSolverIterations(const unsigned int velocityIterations, const unsigned int positionIterations) {
+  mImpulseSolver.setIterations(velocityIterations, positionIterations);
+}
+
+void RigidBodyWorld::setImpulseSolverWarmStarting(const bool enable) {
+  mImpulseSolver.setWarmStarting(enable);
+}
+
+void RigidBodyWorld::setPositionBasedLinks(const bool enable) {
+  if (enable == mPositionBasedLinks) {
+    return;
+  }
+
+  /* the impulses of the link contacts are outdated after running the position based solver */
+  if (!enable) {
+    mImpulseSolver.clearImpulseCache();
+  }
+  mPositionBasedLinks = enable;
+}
+
+void RigidBodyWorld::setPositionBasedIterations(const unsigned int numIterations) {
+  mDistanceSolver.setIterations(numIterations);
+}
+
+std::shared_ptr<RigidBody> RigidBodyWorld::createRigidBody() {
+  std::shared_ptr<RigidBody> newBody = std::make_shared<RigidBody>(mBodyStorage, mBodyStorage->addBody());
+  mBodies.emplace_back(newBody);
+  mIslandsDirty = true;
+  return newBody;
 }
 
 void RigidBodyWorld::addRigidBody(const std::shared_ptr<RigidBody> newBody) {
+  if (newBody->getStorage() == mBodyStorage) {
+    Logger::log(1, "%s error: rigid body already added to world\n", __FUNCTION__);
+    return;
+  }
+
+  /* move body data into our arrays, existing views of the body stay valid */
+  newBody->moveToStorage(mBodyStorage);
   mBodies.emplace_back(newBody);
+  mIslandsDirty = true;
 }
 
 std::shared_ptr<RigidBody> RigidBodyWorld::getRigidBody(const unsigned int index) {
-  if (index > mBodies.size()) {
+  if (index >= mBodies.size()) {
     Logger::log(1, "%s error: tried to access non-existing rigid body\n", __FUNCTION__);
     return nullptr;
   }
@@ -56,49 +192,80 @@ std::shared_ptr<RigidBody> RigidBodyWorld::getRigidBody(const unsigned int index
   return mBodies.at(index);
 }
 
-bool RigidBodyWorld::addCableContact(const std::shared_ptr<RigidBody> firstBody, const std::shared_ptr<RigidBody> secondBody, const float length, const float restitutionFactor) {
-  if (std::find(mBodies.begin(), mBodies.end(), firstBody) == mBodies.end() || std::find(mBodies.begin(), mBodies.end(), secondBody) == mBodies.end()) {
-    Logger::log(1, "%s error: could not find the rigid bodies in mBodies vector\n", __FUNCTION__);
+std::shared_ptr<RigidBodyStorage> RigidBodyWorld::getRigidBodyStorage() {
+  return mBodyStorage;
+}
+
+unsigned int RigidBodyWorld::getNumRigidBodies() const {
+  return mBodies.size();
+}
+
+bool RigidBodyWorld::addCableContact(const std::shared_ptr<RigidBody> firstBody, const std::shared_ptr<RigidBody> secondBody, const float length, const float restitutionFactor, const float compliance) {
+  if (firstBody->getStorage() != mBodyStorage || secondBody->getStorage() != mBodyStorage) {
+    Logger::log(1, "%s error: rigid bodies were not added to the world\n", __FUNCTION__);
     return false;
   }
 
-  std::shared_ptr<ContactCable> cable = std::make_shared<ContactCable>(length, restitutionFactor);
-  cable->addBodies(firstBody, secondBody);
-
-  mContactGenerators.emplace_back(cable);
+  mCables.addCable(firstBody->getHandle(), secondBody->getHandle(), length, restitutionFactor, compliance);
+  mIslandsDirty = true;
+  mDistanceConstraintsDirty = true;
+  Logger::log(1, "%s: added bodies with mass %f and %f to cable\n", __FUNCTION__, firstBody->getMass(), secondBody->getMass());
 
   return true;
 }
 
-bool RigidBodyWorld::addRodContact(const std::shared_ptr<RigidBody> firstBody, const std::shared_ptr<RigidBody> secondBody, const float length) {
-  if (std::find(mBodies.begin(), mBodies.end(), firstBody) == mBodies.end() || std::find(mBodies.begin(), mBodies.end(), secondBody) == mBodies.end()) {
-    Logger::log(1, "%s error: could not find the rigid bodies in mBodies vector\n", __FUNCTION__);
+bool RigidBodyWorld::addRodContact(const std::shared_ptr<RigidBody> firstBody, const std::shared_ptr<RigidBody> secondBody, const float length, const float compliance) {
+  if (firstBody->getStorage() != mBodyStorage || secondBody->getStorage() != mBodyStorage) {
+    Logger::log(1, "%s error: rigid bodies were not added to the world\n", __FUNCTION__);
     return false;
   }
 
-  std::shared_ptr<ContactRod> rod = std::make_shared<ContactRod>(length);
-  rod->addBodies(firstBody, secondBody);
-
-  mContactGenerators.emplace_back(rod);
+  mRods.addRod(firstBody->getHandle(), secondBody->getHandle(), length, compliance);
+  mIslandsDirty = true;
+  mDistanceConstraintsDirty = true;
+  Logger::log(1, "%s: added bodies with mass %f and %f to rod\n", __FUNCTION__, firstBody->getMass(), secondBody->getMass());
 
   return true;
 }
 
-unsigned int RigidBodyWorld::generateContacts() {
-  unsigned int limit = mMaxContacts;
-  unsigned int contactIndex = 0;
+void RigidBodyWorld::addCollisionPlane(const glm::vec3 normal, const float offset) {
+  CollisionPlane plane;
+  plane.cpNormal = glm::normalize(normal);
+  plane.cpOffset = offset;
+  mCollisionPlanes.emplace_back(plane);
+}
 
-  for (auto& generator : mContactGenerators) {
-    unsigned int newContacts = generator->addContact(mBodyContacts.at(contactIndex), limit);
-    limit -= newContacts;
-    contactIndex += newContacts;
+void RigidBodyWorld::setCollisionCellSize(const float cellSize) {
+  mBroadphase.setCellSize(cellSize);
+}
 
-    /* over limit, stop iterating  */
-    if (limit <= 0 ) {
-      break;
-    }
+void RigidBodyWorld::setCollisionRestitution(const float restitution) {
+  mCollisionDetector.setRestitution(restitution);
+}
+
+unsigned int RigidBodyWorld::getNumCollisionPairs() const {
+  return mCollisionPairs.size();
+}
+
+unsigned int RigidBodyWorld::generateContacts() {
+  unsigned int numContacts = 0;
+
+  /* every batch stops on its own when the limit is reached
+   * cables and rods are already solved as position constraints in position based mode */
+  if (!mPositionBasedLinks) {
+    numContacts += mCables.addContacts(*mBodyStorage, mBodyContacts.data() + numContacts, mMaxContacts - numContacts);
+    numContacts += mRods.addContacts(*mBodyStorage, mBodyContacts.data() + numContacts, mMaxContacts - numContacts);
   }
 
+  numContacts += mCollisionDetector.addPlaneContacts(*mBodyStorage, mCollisionPlanes,
+    mBodyContacts.data() + numContacts, mMaxContacts - numContacts);
+
+  mBroadphase.findPairs(*mBodyStorage, mCollisionPairs);
+  numContacts += mCollisionDetector.addPairContacts(*mBodyStorage, mCollisionPairs,
+    mBodyContacts.data() + numContacts, mMaxContacts - numContacts);
+
+  mContactAdjacency.build(mBodyStorage->size(), mBodyContacts, numContacts);
+
   /* return number of contacts generated*/
-  return mMaxContacts - limit;
+  return numContacts;
 }
@@ -4,11 +4,24 @@
 #include <memory>
 
 #include "RigidBody.h"
+#include "RigidBodyStorage.h"
+#include "BodyIntegrator.h"
 #include "BodyContact.h"
 #include "ContactResolver.h"
-#include "IContactGenerator.h"
+#include "SequentialImpulseSolver.h"
+#include "DistanceConstraintSolver.h"
+#include "ContactAdjacency.h"
+#include "SimulationIslands.h"
+#include "SpatialHashBroadphase.h"
+#include "CollisionDetector.h"
+#include "ContactCableBatch.h"
+#include "ContactRodBatch.h"
 
-#include "VkRenderData.h"
+/* priority queue resolves the worst contact per iteration, sequential impulse sweeps over all contacts */
+enum class contactSolver : uint8_t {
+  priorityQueue = 0,
+  sequentialImpulse
+};
 
 class RigidBodyWorld {
   public:
@@ -17,26 +30,100 @@ class RigidBodyWorld {
 
     void integrate(const float deltaTime);
     unsigned int generateContacts();
-    void runPhysics(VkRenderData& renderData, const float deltaTime);
+    void runPhysics(const float deltaTime);
+
+    /* fixed step simulation: add the frame time, run the returned number of steps with
+     * getFixedTimeStep() and draw the bodies interpolated by getInterpolationFactor() */
+    void setFixedTimeStep(const float timeStep, const unsigned int maxSubSteps);
+    unsigned int accumulateTime(const float deltaTime);
+    float getFixedTimeStep() const;
+    float getInterpolationFactor() const;
+
+    /* statistics of the last runPhysics() call */
+    unsigned int getNumContacts() const;
+    unsigned int getNumResolverIterations() const;
+    unsigned int getNumAwakeBodies() const;
+    unsigned int getNumIslands() const;
+    unsigned int getNumAwakeIslands() const;
+
+    /* islands with less motion (squared linear plus angular velocity) fall asleep, zero disables sleeping */
+    void setSleepEpsilon(const float epsilon);
+
+    /* independent contact islands are resolved in parallel, one thread disables the worker threads */
+    void setNumResolverThreads(const unsigned int numThreads);
+
+    /* can be switched between two steps */
+    void setContactSolver(const contactSolver solver);
+    void setImpulseSolverIterations(const unsigned int velocityIterations, const unsigned int positionIterations);
+    void setImpulseSolverWarmStarting(const bool enable);
+
+    /* solve cables and rods with the position based solver instead of generating contacts for them,
+     * restitution of the cables is ignored in this mode */
+    void setPositionBasedLinks(const bool enable);
+    void setPositionBasedIterations(const unsigned int numIterations);
 
+    /* create a new body directly inside the world storage */
+    std::shared_ptr<RigidBody> createRigidBody();
     void addRigidBody(const std::shared_ptr<RigidBody> newBody);
 
-    bool addCableContact(const std::shared_ptr< RigidBody > firstBody, const std::shared_ptr< RigidBody > secondBody, const float length, const float restitutionFactor);
+    /* compliance (inverse stiffness) is used by the position based solver only */
+    bool addCableContact(const std::shared_ptr< RigidBody > firstBody, const std::shared_ptr< RigidBody > secondBody, const float length, const float restitutionFactor, const float compliance = 0.0f);
 
-    bool addRodContact(const std::shared_ptr< RigidBody > firstBody, const std::shared_ptr< RigidBody > secondBody, const float length);
+    bool addRodContact(const std::shared_ptr< RigidBody > firstBody, const std::shared_ptr< RigidBody > secondBody, const float length, const float compliance = 0.0f);
+
+    /* collisions between bodies with a collision shape, and against static planes */
+    void addCollisionPlane(const glm::vec3 normal, const float offset);
+    void setCollisionCellSize(const float cellSize);
+    void setCollisionRestitution(const float restitution);
+    unsigned int getNumCollisionPairs() const;
 
     std::shared_ptr<RigidBody> getRigidBody(const unsigned int index);
+    std::shared_ptr<RigidBodyStorage> getRigidBodyStorage();
+    unsigned int getNumRigidBodies() const;
 
   private:
     std::shared_ptr<ContactResolver> mResolver = nullptr;
+    SequentialImpulseSolver mImpulseSolver{};
+    contactSolver mContactSolver = contactSolver::priorityQueue;
+
+    /* cables and rods as position constraints, rebuilt after adding links */
+    DistanceConstraintSolver mDistanceSolver{};
+    bool mPositionBasedLinks = false;
+    bool mDistanceConstraintsDirty = true;
 
+    /* body data for all bodies of the world, kept in contiguous arrays */
+    std::shared_ptr<RigidBodyStorage> mBodyStorage = nullptr;
+    /* views into the storage, used only by the external API */
     std::vector<std::shared_ptr<RigidBody>> mBodies{};
-    /* stores the contact generators, (like a cable, containing the two connected bodies) */
-    std::vector<std::shared_ptr<IContactGenerator>> mContactGenerators{};
+    /* integrates all awake bodies in one batch */
+    BodyIntegrator mIntegrator{};
+    /* contact generators, grouped by type (like a cable, containing the two connected bodies) */
+    ContactCableBatch mCables{};
+    ContactRodBatch mRods{};
+
+    /* stores generated contacts, preallocated to the max number of contacts */
+    std::vector<BodyContact> mBodyContacts{};
+    /* contacts per body, rebuilt together with the contacts */
+    ContactAdjacency mContactAdjacency{};
 
-    /* stores generated contacts */
-    std::vector<std::shared_ptr<BodyContact>> mBodyContacts{};
+    /* collision detection, broadphase pairs are kept to avoid allocations */
+    SpatialHashBroadphase mBroadphase{};
+    CollisionDetector mCollisionDetector{};
+    std::vector<CollisionPlane> mCollisionPlanes{};
+    std::vector<std::array<int, 2>> mCollisionPairs{};
+
+    /* bodies connected by cables and rods, rebuilt after adding bodies or links */
+    SimulationIslands mIslands{};
+    bool mIslandsDirty = true;
+    float mSleepEpsilon = 0.3f;
 
     unsigned int mMaxContacts = 0;
     unsigned int mNumIterations = 0;
+
+    float mFixedTimeStep = 1.0f / 60.0f;
+    unsigned int mMaxSubSteps = 5;
+    float mAccumulatedTime = 0.0f;
+
+    unsigned int mUsedContacts = 0;
+    unsigned int mUsedIterations = 0;
 };
@@ -0,0 +1,252 @@
+#include "SequentialImpulseSolver.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Logger.h"
+
+void SequentialImpulseSolver::setIterations(const unsigned int velocityIterations, const unsigned int positionIterations) {
+  mVelocityIterations = velocityIterations;
+  mPositionIterations = positionIterations;
+}
+
+void SequentialImpulseSolver::setTolerances(const float velocityTolerance, const float positionTolerance) {
+  if (velocityTolerance < 0.0f || positionTolerance < 0.0f) {
+    Logger::log(1, "%s error: tolerances must not be negative\n", __FUNCTION__);
+    return;
+  }
+
+  mVelocityTolerance = velocityTolerance;
+  mPositionTolerance = positionTolerance;
+}
+
+void SequentialImpulseSolver::setWarmStarting(const bool enable) {
+  mWarmStarting = enable;
+
+  if (!mWarmStarting) {
+    clearImpulseCache();
+  }
+}
+
+void SequentialImpulseSolver::clearImpulseCache() {
+  mCachedKeys.clear();
+  mCachedImpulses.clear();
+}
+
+unsigned int SequentialImpulseSolver::getNumUsedIterations() const {
+  return mUsedIterations;
+}
+
+glm::vec3 SequentialImpulseSolver::findCachedImpulse(const uint64_t sourceKey) {
+  if (mCacheLookupPos < mCachedKeys.size() && mCachedKeys[mCacheLookupPos] == sourceKey) {
+    return mCachedImpulses[mCacheLookupPos++];
+  }
+
+  auto keyIter = std::lower_bound(mCachedKeys.begin(), mCachedKeys.end(), sourceKey);
+  if (keyIter == mCachedKeys.end() || *keyIter != sourceKey) {
+    return glm::vec3(0.0f);
+  }
+  mCacheLookupPos = std::distance(mCachedKeys.begin(), keyIter) + 1;
+  return mCachedImpulses[mCacheLookupPos - 1];
+}
+
+void SequentialImpulseSolver::applyImpulse(RigidBodyStorage& bodies, const BodyContact& contact, const float impulse) const {
+  glm::vec3 impulseVector = contact.getContactNormal() * impulse;
+
+  int firstBody = contact.getBody(0);
+  if (bodies.rbInverseMasses[firstBody] > 0.0f) {
+    bodies.rbVelocities[firstBody] += impulseVector * bodies.rbInverseMasses[firstBody];
+  }
+
+  /* the opposite body gets a negative velocity */
+  int secondBody = contact.getBody(1);
+  if (secondBody >= 0 && bodies.rbInverseMasses[secondBody] > 0.0f) {
+    bodies.rbVelocities[secondBody] -= impulseVector * bodies.rbInverseMasses[secondBody];
+  }
+}
+
+void SequentialImpulseSolver::prepareContacts(RigidBodyStorage& bodies, const std::vector<BodyContact>& contacts,
+    const unsigned int numContacts, const float deltaTime) {
+  mCacheLookupPos = 0;
+  mInverseMassSums.resize(numContacts);
+  mTargetVelocities.resize(numContacts);
+  mAccumulatedImpulses.resize(numContacts);
+
+  if (mBodyCorrections.size() < static_cast<size_t>(bodies.size())) {
+    mBodyCorrections.resize(bodies.size());
+  }
+
+  for (unsigned int i = 0; i < numContacts; ++i) {
+    const BodyContact& contact = contacts.at(i);
+    int firstBody = contact.getBody(0);
+    int secondBody = contact.getBody(1);
+
+    /* a contact with an awake body wakes up the other body */
+    float totalInverseMass = bodies.rbInverseMasses[firstBody];
+    if (!bodies.hasInfiniteMass(firstBody)) {
+      bodies.setAwake(firstBody, true);
+    }
+    mBodyCorrections[firstBody] = glm::vec3(0.0f);
+
+    if (secondBody >= 0) {
+      totalInverseMass += bodies.rbInverseMasses[secondBody];
+      if (!bodies.hasInfiniteMass(secondBody)) {
+        bodies.setAwake(secondBody, true);
+      }
+      mBodyCorrections[secondBody] = glm::vec3(0.0f);
+    }
+    mInverseMassSums[i] = totalInverseMass;
+
+    /* bounce back from the closing velocity before any impulse is applied,
+     * minus the velocity built up by acceleration in this frame, like in BodyContact::resolveVelocity() */
+    float separatingVelocity = contact.calculateSeparatingVelocity(bodies);
+    float targetVelocity = 0.0f;
+    if (separatingVelocity < 0.0f) {
+      targetVelocity = -separatingVelocity * contact.getRestitutionCoeff();
+
+      glm::vec3 accumulatedVelocity = bodies.rbAccelerations[firstBody];
+      if (secondBody >= 0) {
+        accumulatedVelocity -= bodies.rbAccelerations[secondBody];
+      }
+      float accumulatedSeparationVelocity = glm::dot(accumulatedVelocity, contact.getContactNormal()) * deltaTime;
+      if (accumulatedSeparationVelocity < 0.0f) {
+        targetVelocity = std::max(targetVelocity + contact.getRestitutionCoeff() * accumulatedSeparationVelocity, 0.0f);
+      }
+    }
+    mTargetVelocities[i] = targetVelocity;
+
+    /* start with the impulse of the last frame, along the current normal and never pulling */
+    float impulse = 0.0f;
+    if (mWarmStarting && totalInverseMass > 0.0f) {
+      impulse = std::max(glm::dot(findCachedImpulse(contact.getSourceKey()), contact.getContactNormal()), 0.0f);
+      applyImpulse(bodies, contact, impulse);
+    }
+    mAccumulatedImpulses[i] = impulse;
+  }
+}
+
+unsigned int SequentialImpulseSolver::solveVelocities(RigidBodyStorage& bodies, const std::vector<BodyContact>& contacts,
+    const unsigned int numContacts) {
+  unsigned int usedIterations = 0;
+
+  while (usedIterations < mVelocityIterations) {
+    float maxVelocityChange = 0.0f;
+
+    for (unsigned int i = 0; i < numContacts; ++i) {
+      /* infinite masses, do nothing */
+      if (mInverseMassSums[i] <= 0.0f) {
+        continue;
+      }
+
+      const BodyContact& contact = contacts.at(i);
+      float separatingVelocity = contact.calculateSeparatingVelocity(bodies);
+      float deltaImpulse = (mTargetVelocities[i] - separatingVelocity) / mInverseMassSums[i];
+
+      /* the sum of all impulses of the contact may only push the bodies apart */
+      float newImpulse = std::max(mAccumulatedImpulses[i] + deltaImpulse, 0.0f);
+      deltaImpulse = newImpulse - mAccumulatedImpulses[i];
+      mAccumulatedImpulses[i] = newImpulse;
+
+      applyImpulse(bodies, contact, deltaImpulse);
+      maxVelocityChange = std::max(maxVelocityChange, std::fabs(deltaImpulse) * mInverseMassSums[i]);
+    }
+
+    ++usedIterations;
+    if (maxVelocityChange <= mVelocityTolerance) {
+      break;
+    }
+  }
+  return usedIterations;
+}
+
+unsigned int SequentialImpulseSolver::solvePositions(RigidBodyStorage& bodies, const std::vector<BodyContact>& contacts,
+    const unsigned int numContacts) {
+  unsigned int usedIterations = 0;
+
+  while (usedIterations < mPositionIterations) {
+    float maxInterPenetration = 0.0f;
+
+    for (unsigned int i = 0; i < numContacts; ++i) {
+      if (mInverseMassSums[i] <= 0.0f) {
+        continue;
+      }
+
+      const BodyContact& contact = contacts.at(i);
+      int firstBody = contact.getBody(0);
+      int secondBody = contact.getBody(1);
+      glm::vec3 contactNormal = contact.getContactNormal();
+
+      /* penetration left after the corrections of this frame */
+      glm::vec3 relativeCorrection = mBodyCorrections[firstBody];
+      if (secondBody >= 0) {
+        relativeCorrection -= mBodyCorrections[secondBody];
+      }
+      float interPenetration = contact.getInterPenetration() - glm::dot(relativeCorrection, contactNormal);
+      if (interPenetration <= 0.0f) {
+        continue;
+      }
+      maxInterPenetration = std::max(maxInterPenetration, interPenetration);
+
+      /* move the bodies apart, proportional to the inverse masses */
+      glm::vec3 movePerInverseMass = contactNormal * (interPenetration / mInverseMassSums[i]);
+      if (bodies.rbInverseMasses[firstBody] > 0.0f) {
+        glm::vec3 movement = movePerInverseMass * bodies.rbInverseMasses[firstBody];
+        bodies.rbPositions[firstBody] += movement;
+        mBodyCorrections[firstBody] += movement;
+      }
+      if (secondBody >= 0 && bodies.rbInverseMasses[secondBody] > 0.0f) {
+        glm::vec3 movement = movePerInverseMass * -bodies.rbInverseMasses[secondBody];
+        bodies.rbPositions[secondBody] += movement;
+        mBodyCorrections[secondBody] += movement;
+      }
+    }
+
+    ++usedIterations;
+    if (maxInterPenetration <= mPositionTolerance) {
+      break;
+    }
+  }
+  return usedIterations;
+}
+
+void SequentialImpulseSolver::storeImpulses(const std::vector<BodyContact>& contacts, const unsigned int numContacts) {
+  mSortOrder.resize(numContacts);
+  for (unsigned int i = 0; i < numContacts; ++i) {
+    mSortOrder[i] = i;
+  }
+  auto isLess = [&](const unsigned int first, const unsigned int second) {
+    return contacts.at(first).getSourceKey() < contacts.at(second).getSourceKey();
+  };
+
+  /* the generators usually create the contacts already ordered by their keys */
+  if (!std::is_sorted(mSortOrder.begin(), mSortOrder.end(), isLess)) {
+    std::sort(mSortOrder.begin(), mSortOrder.end(), isLess);
+  }
+
+  mCachedKeys.resize(numContacts);
+  mCachedImpulses.resize(numContacts);
+  for (unsigned int i = 0; i < numContacts; ++i) {
+    const BodyContact& contact = contacts.at(mSortOrder[i]);
+    mCachedKeys[i] = contact.getSourceKey();
+    mCachedImpulses[i] = contact.getContactNormal() * mAccumulatedImpulses[mSortOrder[i]];
+  }
+}
+
+unsigned int SequentialImpulseSolver::resolveContacts(RigidBodyStorage& bodies, std::vector<BodyContact>& contacts,
+    const unsigned int numContacts, const float deltaTime) {
+  mUsedIterations = 0;
+
+  if (numContacts == 0) {
+    clearImpulseCache();
+    return mUsedIterations;
+  }
+
+  prepareContacts(bodies, contacts, numContacts, deltaTime);
+  mUsedIterations += solveVelocities(bodies, contacts, numContacts);
+  mUsedIterations += solvePositions(bodies, contacts, numContacts);
+
+  if (mWarmStarting) {
+    storeImpulses(contacts, numContacts);
+  }
+  return mUsedIterations;
+}
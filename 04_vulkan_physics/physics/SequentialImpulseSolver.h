@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "BodyContact.h"
+#include "RigidBodyStorage.h"
+
+/* projected Gauss-Seidel solver, sweeps over all contacts in every iteration
+ * the impulse of every contact is accumulated over the sweeps and clamped to push only,
+ * and the final impulses are used as a starting point for the same contacts in the next frame */
+class SequentialImpulseSolver {
+  public:
+    /* maximum number of velocity and position sweeps, both stop early when the error is small enough */
+    void setIterations(const unsigned int velocityIterations, const unsigned int positionIterations);
+    void setTolerances(const float velocityTolerance, const float positionTolerance);
+    void setWarmStarting(const bool enable);
+    /* forget the impulses of the last frame */
+    void clearImpulseCache();
+
+    unsigned int getNumUsedIterations() const;
+
+    /* only work on up to numContacts contacts, the remaining entries may be invalid */
+    unsigned int resolveContacts(RigidBodyStorage& bodies, std::vector<BodyContact>& contacts, const unsigned int numContacts,
+      const float deltaTime);
+
+  private:
+    void prepareContacts(RigidBodyStorage& bodies, const std::vector<BodyContact>& contacts, const unsigned int numContacts,
+      const float deltaTime);
+    unsigned int solveVelocities(RigidBodyStorage& bodies, const std::vector<BodyContact>& contacts, const unsigned int numContacts);
+    unsigned int solvePositions(RigidBodyStorage& bodies, const std::vector<BodyContact>& contacts, const unsigned int numContacts);
+    void storeImpulses(const std::vector<BodyContact>& contacts, const unsigned int numContacts);
+
+    /* impulse of the same contact in the last frame, zero if the contact is new */
+    glm::vec3 findCachedImpulse(const uint64_t sourceKey);
+    void applyImpulse(RigidBodyStorage& bodies, const BodyContact& contact, const float impulse) const;
+
+    unsigned int mVelocityIterations = 10;
+    unsigned int mPositionIterations = 10;
+    float mVelocityTolerance = 0.001f;
+    float mPositionTolerance = 0.001f;
+    bool mWarmStarting = true;
+
+    unsigned int mUsedIterations = 0;
+
+    /* per contact solver data */
+    std::vector<float> mInverseMassSums{};
+    std::vector<float> mTargetVelocities{};
+    std::vector<float> mAccumulatedImpulses{};
+
+    /* position correction of every body in this frame, only valid for bodies touched by a contact */
+    std::vector<glm::vec3> mBodyCorrections{};
+
+    /* impulses of the last frame, sorted by the source key of the contact
+     * stored as vector to survive a flipped contact normal, i.e. a rod changing from stretched to compressed */
+    std::vector<uint64_t> mCachedKeys{};
+    std::vector<glm::vec3> mCachedImpulses{};
+    std::vector<unsigned int> mSortOrder{};
+    /* contacts are created in the same order every frame, so the next key is usually right after the last one */
+    unsigned int mCacheLookupPos = 0;
+};
@@ -0,0 +1,150 @@
+#include "SimulationIslands.h"
+
+#include <algorithm>
+#include <cmath>
+
+int SimulationIslands::findRoot(int body) {
+  while (mParents.at(body) != body) {
+    /* path halving keeps the trees flat */
+    mParents.at(body) = mParents.at(mParents.at(body));
+    body = mParents.at(body);
+  }
+  return body;
+}
+
+void SimulationIslands::build(const RigidBodyStorage& bodies, const std::vector<std::array<int, 2>>& links) {
+  const int numBodies = bodies.size();
+
+  mParents.resize(numBodies);
+  for (int i = 0; i < numBodies; ++i) {
+    mParents.at(i) = i;
+  }
+
+  for (const auto& link : links) {
+    if (link[0] < 0 || link[1] < 0 || bodies.hasInfiniteMass(link[0]) || bodies.hasInfiniteMass(link[1])) {
+      continue;
+    }
+
+    int firstRoot = findRoot(link[0]);
+    int secondRoot = findRoot(link[1]);
+    if (firstRoot != secondRoot) {
+      mParents.at(std::max(firstRoot, secondRoot)) = std::min(firstRoot, secondRoot);
+    }
+  }
+
+  /* number the islands by their root body, static bodies are not part of any island */
+  std::vector<int> islandIds(numBodies, -1);
+  unsigned int numIslands = 0;
+  for (int i = 0; i < numBodies; ++i) {
+    if (!bodies.hasInfiniteMass(i) && findRoot(i) == i) {
+      islandIds.at(i) = numIslands++;
+    }
+  }
+
+  mIslandOffsets.assign(numIslands + 1, 0);
+  for (int i = 0; i < numBodies; ++i) {
+    if (!bodies.hasInfiniteMass(i)) {
+      ++mIslandOffsets.at(islandIds.at(findRoot(i)) + 1);
+    }
+  }
+  for (unsigned int i = 0; i < numIslands; ++i) {
+    mIslandOffsets.at(i + 1) += mIslandOffsets.at(i);
+  }
+
+  mIslandBodies.resize(mIslandOffsets.back());
+  std::vector<unsigned int> fillPositions(mIslandOffsets.begin(), mIslandOffsets.end() - 1);
+  for (int i = 0; i < numBodies; ++i) {
+    if (!bodies.hasInfiniteMass(i)) {
+      mIslandBodies.at(fillPositions.at(islandIds.at(findRoot(i)))++) = i;
+    }
+  }
+}
+
+void SimulationIslands::wakeUpIslands(RigidBodyStorage& bodies) {
+  for (unsigned int island = 0; island + 1 < mIslandOffsets.size(); ++island) {
+    unsigned int start = mIslandOffsets[island];
+    unsigned int end = mIslandOffsets[island + 1];
+
+    bool anyAwake = false;
+    bool anyAsleep = false;
+    for (unsigned int i = start; i < end; ++i) {
+      if (bodies.rbIsAwake[mIslandBodies[i]]) {
+        anyAwake = true;
+      } else {
+        anyAsleep = true;
+      }
+    }
+
+    if (anyAwake && anyAsleep) {
+      for (unsigned int i = start; i < end; ++i) {
+        bodies.setAwake(mIslandBodies[i], true);
+      }
+    }
+  }
+}
+
+void SimulationIslands::updateSleepState(RigidBodyStorage& bodies, const float deltaTime, const float sleepEpsilon) {
+  /* older motion values fade out, half of the weight is gone after one second */
+  const float bias = std::pow(0.5f, deltaTime);
+
+  mNumAwakeIslands = 0;
+  mNumAwakeBodies = 0;
+
+  for (unsigned int island = 0; island + 1 < mIslandOffsets.size(); ++island) {
+    unsigned int start = mIslandOffsets[island];
+    unsigned int end = mIslandOffsets[island + 1];
+
+    bool anyAwake = false;
+    bool allResting = true;
+    for (unsigned int i = start; i < end; ++i) {
+      int body = mIslandBodies[i];
+      if (!bodies.rbIsAwake[body]) {
+        continue;
+      }
+      anyAwake = true;
+
+      float currentMotion = glm::dot(bodies.rbVelocities[body], bodies.rbVelocities[body]) +
+        glm::dot(bodies.rbRotations[body], bodies.rbRotations[body]);
+      float motion = bias * std::min(bodies.rbMotions[body], 10.0f * sleepEpsilon) + (1.0f - bias) * currentMotion;
+      bodies.rbMotions[body] = motion;
+
+      if (motion >= sleepEpsilon) {
+        allResting = false;
+      }
+    }
+
+    /* sleeping islands cost nothing */
+    if (!anyAwake) {
+      continue;
+    }
+
+    if (allResting) {
+      for (unsigned int i = start; i < end; ++i) {
+        bodies.setAwake(mIslandBodies[i], false);
+      }
+      continue;
+    }
+
+    /* bodies woken by contacts wake the rest of their island */
+    for (unsigned int i = start; i < end; ++i) {
+      bodies.setAwake(mIslandBodies[i], true);
+    }
+    ++mNumAwakeIslands;
+    mNumAwakeBodies += end - start;
+  }
+}
+
+unsigned int SimulationIslands::getNumIslands() const {
+  if (mIslandOffsets.empty()) {
+    return 0;
+  }
+  return mIslandOffsets.size() - 1;
+}
+
+unsigned int SimulationIslands::getNumAwakeIslands() const {
+  return mNumAwakeIslands;
+}
+
+unsigned int SimulationIslands::getNumAwakeBodies() const {
+  return mNumAwakeBodies;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "RigidBodyStorage.h"
+
+/* groups of bodies connected by cables or rods
+ * bodies with infinite mass don't move, so they never connect two islands.
+ * an island only falls asleep as a whole, and a single woken body wakes up the whole island */
+class SimulationIslands {
+  public:
+    void build(const RigidBodyStorage& bodies, const std::vector<std::array<int, 2>>& links);
+
+    /* propagate wake ups (i.e. by forces or contacts) to all bodies of an island */
+    void wakeUpIslands(RigidBodyStorage& bodies);
+    /* update the motion of all awake bodies and put resting islands to sleep */
+    void updateSleepState(RigidBodyStorage& bodies, const float deltaTime, const float sleepEpsilon);
+
+    unsigned int getNumIslands() const;
+    unsigned int getNumAwakeIslands() const;
+    unsigned int getNumAwakeBodies() const;
+
+  private:
+    int findRoot(int body);
+
+    /* union-find parents, only used while building */
+    std::vector<int> mParents{};
+
+    /* bodies of island n are at mIslandBodies[mIslandOffsets[n]] to mIslandBodies[mIslandOffsets[n + 1] - 1] */
+    std::vector<unsigned int> mIslandOffsets{};
+    std::vector<int> mIslandBodies{};
+
+    unsigned int mNumAwakeIslands = 0;
+    unsigned int mNumAwakeBodies = 0;
+};
@@ -0,0 +1,100 @@
+#include "SpatialHashBroadphase.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Logger.h"
+
+void SpatialHashBroadphase::setCellSize(const float cellSize) {
+  if (cellSize <= 0.0f) {
+    Logger::log(1, "%s error: invalid cell size %f\n", __FUNCTION__, cellSize);
+    return;
+  }
+  mCellSize = cellSize;
+}
+
+glm::ivec3 SpatialHashBroadphase::getCell(const glm::vec3 position) const {
+  return glm::ivec3(
+    static_cast<int>(std::floor(position.x / mCellSize)),
+    static_cast<int>(std::floor(position.y / mCellSize)),
+    static_cast<int>(std::floor(position.z / mCellSize)));
+}
+
+/* 21 bits per axis, unique for +/- one million cells in every direction */
+uint64_t SpatialHashBroadphase::getCellKey(const glm::ivec3 cell) const {
+  const uint64_t mask = (1ull << 21) - 1;
+  const int offset = 1 << 20;
+  return ((static_cast<uint64_t>(cell.x + offset) & mask) << 42) |
+    ((static_cast<uint64_t>(cell.y + offset) & mask) << 21) |
+    (static_cast<uint64_t>(cell.z + offset) & mask);
+}
+
+void SpatialHashBroadphase::findPairs(const RigidBodyStorage& bodies, std::vector<std::array<int, 2>>& pairs) {
+  pairs.clear();
+  mCellEntries.clear();
+
+  const int numBodies = bodies.size();
+  mBoundsMin.resize(numBodies);
+  mBoundsMax.resize(numBodies);
+
+  /* insert the bounding boxes into all overlapped cells */
+  for (int i = 0; i < numBodies; ++i) {
+    if (bodies.rbShapes[i] == collisionShape::none) {
+      continue;
+    }
+
+    float radius = bodies.getBoundingRadius(i);
+    mBoundsMin[i] = bodies.rbPositions[i] - glm::vec3(radius);
+    mBoundsMax[i] = bodies.rbPositions[i] + glm::vec3(radius);
+
+    glm::ivec3 minCell = getCell(mBoundsMin[i]);
+    glm::ivec3 maxCell = getCell(mBoundsMax[i]);
+    for (int x = minCell.x; x <= maxCell.x; ++x) {
+      for (int y = minCell.y; y <= maxCell.y; ++y) {
+        for (int z = minCell.z; z <= maxCell.z; ++z) {
+          mCellEntries.push_back({ getCellKey(glm::ivec3(x, y, z)), i });
+        }
+      }
+    }
+  }
+
+  std::sort(mCellEntries.begin(), mCellEntries.end(), [](const CellEntry& a, const CellEntry& b) {
+    return a.ceCellKey < b.ceCellKey || (a.ceCellKey == b.ceCellKey && a.ceBody < b.ceBody);
+  });
+
+  /* test all bodies sharing a cell */
+  size_t cellStart = 0;
+  while (cellStart < mCellEntries.size()) {
+    size_t cellEnd = cellStart + 1;
+    while (cellEnd < mCellEntries.size() && mCellEntries[cellEnd].ceCellKey == mCellEntries[cellStart].ceCellKey) {
+      ++cellEnd;
+    }
+
+    for (size_t i = cellStart; i < cellEnd; ++i) {
+      int firstBody = mCellEntries[i].ceBody;
+      for (size_t j = i + 1; j < cellEnd; ++j) {
+        int secondBody = mCellEntries[j].ceBody;
+
+        /* nothing can move */
+        if (!bodies.isActive(firstBody) && !bodies.isActive(secondBody)) {
+          continue;
+        }
+
+        glm::vec3 overlapMin = glm::max(mBoundsMin[firstBody], mBoundsMin[secondBody]);
+        glm::vec3 overlapMax = glm::min(mBoundsMax[firstBody], mBoundsMax[secondBody]);
+        if (overlapMin.x > overlapMax.x || overlapMin.y > overlapMax.y || overlapMin.z > overlapMax.z) {
+          continue;
+        }
+
+        /* bodies may share several cells, report the pair only in the cell containing the overlap start */
+        if (getCellKey(getCell(overlapMin)) != mCellEntries[i].ceCellKey) {
+          continue;
+        }
+
+        pairs.push_back({ firstBody, secondBody });
+      }
+    }
+
+    cellStart = cellEnd;
+  }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "RigidBodyStorage.h"
+
+/* broadphase on a uniform grid
+ * every body with a collision shape is inserted into the cells overlapped by its bounding box.
+ * the cells are sorted by key, so finding the candidate pairs is O(n log n) for n bodies */
+class SpatialHashBroadphase {
+  public:
+    /* should be about the size of the typical body */
+    void setCellSize(const float cellSize);
+
+    /* pairs of bodies with overlapping bounding boxes, at least one of the bodies is awake */
+    void findPairs(const RigidBodyStorage& bodies, std::vector<std::array<int, 2>>& pairs);
+
+  private:
+    struct CellEntry {
+      uint64_t ceCellKey;
+      int ceBody;
+    };
+
+    glm::ivec3 getCell(const glm::vec3 position) const;
+    uint64_t getCellKey(const glm::ivec3 cell) const;
+
+    float mCellSize = 1.0f;
+
+    std::vector<CellEntry> mCellEntries{};
+    std::vector<glm::vec3> mBoundsMin{};
+    std::vector<glm::vec3> mBoundsMax{};
+};
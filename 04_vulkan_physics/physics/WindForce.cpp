@@ -1,6 +1,6 @@
 #include "WindForce.h"
 
-#include "Logger.h"
+#include <cfloat>
 
 WindForce::WindForce(const glm::vec3 wind) : mWindAmount(wind) {};
 
@@ -8,19 +8,39 @@ void WindForce::enable(const bool value) {
   mWindEnabled = value;
 }
 
-void WindForce::updateForce(std::shared_ptr<RigidBody> body, float deltaTime) {
-  if (!body) {
-    Logger::log(1, "%s error: no body given\n", __FUNCTION__);
+void WindForce::updateForces(RigidBodyStorage& bodies, const int firstBody, const int numBodies, const float deltaTime) {
+  if (!mWindEnabled) {
     return;
   }
 
-  if (body->hasInfiniteMass()) {
-    return;
+  const float* inverseMasses = bodies.rbInverseMasses.data() + firstBody;
+  const glm::vec3* positions = bodies.rbPositions.data() + firstBody;
+  const glm::mat4* transforms = bodies.rbTransformMatrices.data() + firstBody;
+  uint8_t* isAwake = bodies.rbIsAwake.data() + firstBody;
+  float* motions = bodies.rbMotions.data() + firstBody;
+  glm::vec3* forces = bodies.rbAccumulatedForces.data() + firstBody;
+  glm::vec3* torques = bodies.rbAccumulatedTorques.data() + firstBody;
+
+  /* the force scaled by the mass, plus the unscaled wind at a point above the body
+   * bodies with infinite mass get a zero force instead of a branch, so the loop can be vectorized */
+  for (int i = 0; i < numBodies; ++i) {
+    float movable = inverseMasses[i] > 0.0f ? 1.0f : 0.0f;
+    float mass = inverseMasses[i] > 0.0f ? 1.0f / inverseMasses[i] : 0.0f;
+    forces[i] += mWindAmount * mass;
+    forces[i] += mWindAmount * movable;
+  }
+
+  /* the wind acts half a unit above the position, in body space */
+  for (int i = 0; i < numBodies; ++i) {
+    float movable = inverseMasses[i] > 0.0f ? 1.0f : 0.0f;
+    glm::vec3 point = glm::vec3(transforms[i] * glm::vec4(positions[i] + glm::vec3(0.0f, 0.5f, 0.0f), 1.0f));
+    torques[i] += glm::cross(point - positions[i], mWindAmount) * movable;
   }
 
-  if (mWindEnabled) {
-    body->addForce(mWindAmount * body->getMass());
-    body->addForceToBodyPoint(mWindAmount, body->getPosition() + glm::vec3(0.0f, 0.5f, 0.0f));
-    //body->addForceToWorldPoint(mWindAmount, body->getPosition() + glm::vec3(0.0f, 0.5f, 0.0f));
+  /* wind also wakes up resting bodies, same as RigidBodyStorage::setAwake() */
+  for (int i = 0; i < numBodies; ++i) {
+    bool wakeUp = !isAwake[i] && inverseMasses[i] > 0.0f;
+    motions[i] = wakeUp ? FLT_MAX : motions[i];
+    isAwake[i] = wakeUp ? 1 : isAwake[i];
   }
 }
@@ -1,17 +1,15 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <memory>
 
 #include "IForceGenerator.h"
-#include "RigidBody.h"
 
 class WindForce : public IForceGenerator {
   public:
     WindForce(const glm::vec3 wind);
 
     void enable(const bool value);
-    virtual void updateForce(std::shared_ptr<RigidBody> body, float deltaTime) override;
+    virtual void updateForces(RigidBodyStorage& bodies, const int firstBody, const int numBodies, const float deltaTime) override;
 
   private:
     glm::vec3 mWindAmount;
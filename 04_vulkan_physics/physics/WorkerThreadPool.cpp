@@ -0,0 +1,91 @@
+#include "WorkerThreadPool.h"
+#include "Logger.h"
+
+WorkerThreadPool::WorkerThreadPool(const unsigned int numThreads) {
+  unsigned int numWorkers = numThreads > 1 ? numThreads - 1 : 0;
+
+  mWorkers.reserve(numWorkers);
+  for (unsigned int i = 0; i < numWorkers; ++i) {
+    /* thread index 0 is the calling thread */
+    mWorkers.emplace_back(&WorkerThreadPool::workerLoop, this, i + 1);
+  }
+
+  Logger::log(1, "%s: started %i worker threads\n", __FUNCTION__, numWorkers);
+}
+
+WorkerThreadPool::~WorkerThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mShutdown = true;
+  }
+  mJobCondition.notify_all();
+
+  for (auto& worker : mWorkers) {
+    worker.join();
+  }
+}
+
+unsigned int WorkerThreadPool::getNumThreads() const {
+  return mWorkers.size() + 1;
+}
+
+void WorkerThreadPool::runJobs(const unsigned int numJobs, const std::function<void(unsigned int, unsigned int)>& job) {
+  if (numJobs == 0) {
+    return;
+  }
+
+  /* not worth waking up the workers */
+  if (mWorkers.empty() || numJobs == 1) {
+    for (unsigned int i = 0; i < numJobs; ++i) {
+      job(i, 0);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mJob = &job;
+    mNumJobs = numJobs;
+    mNextJob = 0;
+    mBusyWorkers = mWorkers.size();
+    ++mBatch;
+  }
+  mJobCondition.notify_all();
+
+  processJobs(0);
+
+  std::unique_lock<std::mutex> lock(mMutex);
+  mDoneCondition.wait(lock, [this]() { return mBusyWorkers == 0; });
+  mJob = nullptr;
+}
+
+void WorkerThreadPool::processJobs(const unsigned int threadIndex) {
+  unsigned int jobIndex = mNextJob.fetch_add(1);
+  while (jobIndex < mNumJobs) {
+    (*mJob)(jobIndex, threadIndex);
+    jobIndex = mNextJob.fetch_add(1);
+  }
+}
+
+void WorkerThreadPool::workerLoop(const unsigned int threadIndex) {
+  unsigned long long lastBatch = 0;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mJobCondition.wait(lock, [&]() { return mShutdown || mBatch != lastBatch; });
+      if (mShutdown) {
+        return;
+      }
+      lastBatch = mBatch;
+    }
+
+    processJobs(threadIndex);
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      --mBusyWorkers;
+    }
+    mDoneCondition.notify_one();
+  }
+}
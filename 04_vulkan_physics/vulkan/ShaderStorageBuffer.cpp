@@ -1,12 +1,12 @@
-
 #include "ShaderStorageBuffer.h"
+#include "UploadRing.h"
 #include "Logger.h"
 
 #include <VkBootstrap.h>
 
 bool ShaderStorageBuffer::createDescriptorPool(VkRenderData& renderData) {
   VkDescriptorPoolSize poolSize{};
-  poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
   poolSize.descriptorCount = 1;
 
   VkDescriptorPoolCreateInfo descriptorPool{};
@@ -24,21 +24,8 @@ bool ShaderStorageBuffer::createDescriptorPool(VkRenderData& renderData) {
 }
 
 bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferData &SSBOData, size_t bufferSize) {
-  VkBufferCreateInfo bufferInfo{};
-  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  bufferInfo.size = bufferSize;
-  bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-
-  VmaAllocationCreateInfo vmaAllocInfo{};
-  vmaAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-
-  if (vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo, &SSBOData.rdSsboBuffer, &SSBOData.rdSsboBufferAlloc, nullptr) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate shader storage buffer via VMA\n", __FUNCTION__);
-    return false;
-  }
-
   VkDescriptorSetLayoutBinding ssboBind{};
-  ssboBind.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  ssboBind.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
   ssboBind.binding = 0;
   ssboBind.descriptorCount = 1;
   ssboBind.pImmutableSamplers = nullptr;
@@ -65,14 +52,15 @@ bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferDa
     return false;
   }
 
+  /* like the uniform buffer, the data of the current frame is selected by the dynamic offset */
   VkDescriptorBufferInfo ssboInfo{};
-  ssboInfo.buffer = SSBOData.rdSsboBuffer;
+  ssboInfo.buffer = renderData.rdUploadRing.rdRingBuffer;
   ssboInfo.offset = 0;
   ssboInfo.range = bufferSize;
 
   VkWriteDescriptorSet writeDescriptorSet{};
   writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-  writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
   writeDescriptorSet.dstSet = SSBOData.rdSSBODescriptorSet;
   writeDescriptorSet.dstBinding = 0;
   writeDescriptorSet.descriptorCount = 1;
@@ -82,23 +70,20 @@ bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferDa
 
   SSBOData.rdSsboBufferSize = bufferSize;
 
-  Logger::log(1, "%s: created shader storage buffer of size %i\n", __FUNCTION__, ssboInfo.range);
-    return true;
-  }
+  Logger::log(1, "%s: created shader storage buffer descriptor of size %i\n", __FUNCTION__, bufferSize);
+  return true;
+}
 
-void ShaderStorageBuffer::uploadData(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData, std::vector<glm::mat4> matricesToUpload) {
+bool ShaderStorageBuffer::uploadData(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData, const std::vector<glm::mat4> &matricesToUpload) {
   if (matricesToUpload.size() == 0) {
-    return;
+    return true;
   }
 
-  void* data;
-  vmaMapMemory(renderData.rdAllocator, SSBOData.rdSsboBufferAlloc, &data);
-  std::memcpy(data, matricesToUpload.data(), SSBOData.rdSsboBufferSize);
-  vmaUnmapMemory(renderData.rdAllocator, SSBOData.rdSsboBufferAlloc);
+  return UploadRing::uploadData(renderData, matricesToUpload.data(), SSBOData.rdSsboBufferSize,
+    SSBOData.rdSsboDynamicOffset);
 }
 
 void ShaderStorageBuffer::cleanup(VkRenderData& renderData, VkShaderStorageBufferData &SSBOData) {
-  vmaDestroyBuffer(renderData.rdAllocator, SSBOData.rdSsboBuffer, SSBOData.rdSsboBufferAlloc);
   vkDestroyDescriptorSetLayout(renderData.rdVkbDevice.device, SSBOData.rdSSBODescriptorLayout, nullptr);
   vkDestroyDescriptorPool(renderData.rdVkbDevice.device, renderData.rdSSBODescriptorPool, nullptr);
 }
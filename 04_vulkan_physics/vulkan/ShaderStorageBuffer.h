@@ -10,6 +10,7 @@ class ShaderStorageBuffer {
 public:
   static bool createDescriptorPool(VkRenderData &renderData);
   static bool init(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData, size_t bufferSize);
-  static void uploadData(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData, std::vector<glm::mat4> matricesToUpload);
+  /* stores the offset of the data inside the upload ring in rdSsboDynamicOffset */
+  static bool uploadData(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData, const std::vector<glm::mat4> &matricesToUpload);
   static void cleanup(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData);
 };
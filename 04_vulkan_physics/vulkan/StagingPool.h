@@ -0,0 +1,29 @@
+/* shared host visible staging memory for buffer and image uploads */
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "VkRenderData.h"
+
+class StagingPool {
+  public:
+    static bool init(VkRenderData &renderData, const VkDeviceSize blockSize);
+
+    /* copies the data into a suballocation, the copy source is allocation.saBuffer at allocation.saOffset */
+    static bool allocate(VkRenderData &renderData, const void *data, const VkDeviceSize dataSize,
+      VkStagingAllocation &allocation);
+    /* the GPU must have finished reading the allocation */
+    static void release(VkRenderData &renderData, const VkStagingAllocation &allocation);
+    /* for copies recorded into the command buffer of the current frame */
+    static void releaseAfterFrame(VkRenderData &renderData, const VkStagingAllocation &allocation);
+
+    /* must be called after the fence of the current frame was signaled */
+    static void beginFrame(VkRenderData &renderData);
+    static void cleanup(VkRenderData &renderData);
+
+  private:
+    static bool createBlock(VkRenderData &renderData, const VkDeviceSize blockSize, unsigned int &blockIndex);
+    static void destroyBlock(VkRenderData &renderData, VkStagingBlockData &block);
+    static void releaseFrame(VkRenderData &renderData, const unsigned int frame);
+    static VkDeviceSize getAlignedSize(const VkStagingPoolData &poolData, const VkDeviceSize size);
+};
@@ -2,6 +2,7 @@
 #include <stb_image.h>
 
 #include "CommandBuffer.h"
+#include "StagingPool.h"
 #include "Texture.h"
 #include "Logger.h"
 
@@ -43,28 +44,14 @@ bool Texture::loadTexture(VkRenderData &renderData, std::string textureFilename)
     return false;
   }
 
-  /* staging buffer */
-  VkBufferCreateInfo stagingBufferInfo{};
-  stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  stagingBufferInfo.size = imageSize;
-  stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-  VkBuffer stagingBuffer;
-  VmaAllocation stagingBufferAlloc;
-
-  VmaAllocationCreateInfo stagingAllocInfo{};
-  stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-  if (vmaCreateBuffer(renderData.rdAllocator, &stagingBufferInfo, &stagingAllocInfo, &stagingBuffer,  &stagingBufferAlloc, nullptr) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate texture staging buffer via VMA\n", __FUNCTION__);
+  /* staging memory from the pool, released after the copy */
+  VkStagingAllocation stagingAllocation{};
+  if (!StagingPool::allocate(renderData, textureData, imageSize, stagingAllocation)) {
+    Logger::log(1, "%s error: could not get texture staging memory\n", __FUNCTION__);
+    stbi_image_free(textureData);
     return false;
   }
 
-  void* data;
-  vmaMapMemory(renderData.rdAllocator, stagingBufferAlloc, &data);
-  memcpy(data, textureData, static_cast<uint32_t>(imageSize));
-  vmaUnmapMemory(renderData.rdAllocator, stagingBufferAlloc);
-
   stbi_image_free(textureData);
 
   VkImageSubresourceRange stagingBufferRange{};
@@ -90,7 +77,7 @@ bool Texture::loadTexture(VkRenderData &renderData, std::string textureFilename)
   textureExtent.depth = 1;
 
   VkBufferImageCopy stagingBufferCopy{};
-  stagingBufferCopy.bufferOffset = 0;
+  stagingBufferCopy.bufferOffset = stagingAllocation.saOffset;
   stagingBufferCopy.bufferRowLength = 0;
   stagingBufferCopy.bufferImageHeight = 0;
   stagingBufferCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -132,7 +119,7 @@ bool Texture::loadTexture(VkRenderData &renderData, std::string textureFilename)
   }
 
   vkCmdPipelineBarrier(stagingCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferTransferBarrier);
-  vkCmdCopyBufferToImage(stagingCommandBuffer, stagingBuffer, renderData.rdTextureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &stagingBufferCopy);
+  vkCmdCopyBufferToImage(stagingCommandBuffer, stagingAllocation.saBuffer, renderData.rdTextureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &stagingBufferCopy);
   vkCmdPipelineBarrier(stagingCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferShaderBarrier);
 
   if (vkEndCommandBuffer(stagingCommandBuffer) != VK_SUCCESS) {
@@ -178,7 +165,7 @@ bool Texture::loadTexture(VkRenderData &renderData, std::string textureFilename)
 
   vkDestroyFence(renderData.rdVkbDevice.device, stagingBufferFence, nullptr);
   CommandBuffer::cleanup(renderData, stagingCommandBuffer);
-  vmaDestroyBuffer(renderData.rdAllocator, stagingBuffer, stagingBufferAlloc);
+  StagingPool::release(renderData, stagingAllocation);
 
   /* image view and sampler */
   VkImageViewCreateInfo texViewInfo{};
@@ -1,11 +1,12 @@
 #include "UniformBuffer.h"
+#include "UploadRing.h"
 #include "Logger.h"
 
 #include <VkBootstrap.h>
 
 bool UniformBuffer::createDescriptorPool(VkRenderData& renderData) {
   VkDescriptorPoolSize poolSize{};
-  poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   poolSize.descriptorCount = 1;
 
   VkDescriptorPoolCreateInfo descriptorPool{};
@@ -23,21 +24,8 @@ bool UniformBuffer::createDescriptorPool(VkRenderData& renderData) {
 }
 
 bool UniformBuffer::init(VkRenderData& renderData, const VkDeviceSize bufferSize) {
-  VkBufferCreateInfo bufferInfo{};
-  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  bufferInfo.size = bufferSize;
-  bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-
-  VmaAllocationCreateInfo vmaAllocInfo{};
-  vmaAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-
-  if (vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo, &renderData.rdUboBuffer, &renderData.rdUboBufferAlloc, nullptr) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate uniform buffer via VMA\n", __FUNCTION__);
-    return false;
-  }
-
   VkDescriptorSetLayoutBinding uboBind{};
-  uboBind.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  uboBind.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   uboBind.binding = 0;
   uboBind.descriptorCount = 1;
   uboBind.pImmutableSamplers = nullptr;
@@ -64,14 +52,15 @@ bool UniformBuffer::init(VkRenderData& renderData, const VkDeviceSize bufferSize
     return false;
   }
 
+  /* the frame data is found by the dynamic offset given at bind time */
   VkDescriptorBufferInfo uboInfo{};
-  uboInfo.buffer = renderData.rdUboBuffer;
+  uboInfo.buffer = renderData.rdUploadRing.rdRingBuffer;
   uboInfo.offset = 0;
   uboInfo.range = bufferSize;
 
   VkWriteDescriptorSet writeDescriptorSet{};
   writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-  writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   writeDescriptorSet.dstSet = renderData.rdUBODescriptorSet;
   writeDescriptorSet.dstBinding = 0;
   writeDescriptorSet.descriptorCount = 1;
@@ -82,19 +71,16 @@ bool UniformBuffer::init(VkRenderData& renderData, const VkDeviceSize bufferSize
   return true;
 }
 
-void UniformBuffer::uploadData(VkRenderData& renderData, std::vector<glm::mat4>& matrices) {
+bool UniformBuffer::uploadData(VkRenderData& renderData, const std::vector<glm::mat4>& matrices) {
   if (matrices.size() == 0) {
-    return;
+    return true;
   }
 
-  void* data;
-  vmaMapMemory(renderData.rdAllocator, renderData.rdUboBufferAlloc , &data);
-  std::memcpy(data, matrices.data(), sizeof(matrices) * sizeof(glm::mat4));
-  vmaUnmapMemory(renderData.rdAllocator, renderData.rdUboBufferAlloc);
+  return UploadRing::uploadData(renderData, matrices.data(), matrices.size() * sizeof(glm::mat4),
+    renderData.rdUBODynamicOffset);
 }
 
 void UniformBuffer::cleanup(VkRenderData& renderData) {
   vkDestroyDescriptorPool(renderData.rdVkbDevice.device, renderData.rdUBODescriptorPool, nullptr);
   vkDestroyDescriptorSetLayout(renderData.rdVkbDevice.device, renderData.rdUBODescriptorLayout, nullptr);
-  vmaDestroyBuffer(renderData.rdAllocator, renderData.rdUboBuffer, renderData.rdUboBufferAlloc);
 }
@@ -11,6 +11,7 @@ class UniformBuffer {
   public:
     static bool createDescriptorPool(VkRenderData &renderData);
     static bool init(VkRenderData &renderData, const VkDeviceSize bufferSize);
-    static void uploadData(VkRenderData &renderData, std::vector <glm::mat4> &matrices);
+    /* stores the offset of the data inside the upload ring in rdUBODynamicOffset */
+    static bool uploadData(VkRenderData &renderData, const std::vector<glm::mat4> &matrices);
     static void cleanup(VkRenderData &renderData);
 };
@@ -1,5 +1,6 @@
 #include <string>
 #include <vector>
+#include <algorithm>
 
 #ifndef GLM_ENABLE_EXPERIMENTAL
 #define GLM_ENABLE_EXPERIMENTAL
@@ -54,7 +55,9 @@ bool UserInterface::init(VkRenderData& renderData) {
   imguiIinitInfo.Queue = renderData.rdGraphicsQueue;
   imguiIinitInfo.DescriptorPool = renderData.rdImguiDescriptorPool;
   imguiIinitInfo.MinImageCount = 2;
-  imguiIinitInfo.ImageCount = renderData.rdSwapchainImages.size();
+  /* ImGui rotates its vertex buffers by this count, it must not reuse a buffer of a frame still in flight */
+  imguiIinitInfo.ImageCount = std::max(static_cast<uint32_t>(renderData.rdSwapchainImages.size()),
+    static_cast<uint32_t>(VkRenderData::rdMaxFramesInFlight));
   imguiIinitInfo.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
 
   ImGui_ImplVulkan_Init(&imguiIinitInfo, renderData.rdRenderpass);
@@ -165,16 +168,28 @@ void UserInterface::createFrame(VkRenderData& renderData) {
 
     std::string imgWindowPos = std::to_string(static_cast<int>(ImGui::GetWindowPos().x)) + "/" + std::to_string(static_cast<int>(ImGui::GetWindowPos().y));
     ImGui::Text("ImGui Window Position: %s", imgWindowPos.c_str());
+
+    const VkStagingPoolData &stagingPool = renderData.rdStagingPool;
+    ImGui::Text("Staging Used/Peak:     %s/%s KiB", std::to_string(stagingPool.rdUsedSize / 1024).c_str(),
+      std::to_string(stagingPool.rdPeakUsedSize / 1024).c_str());
+    ImGui::Text("Staging Resident:      %s KiB in %s block allocations", std::to_string(stagingPool.rdResidentSize / 1024).c_str(),
+      std::to_string(stagingPool.rdBlockAllocations).c_str());
   }
 
   if (ImGui::CollapsingHeader("Timers")) {
     ImGui::Text("Frame Time:               %s ms", std::to_string(renderData.rdFrameTime).c_str());
+    ImGui::Text("Wait for Fence Time:      %s ms", std::to_string(renderData.rdWaitForFenceTime).c_str());
     ImGui::Text("Model Upload Time:        %s ms", std::to_string(renderData.rdUploadToVBOTime).c_str());
     ImGui::Text("Matrix Generation Time:   %s ms", std::to_string(renderData.rdMatrixGenerateTime).c_str());
     ImGui::Text("Matrix Upload Time:       %s ms", std::to_string(renderData.rdUploadToUBOTime).c_str());
     ImGui::Text("Physics Calculation Time: %s ms", std::to_string(renderData.rdPhysicsTime).c_str());
     ImGui::Text("UI Generation Time:       %s ms", std::to_string(renderData.rdUIGenerateTime).c_str());
     ImGui::Text("UI Draw Time:             %s ms", std::to_string(renderData.rdUIDrawTime).c_str());
+
+    /* one frame in flight serializes CPU and GPU, compare the frame and fence wait times */
+    ImGui::Text("Frames in Flight:");
+    ImGui::SameLine();
+    ImGui::SliderInt("##FramesInFlight", &renderData.rdFramesInFlight, 1, VkRenderData::rdMaxFramesInFlight);
   }
 
   if (ImGui::CollapsingHeader("Camera")) {
@@ -202,12 +217,52 @@ void UserInterface::createFrame(VkRenderData& renderData) {
   if (ImGui::CollapsingHeader("Physics")) {
     ImGui::Text("Contacts found wile contact resolution: %i", renderData.rdContactsIssued);
     ImGui::Text("Contact resolver iterations used:       %i", renderData.rdContactResolverIterations);
+    ImGui::Text("Physics steps last update:              %i", renderData.rdPhysicsSteps);
+    ImGui::Text("Collision candidate pairs:              %i", renderData.rdCollisionPairs);
+    ImGui::Text("Awake bodies:                           %i", renderData.rdAwakeBodies);
+    ImGui::Text("Simulation islands (awake):             %i (%i)", renderData.rdIslands, renderData.rdAwakeIslands);
 
     ImGui::Checkbox("Enable Physics calculations", &renderData.rdPhysicsEnabled);
     if (!renderData.rdPhysicsEnabled) {
       ImGui::BeginDisabled();
     }
     ImGui::Checkbox("Enable Physics wind force", &renderData.rdPhysicsWindEnabled);
+
+    ImGui::Text("Physics steps per second");
+    ImGui::SameLine();
+    ImGui::SliderInt("##PhysicsStepsPerSecond", &renderData.rdPhysicsStepsPerSecond, 30, 240);
+
+    ImGui::Text("Max physics steps per frame");
+    ImGui::SameLine();
+    ImGui::SliderInt("##PhysicsMaxSubSteps", &renderData.rdPhysicsMaxSubSteps, 1, 10);
+
+    ImGui::Text("Contact solver:");
+    ImGui::SameLine();
+    ImGui::RadioButton("Priority queue", &renderData.rdContactSolver, 0);
+    ImGui::SameLine();
+    ImGui::RadioButton("Sequential impulse", &renderData.rdContactSolver, 1);
+
+    if (renderData.rdContactSolver != 1) {
+      ImGui::BeginDisabled();
+    }
+    ImGui::Text("Impulse solver iterations");
+    ImGui::SameLine();
+    ImGui::SliderInt("##ImpulseSolverIterations", &renderData.rdImpulseSolverIterations, 1, 50);
+    ImGui::Checkbox("Warm start impulse solver", &renderData.rdImpulseSolverWarmStarting);
+    if (renderData.rdContactSolver != 1) {
+      ImGui::EndDisabled();
+    }
+
+    ImGui::Checkbox("Position based cables and rods", &renderData.rdPhysicsPositionBasedLinks);
+    if (!renderData.rdPhysicsPositionBasedLinks) {
+      ImGui::BeginDisabled();
+    }
+    ImGui::Text("Position based iterations");
+    ImGui::SameLine();
+    ImGui::SliderInt("##PositionBasedIterations", &renderData.rdPositionBasedIterations, 1, 20);
+    if (!renderData.rdPhysicsPositionBasedLinks) {
+      ImGui::EndDisabled();
+    }
     if (!renderData.rdPhysicsEnabled) {
       ImGui::EndDisabled();
     }
@@ -1,5 +1,6 @@
 #include "VertexBuffer.h"
 #include "CommandBuffer.h"
+#include "StagingPool.h"
 #include "Logger.h"
 
 bool VertexBuffer::init(VkRenderData &renderData, VkVertexBufferData &bufferData) {
@@ -19,21 +20,6 @@ bool VertexBuffer::init(VkRenderData &renderData, VkVertexBufferData &bufferData
     return false;
   }
 
-  /* staging buffer for copy */
-  VkBufferCreateInfo stagingBufferInfo{};
-  stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  stagingBufferInfo.size = bufferData.rdVertexBufferSize;;
-  stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-  VmaAllocationCreateInfo stagingAllocInfo{};
-  stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-  if (vmaCreateBuffer(renderData.rdAllocator, &stagingBufferInfo, &stagingAllocInfo,
-      &bufferData.rdVertexStagingBuffer,
-      &bufferData.rdVertexStagingBufferAlloc, nullptr) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate vertex staging buffer via VMA\n", __FUNCTION__);
-    return false;
-  }
   return true;
 }
 
@@ -45,13 +31,14 @@ bool VertexBuffer::uploadData(VkRenderData &renderData, VkVertexBufferData &buff
     return false;
   }
 
-  /* copy data to staging buffer*/
-  void* data;
-  vmaMapMemory(renderData.rdAllocator, bufferData.rdVertexStagingBufferAlloc, &data);
-  memcpy(data, vertexData.vertices.data(), vertexDataSize);
-  vmaUnmapMemory(renderData.rdAllocator, bufferData.rdVertexStagingBufferAlloc);
+  /* copy data to the staging pool */
+  VkStagingAllocation stagingAllocation{};
+  if (!StagingPool::allocate(renderData, vertexData.vertices.data(), vertexDataSize, stagingAllocation)) {
+    Logger::log(1, "%s error: could not get %i bytes of staging memory\n", __FUNCTION__, vertexDataSize);
+    return false;
+  }
 
-  return doStagingUpload(renderData, bufferData, vertexDataSize, separateCMDBuffer);
+  return doStagingUpload(renderData, bufferData, stagingAllocation, vertexDataSize, separateCMDBuffer);
 }
 
 bool VertexBuffer::uploadData(VkRenderData &renderData, VkVertexBufferData &bufferData, VkLineMesh vertexData, const bool separateCMDBuffer) {
@@ -62,13 +49,14 @@ bool VertexBuffer::uploadData(VkRenderData &renderData, VkVertexBufferData &buff
     return false;
   }
 
-  /* copy data to staging buffer*/
-  void* data;
-  vmaMapMemory(renderData.rdAllocator, bufferData.rdVertexStagingBufferAlloc, &data);
-  memcpy(data, vertexData.vertices.data(), vertexDataSize);
-  vmaUnmapMemory(renderData.rdAllocator, bufferData.rdVertexStagingBufferAlloc);
+  /* copy data to the staging pool */
+  VkStagingAllocation stagingAllocation{};
+  if (!StagingPool::allocate(renderData, vertexData.vertices.data(), vertexDataSize, stagingAllocation)) {
+    Logger::log(1, "%s error: could not get %i bytes of staging memory\n", __FUNCTION__, vertexDataSize);
+    return false;
+  }
 
-  return doStagingUpload(renderData, bufferData, vertexDataSize, separateCMDBuffer);
+  return doStagingUpload(renderData, bufferData, stagingAllocation, vertexDataSize, separateCMDBuffer);
 }
 
 bool VertexBuffer::resizeBuffer(VkRenderData& renderData, VkVertexBufferData& bufferData, const unsigned int vertexDataSize) {
@@ -84,19 +72,19 @@ bool VertexBuffer::resizeBuffer(VkRenderData& renderData, VkVertexBufferData& bu
   return true;
 }
 
-bool VertexBuffer::doStagingUpload(VkRenderData& renderData, VkVertexBufferData& bufferData, const unsigned int vertexDataSize, const bool separateCMDBuffer) {
+bool VertexBuffer::doStagingUpload(VkRenderData& renderData, VkVertexBufferData& bufferData, const VkStagingAllocation& stagingAllocation, const unsigned int vertexDataSize, const bool separateCMDBuffer) {
   VkBufferMemoryBarrier vertexBufferBarrier{};
   vertexBufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
   vertexBufferBarrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
   vertexBufferBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
   vertexBufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
   vertexBufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-  vertexBufferBarrier.buffer = bufferData.rdVertexStagingBuffer;
+  vertexBufferBarrier.buffer = bufferData.rdVertexBuffer;
   vertexBufferBarrier.offset = 0;
   vertexBufferBarrier.size = vertexDataSize;
 
   VkBufferCopy stagingBufferCopy{};
-  stagingBufferCopy.srcOffset = 0;
+  stagingBufferCopy.srcOffset = stagingAllocation.saOffset;
   stagingBufferCopy.dstOffset = 0;
   stagingBufferCopy.size = vertexDataSize;
 
@@ -104,21 +92,24 @@ bool VertexBuffer::doStagingUpload(VkRenderData& renderData, VkVertexBufferData&
   if (separateCMDBuffer) {
     VkCommandBuffer commandBuffer = CommandBuffer::createSingleShotBuffer(renderData);
 
-    vkCmdCopyBuffer(commandBuffer, bufferData.rdVertexStagingBuffer, bufferData.rdVertexBuffer, 1, &stagingBufferCopy);
+    vkCmdCopyBuffer(commandBuffer, stagingAllocation.saBuffer, bufferData.rdVertexBuffer, 1, &stagingBufferCopy);
     vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, nullptr, 1, &vertexBufferBarrier, 0, nullptr);
 
-    if (!CommandBuffer::submitSingleShotBuffer(renderData, commandBuffer, renderData.rdGraphicsQueue)) {
+    /* the submit waits for the copy */
+    bool commandResult = CommandBuffer::submitSingleShotBuffer(renderData, commandBuffer, renderData.rdGraphicsQueue);
+    StagingPool::release(renderData, stagingAllocation);
+    if (!commandResult) {
       return false;
     }
   } else {
-    vkCmdCopyBuffer(renderData.rdCommandBuffer, bufferData.rdVertexStagingBuffer, bufferData.rdVertexBuffer, 1, &stagingBufferCopy);
+    vkCmdCopyBuffer(renderData.rdCommandBuffer, stagingAllocation.saBuffer, bufferData.rdVertexBuffer, 1, &stagingBufferCopy);
     vkCmdPipelineBarrier(renderData.rdCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, nullptr, 1, &vertexBufferBarrier, 0, nullptr);
+    StagingPool::releaseAfterFrame(renderData, stagingAllocation);
   }
 
   return true;
 }
 
 void VertexBuffer::cleanup(VkRenderData &renderData, VkVertexBufferData &bufferData) {
-  vmaDestroyBuffer(renderData.rdAllocator, bufferData.rdVertexStagingBuffer, bufferData.rdVertexStagingBufferAlloc);
   vmaDestroyBuffer(renderData.rdAllocator, bufferData.rdVertexBuffer, bufferData.rdVertexBufferAlloc);
 }
@@ -13,6 +13,6 @@ class VertexBuffer {
     static void cleanup(VkRenderData &renderData, VkVertexBufferData &bufferData);
 
   private:
-    static bool doStagingUpload(VkRenderData &renderData, VkVertexBufferData &bufferData, const unsigned int vertexDataSize, const bool separateCMDBuffer = false);
+    static bool doStagingUpload(VkRenderData &renderData, VkVertexBufferData &bufferData, const VkStagingAllocation &stagingAllocation, const unsigned int vertexDataSize, const bool separateCMDBuffer = false);
     static bool resizeBuffer(VkRenderData &renderData, VkVertexBufferData &bufferData, const unsigned int vertexDataSize);
 };
@@ -38,21 +38,63 @@ struct VkVertexBufferData {
 
   VkBuffer rdVertexBuffer = VK_NULL_HANDLE;
   VmaAllocation rdVertexBufferAlloc = nullptr;
-
-  VkBuffer rdVertexStagingBuffer = VK_NULL_HANDLE;
-  VmaAllocation rdVertexStagingBufferAlloc = nullptr;
 };
 
+/* the data lives in the upload ring, the descriptor set points to it with a dynamic offset */
 struct VkShaderStorageBufferData {
   size_t rdSsboBufferSize = 2048;
-
-  VkBuffer rdSsboBuffer = VK_NULL_HANDLE;
-  VmaAllocation rdSsboBufferAlloc = nullptr;
+  uint32_t rdSsboDynamicOffset = 0;
 
   VkDescriptorSetLayout rdSSBODescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSet rdSSBODescriptorSet = VK_NULL_HANDLE;
 };
 
+/* one persistently mapped buffer for all per-frame uniform and storage data
+ * every frame in flight owns a region, uploads are aligned suballocations inside the region of the current frame */
+struct VkUploadRingData {
+  VkBuffer rdRingBuffer = VK_NULL_HANDLE;
+  VmaAllocation rdRingBufferAlloc = nullptr;
+  char* rdMappedData = nullptr;
+
+  VkDeviceSize rdAlignment = 0;
+  VkDeviceSize rdFrameRegionSize = 0;
+  VkDeviceSize rdFrameRegionStart = 0;
+  VkDeviceSize rdFrameRegionUsed = 0;
+};
+
+/* host visible staging memory shared by all uploads
+ * allocations are placed one after another into large blocks, a block starts over after all of its allocations were released */
+struct VkStagingBlockData {
+  VkBuffer sbBuffer = VK_NULL_HANDLE;
+  VmaAllocation sbBufferAlloc = nullptr;
+  char* sbMappedData = nullptr;
+  VkDeviceSize sbSize = 0;
+  VkDeviceSize sbUsedSize = 0;
+  unsigned int sbAllocations = 0;
+};
+
+struct VkStagingAllocation {
+  VkBuffer saBuffer = VK_NULL_HANDLE;
+  VkDeviceSize saOffset = 0;
+  VkDeviceSize saSize = 0;
+  unsigned int saBlock = 0;
+};
+
+struct VkStagingPoolData {
+  std::vector<VkStagingBlockData> rdBlocks{};
+  VkDeviceSize rdBlockSize = 0;
+  VkDeviceSize rdAlignment = 0;
+
+  /* allocations of every frame in flight, released after the fence of the frame was signaled */
+  std::vector<std::vector<VkStagingAllocation>> rdFrameReleases{};
+
+  /* statistics */
+  VkDeviceSize rdUsedSize = 0;
+  VkDeviceSize rdPeakUsedSize = 0;
+  VkDeviceSize rdResidentSize = 0;
+  unsigned int rdBlockAllocations = 0;
+};
+
 struct VkRenderData {
   GLFWwindow *rdWindow = nullptr;
 
@@ -70,6 +112,9 @@ struct VkRenderData {
   float rdUploadToUBOTime = 0.0f;
   float rdUIGenerateTime = 0.0f;
   float rdUIDrawTime = 0.0f;
+  /* time the CPU waited for the GPU to finish the oldest frame in flight */
+  float rdWaitForFenceTime = 0.0f;
+  /* time used by the physics thread for the steps of its last update */
   float rdPhysicsTime = 0.0f;
 
   int rdMoveForward = 0;
@@ -87,6 +132,19 @@ struct VkRenderData {
   bool rdPhysicsWindEnabled = false;
   unsigned int rdContactsIssued = 0;
   unsigned int rdContactResolverIterations = 0;
+  int rdPhysicsStepsPerSecond = 60;
+  int rdPhysicsMaxSubSteps = 5;
+  unsigned int rdPhysicsSteps = 0;
+  unsigned int rdCollisionPairs = 0;
+  unsigned int rdAwakeBodies = 0;
+  unsigned int rdIslands = 0;
+  unsigned int rdAwakeIslands = 0;
+  /* 0 = priority queue, 1 = sequential impulse */
+  int rdContactSolver = 0;
+  int rdImpulseSolverIterations = 10;
+  bool rdImpulseSolverWarmStarting = true;
+  bool rdPhysicsPositionBasedLinks = false;
+  int rdPositionBasedIterations = 4;
 
   glm::vec3 rdBoxModelPosition = glm::vec3(0.0f);
   glm::vec3 rdSphereModelPosition = glm::vec3(0.0f);
@@ -112,16 +170,26 @@ struct VkRenderData {
 
   VkRenderPass rdRenderpass;
   VkPipelineLayout rdPipelineLayout = VK_NULL_HANDLE;
+  /* shared by all pipelines, filled from and saved to a file */
+  VkPipelineCache rdPipelineCache = VK_NULL_HANDLE;
+  bool rdPipelineCacheLoaded = false;
   VkPipeline rdBasicPipeline = VK_NULL_HANDLE;
   VkPipeline rdLinePipeline = VK_NULL_HANDLE;
   VkPipeline rdFlatPipeline = VK_NULL_HANDLE;
 
+  /* resources for rdMaxFramesInFlight frames are created, the first rdFramesInFlight of them are used */
+  static constexpr int rdMaxFramesInFlight = 3;
+  int rdFramesInFlight = 2;
+  unsigned int rdCurrentFrame = 0;
+
   VkCommandPool rdCommandPool = VK_NULL_HANDLE;
+  /* command buffer of the frame currently recorded, one of rdCommandBuffers */
   VkCommandBuffer rdCommandBuffer = VK_NULL_HANDLE;
+  std::vector<VkCommandBuffer> rdCommandBuffers{};
 
-  VkSemaphore rdPresentSemaphore = VK_NULL_HANDLE;
-  VkSemaphore rdRenderSemaphore = VK_NULL_HANDLE;
-  VkFence rdRenderFence = VK_NULL_HANDLE;
+  std::vector<VkSemaphore> rdPresentSemaphores{};
+  std::vector<VkSemaphore> rdRenderSemaphores{};
+  std::vector<VkFence> rdRenderFences{};
 
   VkImage rdTextureImage = VK_NULL_HANDLE;
   VkImageView rdTextureImageView = VK_NULL_HANDLE;
@@ -132,13 +200,13 @@ struct VkRenderData {
   VkDescriptorSetLayout rdTextureDescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSet rdTextureDescriptorSet = VK_NULL_HANDLE;
 
-  VkDescriptorPool rdUBODescriptorPool = VK_NULL_HANDLE;
-
-  VkBuffer rdUboBuffer = VK_NULL_HANDLE;
-  VmaAllocation rdUboBufferAlloc = nullptr;
+  VkUploadRingData rdUploadRing{};
+  VkStagingPoolData rdStagingPool{};
 
+  VkDescriptorPool rdUBODescriptorPool = VK_NULL_HANDLE;
   VkDescriptorSetLayout rdUBODescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSet rdUBODescriptorSet = VK_NULL_HANDLE;
+  uint32_t rdUBODynamicOffset = 0;
 
   VkDescriptorPool rdSSBODescriptorPool = VK_NULL_HANDLE;
 
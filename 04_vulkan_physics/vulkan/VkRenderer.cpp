@@ -2,6 +2,7 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <tuple>
+#include <thread>
 
 #define VMA_IMPLEMENTATION
 #include <vk_mem_alloc.h>
@@ -46,6 +47,10 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
+  if (!createStagingPool()) {
+    return false;
+  }
+
   if (!createSwapchain()) {
     return false;
   }
@@ -68,6 +73,10 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
+  if (!createUploadRing()) {
+    return false;
+  }
+
   if (!createUBODescriptorPool() || !createUBO()) {
     return false;
   }
@@ -88,6 +97,13 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
+  if (!createPipelineCache()) {
+    return false;
+  }
+
+  /* compare the time with an empty and a filled pipeline cache */
+  mPipelineCreationTimer.start();
+
   if (!createBasicPipeline()) {
     return false;
   }
@@ -99,6 +115,8 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
   if (!createFlatPipeline()) {
     return false;
   }
+  Logger::log(1, "%s: created pipelines in %f ms (%s pipeline cache)\n", __FUNCTION__,
+    mPipelineCreationTimer.stop(), mRenderData.rdPipelineCacheLoaded ? "warm" : "cold");
 
   if (!createFramebuffer()) {
     return false;
@@ -133,7 +151,7 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
   /* bridge anchors */
   float xPos = 2.0f;
   for (unsigned int i = 0; i < NUMBER_OF_BRIDGE_POINTS * 2; ++i) {
-    std::shared_ptr<RigidBody> anchor = std::make_shared<RigidBody>();
+    std::shared_ptr<RigidBody> anchor = mRigidBodyWorld.createRigidBody();
     float zPos = 0.0f;
 
     if (i % 2 == 0) {
@@ -145,14 +163,12 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     anchor->setVelocity(glm::vec3(0.0f));
     anchor->setAcceleration(glm::vec3(0.0f));
     anchor->setLinearDaming(0.95f);
-
-    mRigidBodyWorld.addRigidBody(anchor);
   }
 
   /* plank holders */
   xPos = 2.0f;
   for (unsigned int i = 0; i < NUMBER_OF_BRIDGE_POINTS * 2; ++i) {
-    std::shared_ptr<RigidBody> body = std::make_shared<RigidBody>();
+    std::shared_ptr<RigidBody> body = mRigidBodyWorld.createRigidBody();
     float zPos = 0.0f;
 
     if (i % 2 == 0) {
@@ -165,8 +181,6 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     body->setVelocity(glm::vec3(0.0f));
     body->setAcceleration(glm::vec3(0.0f));
     body->setLinearDaming(0.95f);
-
-    mRigidBodyWorld.addRigidBody(body);
   }
 
   /* connecten cables from anchors to planks */
@@ -185,6 +199,23 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     mRigidBodyWorld.addRodContact(mRigidBodyWorld.getRigidBody(i), mRigidBodyWorld.getRigidBody(i + 1), 0.75f);
   }
 
+  /* the force registry only accepts bodies of the world, so the bodies must be added to the world first */
+  mRigidBodyWorld.addRigidBody(mBoxModel->getRigidBody());
+  mRigidBodyWorld.addCableContact(mRigidBodyWorld.getRigidBody(NUMBER_OF_BRIDGE_POINTS * 3 - 1), mBoxModel->getRigidBody(), 2.0f, 0.4f);
+
+  mRigidBodyWorld.addRigidBody(mSphereModel->getRigidBody());
+  mRigidBodyWorld.addCableContact(mRigidBodyWorld.getRigidBody(NUMBER_OF_BRIDGE_POINTS * 3), mSphereModel->getRigidBody(), 2.5f, 0.8f);
+
+  /* let box, sphere and the planks collide */
+  mBoxModel->getRigidBody()->setCollisionShape(collisionShape::box, glm::vec3(0.5f));
+  mSphereModel->getRigidBody()->setCollisionShape(collisionShape::sphere, glm::vec3(0.75f));
+  for (unsigned int i = NUMBER_OF_BRIDGE_POINTS * 2; i < NUMBER_OF_BRIDGE_POINTS * 4; ++i) {
+    mRigidBodyWorld.getRigidBody(i)->setCollisionShape(collisionShape::sphere, glm::vec3(0.1f));
+  }
+
+  /* the worker threads are only used for scenes with many contacts */
+  mRigidBodyWorld.setNumResolverThreads(std::thread::hardware_concurrency());
+
   std::shared_ptr<GravityForce> gravity = std::make_shared<GravityForce>(glm::vec3(0.0f, -10.0f, 0.0f));
   mForceRegistry.addEntry(mBoxModel->getRigidBody(), gravity);
   mForceRegistry.addEntry(mSphereModel->getRigidBody(), gravity);
@@ -198,12 +229,6 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
    mForceRegistry.addEntry(mRigidBodyWorld.getRigidBody(i), mWindForce);
   }
 
-  mRigidBodyWorld.addRigidBody(mBoxModel->getRigidBody());
-  mRigidBodyWorld.addCableContact(mRigidBodyWorld.getRigidBody(NUMBER_OF_BRIDGE_POINTS * 3 - 1), mBoxModel->getRigidBody(), 2.0f, 0.4f);
-
-  mRigidBodyWorld.addRigidBody(mSphereModel->getRigidBody());
-  mRigidBodyWorld.addCableContact(mRigidBodyWorld.getRigidBody(NUMBER_OF_BRIDGE_POINTS * 3), mSphereModel->getRigidBody(), 2.5f, 0.8f);
-
   /*
   std::shared_ptr<DragForce> drag = std::make_shared<DragForce>(0.25f, 0.01f);
   mForceRegistry.addEntry(mBoxModel->getRigidBody(), drag);
@@ -242,6 +267,12 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
 
   VertexBuffer::uploadData(mRenderData, mPolygonVertexBuffer, *mAllMeshes, true);
 
+  /* world and force registry belong to the physics thread from now on */
+  if (!mPhysicsThread.start(mRigidBodyWorld, mForceRegistry)) {
+    Logger::log(1, "%s error: could not start physics thread\n", __FUNCTION__);
+    return false;
+  }
+
   mFrameTimer.start();
 
   Logger::log(1, "%s: Vulkan renderer initialized to %ix%i\n", __FUNCTION__, width, height);
@@ -447,8 +478,33 @@ bool VkRenderer::createVBO() {
 }
 
 bool VkRenderer::createLineVBO() {
-  if (!VertexBuffer::init(mRenderData, mLineVertexBuffer)) {
-    Logger::log(1, "%s error: could not create line vertex buffer\n", __FUNCTION__);
+  mLineVertexBuffers.resize(VkRenderData::rdMaxFramesInFlight);
+  for (auto& lineVertexBuffer : mLineVertexBuffers) {
+    if (!VertexBuffer::init(mRenderData, lineVertexBuffer)) {
+      Logger::log(1, "%s error: could not create line vertex buffer\n", __FUNCTION__);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool VkRenderer::createStagingPool() {
+  if (!StagingPool::init(mRenderData, mStagingBlockSize)) {
+    Logger::log(1, "%s error: could not create staging pool\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
+bool VkRenderer::createUploadRing() {
+  /* every frame uploads the view and projection matrices and the model matrices */
+  std::vector<VkDeviceSize> frameAllocationSizes = {
+    mUboMatrices.size() * sizeof(glm::mat4),
+    mModelMatrices.size() * sizeof(glm::mat4)
+  };
+
+  if (!UploadRing::init(mRenderData, frameAllocationSizes)) {
+    Logger::log(1, "%s error: could not create upload ring\n", __FUNCTION__);
     return false;
   }
   return true;
@@ -479,7 +535,7 @@ bool VkRenderer::createSSBODescriptorPool() {
 }
 
 bool VkRenderer::createSSBO() {
-  if (!ShaderStorageBuffer::init(mRenderData, mObjectMatrixSSBO, 2 * sizeof(glm::mat4))) {
+  if (!ShaderStorageBuffer::init(mRenderData, mObjectMatrixSSBO, mModelMatrices.size() * sizeof(glm::mat4))) {
     Logger::log(1, "%s error: could not create SSBO\n", __FUNCTION__);
     return false;
   }
@@ -507,6 +563,14 @@ bool VkRenderer::createPipelineLayout() {
   return true;
 }
 
+bool VkRenderer::createPipelineCache() {
+  if (!PipelineCache::init(mRenderData, mPipelineCacheFileName)) {
+    Logger::log(1, "%s error: could not create pipeline cache\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
 bool VkRenderer::createBasicPipeline() {
   std::string vertexShaderFile = "shader/basic.vert.spv";
   std::string fragmentShaderFile = "shader/basic.frag.spv";
@@ -648,10 +712,14 @@ bool VkRenderer::createCommandPool() {
 }
 
 bool VkRenderer::createCommandBuffer() {
-  if (!CommandBuffer::init(mRenderData, mRenderData.rdCommandBuffer)) {
-    Logger::log(1, "%s error: could not create command buffers\n", __FUNCTION__);
-    return false;
+  mRenderData.rdCommandBuffers.resize(VkRenderData::rdMaxFramesInFlight, VK_NULL_HANDLE);
+  for (auto& commandBuffer : mRenderData.rdCommandBuffers) {
+    if (!CommandBuffer::init(mRenderData, commandBuffer)) {
+      Logger::log(1, "%s error: could not create command buffers\n", __FUNCTION__);
+      return false;
+    }
   }
+  mRenderData.rdCommandBuffer = mRenderData.rdCommandBuffers.at(0);
   return true;
 }
 
@@ -693,29 +761,40 @@ bool VkRenderer::initUserInterface() {
 }
 
 void VkRenderer::cleanup() {
+  mPhysicsThread.stop();
+
   vkDeviceWaitIdle(mRenderData.rdVkbDevice.device);
 
+  PipelineCache::save(mRenderData, mPipelineCacheFileName);
+
   mUserInterface.cleanup(mRenderData);
 
   Texture::cleanup(mRenderData);
   SyncObjects::cleanup(mRenderData);
-  CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandBuffer);
+  for (const auto& commandBuffer : mRenderData.rdCommandBuffers) {
+    CommandBuffer::cleanup(mRenderData, commandBuffer);
+  }
   CommandPool::cleanup(mRenderData);
   Framebuffer::cleanup(mRenderData);
   Pipeline::cleanup(mRenderData, mRenderData.rdFlatPipeline);
   Pipeline::cleanup(mRenderData, mRenderData.rdLinePipeline);
   Pipeline::cleanup(mRenderData, mRenderData.rdBasicPipeline);
   PipelineLayout::cleanup(mRenderData, mRenderData.rdPipelineLayout);
+  PipelineCache::cleanup(mRenderData);
   Renderpass::cleanup(mRenderData);
 
   UniformBuffer::cleanup(mRenderData);
   ShaderStorageBuffer::cleanup(mRenderData, mObjectMatrixSSBO);
+  UploadRing::cleanup(mRenderData);
 
   VertexBuffer::cleanup(mRenderData, mPolygonVertexBuffer);
-  VertexBuffer::cleanup(mRenderData, mLineVertexBuffer);
+  for (auto& lineVertexBuffer : mLineVertexBuffers) {
+    VertexBuffer::cleanup(mRenderData, lineVertexBuffer);
+  }
 
   vkDestroyImageView(mRenderData.rdVkbDevice.device, mRenderData.rdDepthImageView, nullptr);
   vmaDestroyImage(mRenderData.rdAllocator, mRenderData.rdDepthImage, mRenderData.rdDepthImageAlloc);
+  StagingPool::cleanup(mRenderData);
   vmaDestroyAllocator(mRenderData.rdAllocator);
 
   mRenderData.rdVkbSwapchain.destroy_image_views(mRenderData.rdSwapchainImageViews);
@@ -856,24 +935,33 @@ bool VkRenderer::draw(const float deltaTime) {
 
   handleMovementKeys();
 
-  if (vkWaitForFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdRenderFence, VK_TRUE, UINT64_MAX) != VK_SUCCESS) {
-    Logger::log(1, "%s error: waiting for fence failed\n", __FUNCTION__);
-    return false;
+  /* the number of frames may have been lowered in the UI, every frame index is guarded by its own fence */
+  if (mRenderData.rdCurrentFrame >= static_cast<unsigned int>(mRenderData.rdFramesInFlight)) {
+    mRenderData.rdCurrentFrame = 0;
   }
+  const unsigned int currentFrame = mRenderData.rdCurrentFrame;
+  VkFence renderFence = mRenderData.rdRenderFences.at(currentFrame);
 
-  if (vkResetFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdRenderFence) != VK_SUCCESS) {
-    Logger::log(1, "%s error:  fence reset failed\n", __FUNCTION__);
+  /* wait only for the GPU work submitted rdFramesInFlight frames ago */
+  mWaitForFenceTimer.start();
+  if (vkWaitForFences(mRenderData.rdVkbDevice.device, 1, &renderFence, VK_TRUE, UINT64_MAX) != VK_SUCCESS) {
+    Logger::log(1, "%s error: waiting for fence failed\n", __FUNCTION__);
     return false;
   }
+  mRenderData.rdWaitForFenceTime = mWaitForFenceTimer.stop();
+
+  /* the copies of the last frame with this index are done */
+  StagingPool::beginFrame(mRenderData);
 
   uint32_t imageIndex = 0;
   VkResult result = vkAcquireNextImageKHR(mRenderData.rdVkbDevice.device,
       mRenderData.rdVkbSwapchain.swapchain,
       UINT64_MAX,
-      mRenderData.rdPresentSemaphore,
+      mRenderData.rdPresentSemaphores.at(currentFrame),
       VK_NULL_HANDLE,
       &imageIndex);
 
+  /* the fence stays signaled here, the next frame with this index must not wait forever */
   if (result == VK_ERROR_OUT_OF_DATE_KHR) {
     return recreateSwapchain();
   } else {
@@ -883,6 +971,14 @@ bool VkRenderer::draw(const float deltaTime) {
     }
   }
 
+  if (vkResetFences(mRenderData.rdVkbDevice.device, 1, &renderFence) != VK_SUCCESS) {
+    Logger::log(1, "%s error:  fence reset failed\n", __FUNCTION__);
+    return false;
+  }
+
+  mRenderData.rdCommandBuffer = mRenderData.rdCommandBuffers.at(currentFrame);
+  VkVertexBufferData& lineVertexBuffer = mLineVertexBuffers.at(currentFrame);
+
   VkClearValue colorClearValue;
   colorClearValue.color = { { 0.25f, 0.25f, 0.25f, 1.0f } };
 
@@ -925,35 +1021,58 @@ bool VkRenderer::draw(const float deltaTime) {
     mQuatModelOrientation = glm::quat();
     mSphereModelOrientation = glm::quat();
 
-    initModel();
+    /* the bodies belong to the physics thread */
+    mPhysicsThread.enqueueCommand([this]() { initModel(); });
   }
 
-  /* update physics */
-  mPhysicsTimer.start();
+  /* physics runs on its own thread, only changed UI values are sent over */
   if (mRenderData.rdPhysicsEnabled) {
-    mRigidBodyWorld.startFrame();
-    mWindForce->enable(mRenderData.rdPhysicsWindEnabled);
-
-    mForceRegistry.updateForces(deltaTime);
-
-    mRigidBodyWorld.runPhysics(mRenderData, deltaTime);
-  }
-
-  mRenderData.rdPhysicsTime = mPhysicsTimer.stop();
+    if (mRenderData.rdPhysicsWindEnabled != mPhysicsWindEnabled) {
+      mPhysicsWindEnabled = mRenderData.rdPhysicsWindEnabled;
+      mPhysicsThread.enqueueCommand([wind = mWindForce, enabled = mPhysicsWindEnabled]() { wind->enable(enabled); });
+    }
 
-  /* get new values */
-  mQuatModelPos = mBoxModel->getPosition();
+    PhysicsSettings physicsSettings;
+    physicsSettings.psStepsPerSecond = mRenderData.rdPhysicsStepsPerSecond;
+    physicsSettings.psMaxSubSteps = mRenderData.rdPhysicsMaxSubSteps;
+    physicsSettings.psContactSolver = static_cast<contactSolver>(mRenderData.rdContactSolver);
+    physicsSettings.psImpulseSolverIterations = mRenderData.rdImpulseSolverIterations;
+    physicsSettings.psImpulseSolverWarmStarting = mRenderData.rdImpulseSolverWarmStarting;
+    physicsSettings.psPositionBasedLinks = mRenderData.rdPhysicsPositionBasedLinks;
+    physicsSettings.psPositionBasedIterations = mRenderData.rdPositionBasedIterations;
+    mPhysicsThread.setSettings(physicsSettings);
+  }
+  mPhysicsThread.setPaused(!mRenderData.rdPhysicsEnabled);
+
+  if (mPhysicsThread.updateSnapshot()) {
+    const PhysicsSnapshot& snapshot = mPhysicsThread.getSnapshot();
+    mRenderData.rdPhysicsSteps = snapshot.snSteps;
+    mRenderData.rdPhysicsTime = snapshot.snStepTime;
+    mRenderData.rdContactsIssued = snapshot.snContacts;
+    mRenderData.rdContactResolverIterations = snapshot.snResolverIterations;
+    mRenderData.rdCollisionPairs = snapshot.snCollisionPairs;
+    mRenderData.rdAwakeBodies = snapshot.snAwakeBodies;
+    mRenderData.rdIslands = snapshot.snIslands;
+    mRenderData.rdAwakeIslands = snapshot.snAwakeIslands;
+  }
+  const PhysicsSnapshot& physicsSnapshot = mPhysicsThread.getSnapshot();
+  const int boxBody = mBoxModel->getRigidBody()->getHandle();
+  const int sphereBody = mSphereModel->getRigidBody()->getHandle();
+
+  /* get new values, between the last two physics steps */
+  float physicsAlpha = mPhysicsThread.getInterpolationFactor();
+  mQuatModelPos = physicsSnapshot.getInterpolatedPosition(boxBody, physicsAlpha);
   mRenderData.rdBoxModelPosition = mQuatModelPos;
 
-  mQuatModelOrientation = mBoxModel->getOrientation();
+  mQuatModelOrientation = physicsSnapshot.getInterpolatedOrientation(boxBody, physicsAlpha);
   /* conjugate = same length, but opposite direction*/
   mQuatModelOrientConjugate = glm::conjugate(mQuatModelOrientation);
 
 
-  mSphereModelPos = mSphereModel->getPosition();
+  mSphereModelPos = physicsSnapshot.getInterpolatedPosition(sphereBody, physicsAlpha);
   mRenderData.rdSphereModelPosition = mSphereModelPos;
 
-  mSphereModelOrientation = mSphereModel->getOrientation();
+  mSphereModelOrientation = physicsSnapshot.getInterpolatedOrientation(sphereBody, physicsAlpha);
   mSphereModelOrientConjugate = glm::conjugate(mSphereModelOrientation);
 
 
@@ -972,6 +1091,16 @@ bool VkRenderer::draw(const float deltaTime) {
 
   mRenderData.rdMatrixGenerateTime = mMatrixGenerateTimer.stop();
 
+  /* the dynamic offsets are needed to bind the descriptor sets, so the data is uploaded before recording */
+  mUploadToUBOTimer.start();
+  UploadRing::beginFrame(mRenderData);
+  if (!UniformBuffer::uploadData(mRenderData, mUboMatrices) ||
+      !ShaderStorageBuffer::uploadData(mRenderData, mObjectMatrixSSBO, mModelMatrices)) {
+    return false;
+  }
+  UploadRing::endFrame(mRenderData);
+  mRenderData.rdUploadToUBOTime = mUploadToUBOTimer.stop();
+
   mLineMeshes->vertices.clear();
 
   /* draw a static coordinate system */
@@ -1023,17 +1152,17 @@ bool VkRenderer::draw(const float deltaTime) {
 
   mSpringLineMesh.vertices.clear();
   VkLineVertex anchor1Vertex;
-  anchor1Vertex.position = mRigidBodyWorld.getRigidBody(NUMBER_OF_BRIDGE_POINTS * 3 - 1)->getPosition();
+  anchor1Vertex.position = physicsSnapshot.getInterpolatedPosition(NUMBER_OF_BRIDGE_POINTS * 3 - 1, physicsAlpha);
   anchor1Vertex.color = glm::vec3(0.0f, 1.0f, 0.0f);
   VkLineVertex cableEndVertex;
-  cableEndVertex.position = mBoxModel->getRigidBody()->getPosition();
+  cableEndVertex.position = physicsSnapshot.getInterpolatedPosition(boxBody, physicsAlpha);
   cableEndVertex.color = glm::vec3(1.0f);
   mSpringLineMesh.vertices.push_back(anchor1Vertex);
   mSpringLineMesh.vertices.push_back(cableEndVertex);
 
-  anchor1Vertex.position = mRigidBodyWorld.getRigidBody(NUMBER_OF_BRIDGE_POINTS * 3)->getPosition();
+  anchor1Vertex.position = physicsSnapshot.getInterpolatedPosition(NUMBER_OF_BRIDGE_POINTS * 3, physicsAlpha);
   anchor1Vertex.color = glm::vec3(0.0f, 1.0f, 0.0f);
-  cableEndVertex.position = mSphereModel->getRigidBody()->getPosition();
+  cableEndVertex.position = physicsSnapshot.getInterpolatedPosition(sphereBody, physicsAlpha);
   cableEndVertex.color = glm::vec3(1.0f);
   mSpringLineMesh.vertices.push_back(anchor1Vertex);
   mSpringLineMesh.vertices.push_back(cableEndVertex);
@@ -1041,12 +1170,12 @@ bool VkRenderer::draw(const float deltaTime) {
   /* anchor to plank */
   for (unsigned int i = 0; i < NUMBER_OF_BRIDGE_POINTS * 2; ++i) {
     VkLineVertex anchorVertex;
-    anchorVertex.position = mRigidBodyWorld.getRigidBody(i)->getPosition();
+    anchorVertex.position = physicsSnapshot.getInterpolatedPosition(i, physicsAlpha);
     anchorVertex.color = glm::vec3(0.0f, 1.0f, 0.0f);
     mSpringLineMesh.vertices.push_back(anchorVertex);
 
     VkLineVertex plankVertex;
-    plankVertex.position = mRigidBodyWorld.getRigidBody(i + NUMBER_OF_BRIDGE_POINTS * 2)->getPosition();
+    plankVertex.position = physicsSnapshot.getInterpolatedPosition(i + NUMBER_OF_BRIDGE_POINTS * 2, physicsAlpha);
     plankVertex.color = glm::vec3(1.0f);
     mSpringLineMesh.vertices.push_back(plankVertex);
   }
@@ -1054,12 +1183,12 @@ bool VkRenderer::draw(const float deltaTime) {
   /* planks */
   for (unsigned int i = NUMBER_OF_BRIDGE_POINTS * 2; i < NUMBER_OF_BRIDGE_POINTS * 4; i += 2) {
     VkLineVertex plank1Vertex;
-    plank1Vertex.position = mRigidBodyWorld.getRigidBody(i)->getPosition();
+    plank1Vertex.position = physicsSnapshot.getInterpolatedPosition(i, physicsAlpha);
     plank1Vertex.color = glm::vec3(1.0f, 0.0f, 0.0f);
     mSpringLineMesh.vertices.push_back(plank1Vertex);
 
     VkLineVertex plank2Vertex;
-    plank2Vertex.position = mRigidBodyWorld.getRigidBody(i + 1)->getPosition();
+    plank2Vertex.position = physicsSnapshot.getInterpolatedPosition(i + 1, physicsAlpha);
     plank2Vertex.color = glm::vec3(1.0f, 0.0f, 0.0f);
     mSpringLineMesh.vertices.push_back(plank2Vertex);
   }
@@ -1067,12 +1196,12 @@ bool VkRenderer::draw(const float deltaTime) {
   /* connectens between planks on every side */
   for (unsigned int i = NUMBER_OF_BRIDGE_POINTS * 2; i < NUMBER_OF_BRIDGE_POINTS * 4 - 2; ++i) {
     VkLineVertex plank1Vertex;
-    plank1Vertex.position = mRigidBodyWorld.getRigidBody(i)->getPosition();
+    plank1Vertex.position = physicsSnapshot.getInterpolatedPosition(i, physicsAlpha);
     plank1Vertex.color = glm::vec3(0.0f, 0.0f, 1.0f);
     mSpringLineMesh.vertices.push_back(plank1Vertex);
 
     VkLineVertex plank2Vertex;
-    plank2Vertex.position = mRigidBodyWorld.getRigidBody(i + 2)->getPosition();
+    plank2Vertex.position = physicsSnapshot.getInterpolatedPosition(i + 2, physicsAlpha);
     plank2Vertex.color = glm::vec3(0.0f, 0.0f, 1.0f);
     mSpringLineMesh.vertices.push_back(plank2Vertex);
   }
@@ -1101,7 +1230,7 @@ bool VkRenderer::draw(const float deltaTime) {
 
   /* upload line data to VBO */
   mUploadToVBOTimer.start();
-  VertexBuffer::uploadData(mRenderData, mLineVertexBuffer, *mLineMeshes);
+  VertexBuffer::uploadData(mRenderData, lineVertexBuffer, *mLineMeshes);
   mRenderData.rdUploadToVBOTime = mUploadToVBOTimer.stop();
 
   /* the rendering itself happens here */
@@ -1112,12 +1241,12 @@ bool VkRenderer::draw(const float deltaTime) {
   vkCmdSetScissor(mRenderData.rdCommandBuffer, 0, 1, &scissor);
 
   vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdPipelineLayout, 0, 1, &mRenderData.rdTextureDescriptorSet, 0, nullptr);
-  vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdPipelineLayout, 1, 1, &mRenderData.rdUBODescriptorSet, 0, nullptr);
-  vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdPipelineLayout, 2, 1, &mObjectMatrixSSBO.rdSSBODescriptorSet, 0, nullptr);
+  vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdPipelineLayout, 1, 1, &mRenderData.rdUBODescriptorSet, 1, &mRenderData.rdUBODynamicOffset);
+  vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdPipelineLayout, 2, 1, &mObjectMatrixSSBO.rdSSBODescriptorSet, 1, &mObjectMatrixSSBO.rdSsboDynamicOffset);
 
   /* vertex buffer */
   VkDeviceSize offset = 0;
-  vkCmdBindVertexBuffers(mRenderData.rdCommandBuffer, 0, 1, &mLineVertexBuffer.rdVertexBuffer, &offset);
+  vkCmdBindVertexBuffers(mRenderData.rdCommandBuffer, 0, 1, &lineVertexBuffer.rdVertexBuffer, &offset);
 
   /* draw lines first */
   if (mLineIndexCount > 0) {
@@ -1153,12 +1282,6 @@ bool VkRenderer::draw(const float deltaTime) {
     return false;
   }
 
-  /* upload UBO and SSBO data after commands are created */
-  mUploadToUBOTimer.start();
-  UniformBuffer::uploadData(mRenderData, mUboMatrices);
-  ShaderStorageBuffer::uploadData(mRenderData, mObjectMatrixSSBO, mModelMatrices);
-  mRenderData.rdUploadToUBOTime = mUploadToUBOTimer.stop();
-
   /* submit command buffer */
   VkSubmitInfo submitInfo{};
   submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -1167,23 +1290,26 @@ bool VkRenderer::draw(const float deltaTime) {
   submitInfo.pWaitDstStageMask = &waitStage;
 
   submitInfo.waitSemaphoreCount = 1;
-  submitInfo.pWaitSemaphores = &mRenderData.rdPresentSemaphore;
+  submitInfo.pWaitSemaphores = &mRenderData.rdPresentSemaphores.at(currentFrame);
 
   submitInfo.signalSemaphoreCount = 1;
-  submitInfo.pSignalSemaphores = &mRenderData.rdRenderSemaphore;
+  submitInfo.pSignalSemaphores = &mRenderData.rdRenderSemaphores.at(currentFrame);
 
   submitInfo.commandBufferCount = 1;
   submitInfo.pCommandBuffers = &mRenderData.rdCommandBuffer;
 
-  if (vkQueueSubmit(mRenderData.rdGraphicsQueue, 1, &submitInfo, mRenderData.rdRenderFence) != VK_SUCCESS) {
+  if (vkQueueSubmit(mRenderData.rdGraphicsQueue, 1, &submitInfo, renderFence) != VK_SUCCESS) {
     Logger::log(1, "%s error: failed to submit draw command buffer\n", __FUNCTION__);
     return false;
   }
 
+  /* advance before presenting, a swapchain recreation below returns early */
+  mRenderData.rdCurrentFrame = (currentFrame + 1) % mRenderData.rdFramesInFlight;
+
   VkPresentInfoKHR presentInfo{};
   presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
   presentInfo.waitSemaphoreCount = 1;
-  presentInfo.pWaitSemaphores = &mRenderData.rdRenderSemaphore;
+  presentInfo.pWaitSemaphores = &mRenderData.rdRenderSemaphores.at(currentFrame);
 
   presentInfo.swapchainCount = 1;
   presentInfo.pSwapchains = &mRenderData.rdVkbSwapchain.swapchain;
@@ -18,12 +18,15 @@
 #include "Timer.h"
 #include "Renderpass.h"
 #include "Pipeline.h"
+#include "PipelineCache.h"
 #include "PipelineLayout.h"
 #include "Framebuffer.h"
 #include "CommandPool.h"
 #include "CommandBuffer.h"
 #include "SyncObjects.h"
 #include "Texture.h"
+#include "UploadRing.h"
+#include "StagingPool.h"
 #include "UniformBuffer.h"
 #include "VertexBuffer.h"
 #include "ShaderStorageBuffer.h"
@@ -38,6 +41,7 @@
 #include "RigidBodyWorld.h"
 #include "ForceRegistry.h"
 #include "WindForce.h"
+#include "PhysicsThread.h"
 
 #include "VkRenderData.h"
 
@@ -60,7 +64,8 @@ class VkRenderer {
   private:
     VkRenderData mRenderData{};
 
-    VkVertexBufferData mLineVertexBuffer{};
+    /* the line data changes every frame, one buffer per frame in flight */
+    std::vector<VkVertexBufferData> mLineVertexBuffers{};
     VkVertexBufferData mPolygonVertexBuffer{};
 
     VkShaderStorageBufferData mObjectMatrixSSBO{};
@@ -84,9 +89,13 @@ class VkRenderer {
 
     RigidBodyWorld mRigidBodyWorld = RigidBodyWorld(NUMBER_OF_BRIDGE_POINTS * 10, NUMBER_OF_BRIDGE_POINTS * 20);
 
-    ForceRegistry mForceRegistry{};
+    ForceRegistry mForceRegistry = ForceRegistry(mRigidBodyWorld.getRigidBodyStorage());
     std::shared_ptr<WindForce> mWindForce = nullptr;
 
+    /* steps world and forces, the renderer only reads the published snapshots */
+    PhysicsThread mPhysicsThread{};
+    bool mPhysicsWindEnabled = false;
+
     std::shared_ptr<BoxModel> mBoxModel = nullptr;
     std::unique_ptr<VkMesh> mQuatModelMesh = nullptr;
 
@@ -131,12 +140,17 @@ class VkRenderer {
     int mCameraUpDown = 0;
 
     Timer mFrameTimer{};
+    Timer mWaitForFenceTimer{};
     Timer mMatrixGenerateTimer{};
     Timer mUploadToVBOTimer{};
     Timer mUploadToUBOTimer{};
     Timer mUIGenerateTimer{};
     Timer mUIDrawTimer{};
-    Timer mPhysicsTimer{};
+    Timer mPipelineCreationTimer{};
+
+    const std::string mPipelineCacheFileName = "pipeline_cache.bin";
+    /* larger uploads get a block of their own */
+    const VkDeviceSize mStagingBlockSize = 4 * 1024 * 1024;
 
     VkSurfaceKHR mSurface = VK_NULL_HANDLE;
 
@@ -148,6 +162,8 @@ class VkRenderer {
     bool createVBO();
     bool createLineVBO();
 
+    bool createStagingPool();
+    bool createUploadRing();
     bool createUBODescriptorPool();
     bool createUBO();
 
@@ -157,6 +173,7 @@ class VkRenderer {
     bool createSwapchain();
     bool createRenderPass();
     bool createPipelineLayout();
+    bool createPipelineCache();
     bool createBasicPipeline();
     bool createLinePipeline();
     bool createFlatPipeline();
@@ -0,0 +1,92 @@
+#include <fstream>
+#include <cstring>
+
+#include "PipelineCache.h"
+#include "Logger.h"
+
+#include <VkBootstrap.h>
+
+bool PipelineCache::init(VkRenderData &renderData, const std::string cacheFileName) {
+  std::string cacheData;
+
+  std::ifstream inFile(cacheFileName, std::ios::binary);
+  if (inFile.is_open()) {
+    cacheData.assign((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    inFile.close();
+  }
+
+  if (!cacheData.empty() && !isCacheDataValid(renderData, cacheData)) {
+    Logger::log(1, "%s: pipeline cache '%s' does not match the device, ignoring it\n", __FUNCTION__,
+      cacheFileName.c_str());
+    cacheData.clear();
+  }
+
+  VkPipelineCacheCreateInfo cacheInfo{};
+  cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  cacheInfo.initialDataSize = cacheData.size();
+  cacheInfo.pInitialData = cacheData.empty() ? nullptr : cacheData.data();
+
+  if (vkCreatePipelineCache(renderData.rdVkbDevice.device, &cacheInfo, nullptr, &renderData.rdPipelineCache) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not create pipeline cache\n", __FUNCTION__);
+    return false;
+  }
+
+  renderData.rdPipelineCacheLoaded = !cacheData.empty();
+  Logger::log(1, "%s: created pipeline cache with %zu bytes of data from '%s'\n", __FUNCTION__,
+    cacheData.size(), cacheFileName.c_str());
+  return true;
+}
+
+bool PipelineCache::save(VkRenderData &renderData, const std::string cacheFileName) {
+  if (renderData.rdPipelineCache == VK_NULL_HANDLE) {
+    return false;
+  }
+
+  size_t dataSize = 0;
+  if (vkGetPipelineCacheData(renderData.rdVkbDevice.device, renderData.rdPipelineCache, &dataSize, nullptr) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not get pipeline cache size\n", __FUNCTION__);
+    return false;
+  }
+
+  std::string cacheData(dataSize, '\0');
+  if (vkGetPipelineCacheData(renderData.rdVkbDevice.device, renderData.rdPipelineCache, &dataSize, cacheData.data()) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not get pipeline cache data\n", __FUNCTION__);
+    return false;
+  }
+
+  std::ofstream outFile(cacheFileName, std::ios::binary | std::ios::trunc);
+  if (!outFile.is_open()) {
+    Logger::log(1, "%s error: could not open '%s' for writing\n", __FUNCTION__, cacheFileName.c_str());
+    return false;
+  }
+  outFile.write(cacheData.data(), dataSize);
+  outFile.close();
+
+  Logger::log(1, "%s: saved %zu bytes of pipeline cache data to '%s'\n", __FUNCTION__, dataSize, cacheFileName.c_str());
+  return true;
+}
+
+void PipelineCache::cleanup(VkRenderData &renderData) {
+  vkDestroyPipelineCache(renderData.rdVkbDevice.device, renderData.rdPipelineCache, nullptr);
+  renderData.rdPipelineCache = VK_NULL_HANDLE;
+}
+
+bool PipelineCache::isCacheDataValid(VkRenderData &renderData, const std::string &cacheData) {
+  /* header version one: length, version, vendor ID, device ID, pipeline cache UUID */
+  const size_t headerSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+  if (cacheData.size() < headerSize) {
+    return false;
+  }
+
+  uint32_t header[4];
+  std::memcpy(header, cacheData.data(), sizeof(header));
+
+  const VkPhysicalDeviceProperties &properties = renderData.rdVkbPhysicalDevice.properties;
+  if (header[0] < headerSize || header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+      header[2] != properties.vendorID || header[3] != properties.deviceID) {
+    return false;
+  }
+
+  /* a new driver version changes the UUID */
+  return std::memcmp(cacheData.data() + sizeof(header), properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
@@ -6,8 +6,8 @@
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #include <stb_image_resize2.h>
 
-#include "CommandBuffer.h"
 #include "Texture.h"
+#include "UploadManager.h"
 #include "Logger.h"
 
 bool Texture::loadTexture(VkRenderData &renderData, std::string textureFilename, bool generateMipMaps) {
@@ -106,116 +106,20 @@ bool Texture::loadTexture(VkRenderData &renderData, std::string textureFilename,
     return false;
   }
 
-  /* staging buffers */
-  std::vector<VkBufferCreateInfo> stagingBufferInfos{};
-  stagingBufferInfos.resize(mipMapLevels);
-
-  std::vector<VkBuffer> stagingBuffers{};
-  stagingBuffers.resize(mipMapLevels);
-
-  std::vector<VmaAllocation> stagingBufferAllocs{};
-  stagingBufferAllocs.resize(mipMapLevels);
-
-  std::vector<VmaAllocationCreateInfo> stagingAllocInfos{};
-  stagingAllocInfos.resize(mipMapLevels);
-
-  /* fill structs */
-  for (unsigned int i = 0; i < mipMapLevels; ++i) {
-    stagingBufferInfos.at(i).sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    stagingBufferInfos.at(i).size = imageSizes.at(i);
-    stagingBufferInfos.at(i).usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-    stagingAllocInfos.at(i).usage = VMA_MEMORY_USAGE_CPU_ONLY;
-  }
-
-  for (unsigned int i = 0; i < mipMapLevels; ++i) {
-    if (vmaCreateBuffer(renderData.rdAllocator, &stagingBufferInfos.at(i), &stagingAllocInfos.at(i), &stagingBuffers.at(i),
-        &stagingBufferAllocs.at(i), nullptr) != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate texture staging buffer %i via VMA\n", __FUNCTION__, i);
-      return false;
-    }
-  }
-
-  /* copy data to staging buffers */
-  void* data;
-  for (unsigned int i = 0; i < mipMapLevels; ++i) {
-    vmaMapMemory(renderData.rdAllocator, stagingBufferAllocs.at(i), &data);
-    std::memcpy(data, textureData.at(i), static_cast<uint32_t>(imageSizes.at(i)));
-    vmaUnmapMemory(renderData.rdAllocator, stagingBufferAllocs.at(i));
-  }
+  /* the levels are copied into staging memory right away, the transfer runs while the renderer is created */
+  bool uploadResult = UploadManager::uploadImage(renderData, renderData.rdTextureImage, textureData, imageSizes,
+    textureExtents);
 
   /* and free images */
   for (unsigned int i = 1; i < mipMapLevels; ++i) {
     stbi_image_free(textureData.at(i));
   }
 
-  VkImageSubresourceRange stagingBufferRange{};
-  stagingBufferRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-  stagingBufferRange.baseMipLevel = 0;
-  stagingBufferRange.levelCount = 1;
-  stagingBufferRange.baseArrayLayer = 0;
-  stagingBufferRange.layerCount = 1;
-
-  /* 1st barrier, undefined to transfer optimal */
-  VkImageMemoryBarrier stagingBufferTransferBarrier{};
-  stagingBufferTransferBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  stagingBufferTransferBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-  stagingBufferTransferBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-  stagingBufferTransferBarrier.image = renderData.rdTextureImage;
-  stagingBufferTransferBarrier.subresourceRange = stagingBufferRange;
-  stagingBufferTransferBarrier.srcAccessMask = 0;
-  stagingBufferTransferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-  /* 2nd barrier, transfer optimal to shader optimal */
-  VkImageMemoryBarrier stagingBufferShaderBarrier{};
-  stagingBufferShaderBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  stagingBufferShaderBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-  stagingBufferShaderBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-  stagingBufferShaderBarrier.image = renderData.rdTextureImage;
-  stagingBufferShaderBarrier.subresourceRange = stagingBufferRange;
-  stagingBufferShaderBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-  stagingBufferShaderBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-  /* copy command data */
-  std::vector<VkBufferImageCopy> stagingBufferCopies{};
-  stagingBufferCopies.resize(mipMapLevels);
-
-  for (unsigned int i = 0; i < mipMapLevels; ++i) {
-    stagingBufferCopies.at(i).bufferOffset = 0;
-    stagingBufferCopies.at(i).bufferRowLength = 0;
-    stagingBufferCopies.at(i).bufferImageHeight = 0;
-    stagingBufferCopies.at(i).imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    stagingBufferCopies.at(i).imageSubresource.mipLevel = i;
-    stagingBufferCopies.at(i).imageSubresource.baseArrayLayer = 0;
-    stagingBufferCopies.at(i).imageSubresource.layerCount = 1;
-    stagingBufferCopies.at(i).imageExtent = textureExtents.at(i);
-  }
-
-  /* create the command buffer for the copy loop */
-  VkCommandBuffer uploadCommandBuffer = CommandBuffer::createSingleShotBuffer(renderData);
-
-  for (unsigned int i = 0; i < mipMapLevels; ++i) {
-    stagingBufferTransferBarrier.subresourceRange.baseMipLevel = i;
-    vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferTransferBarrier);
-
-    vkCmdCopyBufferToImage(uploadCommandBuffer, stagingBuffers.at(i), renderData.rdTextureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &stagingBufferCopies.at(i));
-
-    stagingBufferShaderBarrier.subresourceRange.baseMipLevel = i;
-    vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferShaderBarrier);
-  }
-
-  bool commandResult = CommandBuffer::submitSingleShotBuffer(renderData, uploadCommandBuffer, renderData.rdGraphicsQueue);
-
-  if (!commandResult) {
-    Logger::log(1, "%s error: could not submit texture transfer commands", __FUNCTION__);
+  if (!uploadResult) {
+    Logger::log(1, "%s error: could not upload texture data\n", __FUNCTION__);
     return false;
   }
 
-  /* remove staging buffers */
-  for (unsigned int i = 0; i < mipMapLevels; ++i) {
-    vmaDestroyBuffer(renderData.rdAllocator, stagingBuffers.at(i), stagingBufferAllocs.at(i));
-  }
-
   /* image view and sampler */
   VkImageViewCreateInfo texViewInfo{};
   texViewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
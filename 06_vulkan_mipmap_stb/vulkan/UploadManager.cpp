@@ -0,0 +1,303 @@
+#include "UploadManager.h"
+#include "StagingPool.h"
+#include "Logger.h"
+
+#include <VkBootstrap.h>
+
+bool UploadManager::init(VkRenderData &renderData) {
+  VkUploadManagerData &uploadData = renderData.rdUploadManager;
+  uploadData.rdGraphicsQueueFamily = renderData.rdVkbDevice.get_queue_index(vkb::QueueType::graphics).value();
+
+  /* a transfer-only queue family is the best choice, then a family without graphics, then the graphics queue */
+  auto dedicatedQueueRet = renderData.rdVkbDevice.get_dedicated_queue(vkb::QueueType::transfer);
+  auto separateQueueRet = renderData.rdVkbDevice.get_queue(vkb::QueueType::transfer);
+  if (dedicatedQueueRet.has_value()) {
+    uploadData.rdTransferQueue = dedicatedQueueRet.value();
+    uploadData.rdTransferQueueFamily = renderData.rdVkbDevice.get_dedicated_queue_index(vkb::QueueType::transfer).value();
+    Logger::log(1, "%s: using dedicated transfer queue family %u\n", __FUNCTION__, uploadData.rdTransferQueueFamily);
+  } else if (separateQueueRet.has_value()) {
+    uploadData.rdTransferQueue = separateQueueRet.value();
+    uploadData.rdTransferQueueFamily = renderData.rdVkbDevice.get_queue_index(vkb::QueueType::transfer).value();
+    Logger::log(1, "%s: using separate transfer queue family %u\n", __FUNCTION__, uploadData.rdTransferQueueFamily);
+  } else {
+    uploadData.rdTransferQueue = renderData.rdGraphicsQueue;
+    uploadData.rdTransferQueueFamily = uploadData.rdGraphicsQueueFamily;
+    Logger::log(1, "%s: no transfer queue found, uploading on the graphics queue\n", __FUNCTION__);
+  }
+
+  VkCommandPoolCreateInfo poolCreateInfo{};
+  poolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  poolCreateInfo.queueFamilyIndex = uploadData.rdTransferQueueFamily;
+  poolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+  if (vkCreateCommandPool(renderData.rdVkbDevice.device, &poolCreateInfo, nullptr, &uploadData.rdTransferCommandPool) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not create transfer command pool\n", __FUNCTION__);
+    return false;
+  }
+
+  return true;
+}
+
+bool UploadManager::uploadImage(VkRenderData &renderData, VkImage image, const std::vector<unsigned char*> &levelData,
+    const std::vector<VkDeviceSize> &levelSizes, const std::vector<VkExtent3D> &levelExtents) {
+  VkUploadManagerData &uploadData = renderData.rdUploadManager;
+  const uint32_t mipMapLevels = static_cast<uint32_t>(levelData.size());
+
+  if (!beginBatch(renderData)) {
+    return false;
+  }
+
+  /* staging memory from the pool, all levels usually end up in the same block */
+  std::vector<VkBufferImageCopy> stagingBufferCopies{};
+  stagingBufferCopies.resize(mipMapLevels);
+  std::vector<VkStagingAllocation> stagingAllocations{};
+  stagingAllocations.resize(mipMapLevels);
+
+  for (uint32_t i = 0; i < mipMapLevels; ++i) {
+    if (!createStagingBuffer(renderData, levelData.at(i), levelSizes.at(i), stagingAllocations.at(i))) {
+      Logger::log(1, "%s error: could not get staging memory for level %u\n", __FUNCTION__, i);
+      return false;
+    }
+
+    stagingBufferCopies.at(i).bufferOffset = stagingAllocations.at(i).saOffset;
+    stagingBufferCopies.at(i).bufferRowLength = 0;
+    stagingBufferCopies.at(i).bufferImageHeight = 0;
+    stagingBufferCopies.at(i).imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    stagingBufferCopies.at(i).imageSubresource.mipLevel = i;
+    stagingBufferCopies.at(i).imageSubresource.baseArrayLayer = 0;
+    stagingBufferCopies.at(i).imageSubresource.layerCount = 1;
+    stagingBufferCopies.at(i).imageExtent = levelExtents.at(i);
+  }
+  VkCommandBuffer commandBuffer = uploadData.rdRecordingBatch.ubCommandBuffer;
+
+  VkImageSubresourceRange imageRange{};
+  imageRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  imageRange.baseMipLevel = 0;
+  imageRange.levelCount = mipMapLevels;
+  imageRange.baseArrayLayer = 0;
+  imageRange.layerCount = 1;
+
+  /* 1st barrier, undefined to transfer optimal, for all levels at once */
+  VkImageMemoryBarrier transferBarrier{};
+  transferBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  transferBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  transferBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  transferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  transferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  transferBarrier.image = image;
+  transferBarrier.subresourceRange = imageRange;
+  transferBarrier.srcAccessMask = 0;
+  transferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+    0, nullptr, 0, nullptr, 1, &transferBarrier);
+  for (uint32_t i = 0; i < mipMapLevels; ++i) {
+    vkCmdCopyBufferToImage(commandBuffer, stagingAllocations.at(i).saBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      1, &stagingBufferCopies.at(i));
+  }
+
+  /* 2nd barrier, transfer optimal to shader optimal */
+  VkImageMemoryBarrier shaderBarrier{};
+  shaderBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  shaderBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  shaderBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  shaderBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  shaderBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  shaderBarrier.image = image;
+  shaderBarrier.subresourceRange = imageRange;
+  shaderBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  shaderBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+  if (uploadData.rdTransferQueueFamily == uploadData.rdGraphicsQueueFamily) {
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+      0, nullptr, 0, nullptr, 1, &shaderBarrier);
+    return true;
+  }
+
+  /* release and acquire must both contain the same layout transition */
+  shaderBarrier.srcQueueFamilyIndex = uploadData.rdTransferQueueFamily;
+  shaderBarrier.dstQueueFamilyIndex = uploadData.rdGraphicsQueueFamily;
+
+  VkImageMemoryBarrier releaseBarrier = shaderBarrier;
+  releaseBarrier.dstAccessMask = 0;
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+    0, nullptr, 0, nullptr, 1, &releaseBarrier);
+
+  shaderBarrier.srcAccessMask = 0;
+  uploadData.rdRecordingBatch.ubImageAcquireBarriers.emplace_back(shaderBarrier);
+  uploadData.rdRecordingBatch.ubAcquireStages |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+  return true;
+}
+
+uint64_t UploadManager::submit(VkRenderData &renderData) {
+  VkUploadManagerData &uploadData = renderData.rdUploadManager;
+  VkUploadBatchData &batch = uploadData.rdRecordingBatch;
+
+  /* nothing recorded, done as soon as the last batch is done */
+  if (batch.ubCommandBuffer == VK_NULL_HANDLE) {
+    return uploadData.rdNextBatchId - 1;
+  }
+
+  if (vkEndCommandBuffer(batch.ubCommandBuffer) != VK_SUCCESS) {
+    Logger::log(1, "%s error: failed to end upload command buffer\n", __FUNCTION__);
+    return 0;
+  }
+
+  batch.ubFence = getFence(renderData);
+  if (batch.ubFence == VK_NULL_HANDLE) {
+    return 0;
+  }
+
+  VkSubmitInfo submitInfo{};
+  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &batch.ubCommandBuffer;
+
+  if (vkQueueSubmit(uploadData.rdTransferQueue, 1, &submitInfo, batch.ubFence) != VK_SUCCESS) {
+    Logger::log(1, "%s error: failed to submit upload command buffer\n", __FUNCTION__);
+    return 0;
+  }
+
+  batch.ubId = uploadData.rdNextBatchId++;
+  Logger::log(1, "%s: submitted upload batch %llu with %zu staging allocations\n", __FUNCTION__,
+    static_cast<unsigned long long>(batch.ubId), batch.ubStagingAllocations.size());
+
+  uint64_t batchId = batch.ubId;
+  uploadData.rdPendingBatches.emplace_back(std::move(batch));
+  uploadData.rdRecordingBatch = VkUploadBatchData{};
+  return batchId;
+}
+
+void UploadManager::update(VkRenderData &renderData, VkCommandBuffer commandBuffer) {
+  VkUploadManagerData &uploadData = renderData.rdUploadManager;
+
+  std::vector<VkImageMemoryBarrier> imageBarriers{};
+  VkPipelineStageFlags acquireStages = 0;
+
+  /* the batches of one queue finish in submission order */
+  auto batch = uploadData.rdPendingBatches.begin();
+  while (batch != uploadData.rdPendingBatches.end()) {
+    if (vkGetFenceStatus(renderData.rdVkbDevice.device, batch->ubFence) != VK_SUCCESS) {
+      break;
+    }
+
+    imageBarriers.insert(imageBarriers.end(), batch->ubImageAcquireBarriers.begin(), batch->ubImageAcquireBarriers.end());
+    acquireStages |= batch->ubAcquireStages;
+
+    uploadData.rdCompletedBatchId = batch->ubId;
+    freeBatch(renderData, *batch);
+    batch = uploadData.rdPendingBatches.erase(batch);
+  }
+
+  if (!imageBarriers.empty()) {
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, acquireStages, 0, 0, nullptr,
+      0, nullptr, static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+  }
+}
+
+bool UploadManager::isBatchComplete(VkRenderData &renderData, const uint64_t batchId) {
+  return batchId <= renderData.rdUploadManager.rdCompletedBatchId;
+}
+
+void UploadManager::cleanup(VkRenderData &renderData) {
+  VkUploadManagerData &uploadData = renderData.rdUploadManager;
+
+  if (uploadData.rdTransferQueue != VK_NULL_HANDLE) {
+    vkQueueWaitIdle(uploadData.rdTransferQueue);
+  }
+
+  for (auto &batch : uploadData.rdPendingBatches) {
+    freeBatch(renderData, batch);
+  }
+  uploadData.rdPendingBatches.clear();
+  freeBatch(renderData, uploadData.rdRecordingBatch);
+
+  for (const auto &fence : uploadData.rdFreeFences) {
+    vkDestroyFence(renderData.rdVkbDevice.device, fence, nullptr);
+  }
+  uploadData.rdFreeFences.clear();
+
+  vkDestroyCommandPool(renderData.rdVkbDevice.device, uploadData.rdTransferCommandPool, nullptr);
+}
+
+bool UploadManager::beginBatch(VkRenderData &renderData) {
+  VkUploadManagerData &uploadData = renderData.rdUploadManager;
+  if (uploadData.rdRecordingBatch.ubCommandBuffer != VK_NULL_HANDLE) {
+    return true;
+  }
+
+  VkCommandBufferAllocateInfo bufferAllocInfo{};
+  bufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  bufferAllocInfo.commandPool = uploadData.rdTransferCommandPool;
+  bufferAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  bufferAllocInfo.commandBufferCount = 1;
+
+  if (vkAllocateCommandBuffers(renderData.rdVkbDevice.device, &bufferAllocInfo,
+      &uploadData.rdRecordingBatch.ubCommandBuffer) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not allocate upload command buffer\n", __FUNCTION__);
+    return false;
+  }
+
+  VkCommandBufferBeginInfo cmdBeginInfo{};
+  cmdBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  cmdBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+  if (vkBeginCommandBuffer(uploadData.rdRecordingBatch.ubCommandBuffer, &cmdBeginInfo) != VK_SUCCESS) {
+    Logger::log(1, "%s error: failed to begin upload command buffer\n", __FUNCTION__);
+    return false;
+  }
+
+  return true;
+}
+
+bool UploadManager::createStagingBuffer(VkRenderData &renderData, const void *data, const VkDeviceSize dataSize,
+    VkStagingAllocation &stagingAllocation) {
+  if (!StagingPool::allocate(renderData, data, dataSize, stagingAllocation)) {
+    Logger::log(1, "%s error: could not get %llu bytes of staging memory\n", __FUNCTION__,
+      static_cast<unsigned long long>(dataSize));
+    return false;
+  }
+
+  renderData.rdUploadManager.rdRecordingBatch.ubStagingAllocations.emplace_back(stagingAllocation);
+  return true;
+}
+
+VkFence UploadManager::getFence(VkRenderData &renderData) {
+  VkUploadManagerData &uploadData = renderData.rdUploadManager;
+  if (!uploadData.rdFreeFences.empty()) {
+    VkFence fence = uploadData.rdFreeFences.back();
+    uploadData.rdFreeFences.pop_back();
+    return fence;
+  }
+
+  VkFenceCreateInfo fenceInfo{};
+  fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+  VkFence fence;
+  if (vkCreateFence(renderData.rdVkbDevice.device, &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+    Logger::log(1, "%s error: failed to create upload fence\n", __FUNCTION__);
+    return VK_NULL_HANDLE;
+  }
+  return fence;
+}
+
+void UploadManager::freeBatch(VkRenderData &renderData, VkUploadBatchData &batch) {
+  VkUploadManagerData &uploadData = renderData.rdUploadManager;
+
+  for (const auto &stagingAllocation : batch.ubStagingAllocations) {
+    StagingPool::release(renderData, stagingAllocation);
+  }
+  batch.ubStagingAllocations.clear();
+
+  if (batch.ubCommandBuffer != VK_NULL_HANDLE) {
+    vkFreeCommandBuffers(renderData.rdVkbDevice.device, uploadData.rdTransferCommandPool, 1, &batch.ubCommandBuffer);
+    batch.ubCommandBuffer = VK_NULL_HANDLE;
+  }
+
+  /* back into the pool */
+  if (batch.ubFence != VK_NULL_HANDLE) {
+    vkResetFences(renderData.rdVkbDevice.device, 1, &batch.ubFence);
+    uploadData.rdFreeFences.emplace_back(batch.ubFence);
+    batch.ubFence = VK_NULL_HANDLE;
+  }
+}
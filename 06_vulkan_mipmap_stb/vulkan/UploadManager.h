@@ -0,0 +1,33 @@
+/* asynchronous image uploads, using a transfer queue if the device has one */
+#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkRenderData.h"
+
+class UploadManager {
+  public:
+    static bool init(VkRenderData &renderData);
+
+    /* copies every mip level of the image and transitions the whole image to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+     * the copies are recorded into the current batch, the data is copied into the staging pool immediately */
+    static bool uploadImage(VkRenderData &renderData, VkImage image, const std::vector<unsigned char*> &levelData,
+      const std::vector<VkDeviceSize> &levelSizes, const std::vector<VkExtent3D> &levelExtents);
+
+    /* submits the current batch without waiting, returns the id of the batch or 0 on errors */
+    static uint64_t submit(VkRenderData &renderData);
+    /* frees finished batches and records their queue family acquire barriers into the command buffer,
+     * must be called outside of a render pass */
+    static void update(VkRenderData &renderData, VkCommandBuffer commandBuffer);
+    static bool isBatchComplete(VkRenderData &renderData, const uint64_t batchId);
+
+    static void cleanup(VkRenderData &renderData);
+
+  private:
+    static bool beginBatch(VkRenderData &renderData);
+    static bool createStagingBuffer(VkRenderData &renderData, const void *data, const VkDeviceSize dataSize,
+      VkStagingAllocation &stagingAllocation);
+    static VkFence getFence(VkRenderData &renderData);
+    static void freeBatch(VkRenderData &renderData, VkUploadBatchData &batch);
+};
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cstring>
+
+#include "UploadRing.h"
+#include "Logger.h"
+
+#include <VkBootstrap.h>
+
+bool UploadRing::init(VkRenderData &renderData, const std::vector<VkDeviceSize> &frameAllocationSizes) {
+  VkUploadRingData &ringData = renderData.rdUploadRing;
+
+  /* dynamic offsets must be multiples of the offset alignment of both buffer types */
+  const VkPhysicalDeviceLimits &limits = renderData.rdVkbPhysicalDevice.properties.limits;
+  ringData.rdAlignment = std::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment);
+
+  ringData.rdFrameRegionSize = 0;
+  for (const auto size : frameAllocationSizes) {
+    ringData.rdFrameRegionSize += getAlignedSize(ringData, size);
+  }
+
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size = ringData.rdFrameRegionSize * VkRenderData::rdMaxFramesInFlight;
+  bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+  /* mapped once, the memory stays mapped until the buffer is destroyed */
+  VmaAllocationCreateInfo vmaAllocInfo{};
+  vmaAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+  vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+  VmaAllocationInfo allocInfo{};
+  if (vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo, &ringData.rdRingBuffer,
+      &ringData.rdRingBufferAlloc, &allocInfo) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not allocate upload ring buffer via VMA\n", __FUNCTION__);
+    return false;
+  }
+  ringData.rdMappedData = static_cast<char*>(allocInfo.pMappedData);
+
+  Logger::log(1, "%s: created upload ring with %i regions of %llu bytes (alignment %llu)\n", __FUNCTION__,
+    VkRenderData::rdMaxFramesInFlight, static_cast<unsigned long long>(ringData.rdFrameRegionSize),
+    static_cast<unsigned long long>(ringData.rdAlignment));
+  return true;
+}
+
+void UploadRing::beginFrame(VkRenderData &renderData) {
+  VkUploadRingData &ringData = renderData.rdUploadRing;
+  ringData.rdFrameRegionStart = renderData.rdCurrentFrame * ringData.rdFrameRegionSize;
+  ringData.rdFrameRegionUsed = 0;
+}
+
+bool UploadRing::uploadData(VkRenderData &renderData, const void *data, const VkDeviceSize dataSize, uint32_t &dynamicOffset) {
+  VkUploadRingData &ringData = renderData.rdUploadRing;
+
+  VkDeviceSize alignedSize = getAlignedSize(ringData, dataSize);
+  if (ringData.rdFrameRegionUsed + alignedSize > ringData.rdFrameRegionSize) {
+    Logger::log(1, "%s error: %llu bytes do not fit into the frame region (%llu of %llu bytes used)\n", __FUNCTION__,
+      static_cast<unsigned long long>(dataSize), static_cast<unsigned long long>(ringData.rdFrameRegionUsed),
+      static_cast<unsigned long long>(ringData.rdFrameRegionSize));
+    return false;
+  }
+
+  dynamicOffset = static_cast<uint32_t>(ringData.rdFrameRegionStart + ringData.rdFrameRegionUsed);
+  std::memcpy(ringData.rdMappedData + dynamicOffset, data, dataSize);
+  ringData.rdFrameRegionUsed += alignedSize;
+  return true;
+}
+
+void UploadRing::endFrame(VkRenderData &renderData) {
+  VkUploadRingData &ringData = renderData.rdUploadRing;
+  if (ringData.rdFrameRegionUsed == 0) {
+    return;
+  }
+
+  /* no-op for host coherent memory */
+  vmaFlushAllocation(renderData.rdAllocator, ringData.rdRingBufferAlloc, ringData.rdFrameRegionStart,
+    ringData.rdFrameRegionUsed);
+}
+
+void UploadRing::cleanup(VkRenderData &renderData) {
+  VkUploadRingData &ringData = renderData.rdUploadRing;
+  vmaDestroyBuffer(renderData.rdAllocator, ringData.rdRingBuffer, ringData.rdRingBufferAlloc);
+  ringData.rdRingBuffer = VK_NULL_HANDLE;
+  ringData.rdRingBufferAlloc = nullptr;
+  ringData.rdMappedData = nullptr;
+}
+
+VkDeviceSize UploadRing::getAlignedSize(const VkUploadRingData &ringData, const VkDeviceSize size) {
+  /* the offset alignments are powers of two */
+  return (size + ringData.rdAlignment - 1) & ~(ringData.rdAlignment - 1);
+}
@@ -0,0 +1,23 @@
+/* persistently mapped ring buffer for per-frame uniform and storage data */
+#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkRenderData.h"
+
+class UploadRing {
+  public:
+    /* the region of every frame in flight is large enough for one allocation of each size */
+    static bool init(VkRenderData &renderData, const std::vector<VkDeviceSize> &frameAllocationSizes);
+    /* must be called after the fence of the current frame was signaled */
+    static void beginFrame(VkRenderData &renderData);
+    /* copies the data into the region of the current frame, the offset is used as dynamic descriptor offset */
+    static bool uploadData(VkRenderData &renderData, const void *data, const VkDeviceSize dataSize, uint32_t &dynamicOffset);
+    /* makes the written data visible to the GPU, must be called before the submit */
+    static void endFrame(VkRenderData &renderData);
+    static void cleanup(VkRenderData &renderData);
+
+  private:
+    static VkDeviceSize getAlignedSize(const VkUploadRingData &ringData, const VkDeviceSize size);
+};
@@ -25,6 +25,81 @@ struct VkUploadMatrices {
   glm::mat4 projectionMatrix;
 };
 
+/* one persistently mapped buffer for all per-frame uniform data
+ * every frame in flight owns a region, uploads are aligned suballocations inside the region of the current frame */
+struct VkUploadRingData {
+  VkBuffer rdRingBuffer = VK_NULL_HANDLE;
+  VmaAllocation rdRingBufferAlloc = nullptr;
+  char* rdMappedData = nullptr;
+
+  VkDeviceSize rdAlignment = 0;
+  VkDeviceSize rdFrameRegionSize = 0;
+  VkDeviceSize rdFrameRegionStart = 0;
+  VkDeviceSize rdFrameRegionUsed = 0;
+};
+
+/* host visible staging memory shared by all uploads
+ * allocations are placed one after another into large blocks, a block starts over after all of its allocations were released */
+struct VkStagingBlockData {
+  VkBuffer sbBuffer = VK_NULL_HANDLE;
+  VmaAllocation sbBufferAlloc = nullptr;
+  char* sbMappedData = nullptr;
+  VkDeviceSize sbSize = 0;
+  VkDeviceSize sbUsedSize = 0;
+  unsigned int sbAllocations = 0;
+};
+
+struct VkStagingAllocation {
+  VkBuffer saBuffer = VK_NULL_HANDLE;
+  VkDeviceSize saOffset = 0;
+  VkDeviceSize saSize = 0;
+  unsigned int saBlock = 0;
+};
+
+struct VkStagingPoolData {
+  std::vector<VkStagingBlockData> rdBlocks{};
+  VkDeviceSize rdBlockSize = 0;
+  VkDeviceSize rdAlignment = 0;
+
+  /* allocations of every frame in flight, released after the fence of the frame was signaled */
+  std::vector<std::vector<VkStagingAllocation>> rdFrameReleases{};
+
+  /* statistics */
+  VkDeviceSize rdUsedSize = 0;
+  VkDeviceSize rdPeakUsedSize = 0;
+  VkDeviceSize rdResidentSize = 0;
+  unsigned int rdBlockAllocations = 0;
+};
+
+/* copies recorded into one command buffer of the transfer queue, submitted together */
+struct VkUploadBatchData {
+  uint64_t ubId = 0;
+  VkCommandBuffer ubCommandBuffer = VK_NULL_HANDLE;
+  VkFence ubFence = VK_NULL_HANDLE;
+
+  /* released after the fence was signaled */
+  std::vector<VkStagingAllocation> ubStagingAllocations{};
+
+  /* recorded on the graphics queue if the transfer queue belongs to another queue family */
+  std::vector<VkImageMemoryBarrier> ubImageAcquireBarriers{};
+  VkPipelineStageFlags ubAcquireStages = 0;
+};
+
+struct VkUploadManagerData {
+  VkQueue rdTransferQueue = VK_NULL_HANDLE;
+  uint32_t rdTransferQueueFamily = 0;
+  uint32_t rdGraphicsQueueFamily = 0;
+  VkCommandPool rdTransferCommandPool = VK_NULL_HANDLE;
+
+  /* signaled fences are reset and reused by the next batches */
+  std::vector<VkFence> rdFreeFences{};
+
+  VkUploadBatchData rdRecordingBatch{};
+  std::vector<VkUploadBatchData> rdPendingBatches{};
+  uint64_t rdNextBatchId = 1;
+  uint64_t rdCompletedBatchId = 0;
+};
+
 struct VkRenderData {
   GLFWwindow *rdWindow = nullptr;
 
@@ -42,6 +117,8 @@ struct VkRenderData {
   float rdUploadToUBOTime = 0.0f;
   float rdUIGenerateTime = 0.0f;
   float rdUIDrawTime = 0.0f;
+  /* time the CPU waited for the GPU to finish the oldest frame in flight */
+  float rdWaitForFenceTime = 0.0f;
 
   int rdMoveForward = 0;
   int rdMoveRight = 0;
@@ -74,15 +151,25 @@ struct VkRenderData {
 
   VkRenderPass rdRenderpass;
   VkPipelineLayout rdPipelineLayout = VK_NULL_HANDLE;
+  /* shared by all pipelines, filled from and saved to a file */
+  VkPipelineCache rdPipelineCache = VK_NULL_HANDLE;
+  bool rdPipelineCacheLoaded = false;
   VkPipeline rdBasicPipeline = VK_NULL_HANDLE;
   VkPipeline rdChangedPipeline = VK_NULL_HANDLE;
 
+  /* resources for rdMaxFramesInFlight frames are created, the first rdFramesInFlight of them are used */
+  static constexpr int rdMaxFramesInFlight = 3;
+  int rdFramesInFlight = 2;
+  unsigned int rdCurrentFrame = 0;
+
   VkCommandPool rdCommandPool = VK_NULL_HANDLE;
+  /* command buffer of the frame currently recorded, one of rdCommandBuffers */
   VkCommandBuffer rdCommandBuffer = VK_NULL_HANDLE;
+  std::vector<VkCommandBuffer> rdCommandBuffers{};
 
-  VkSemaphore rdPresentSemaphore = VK_NULL_HANDLE;
-  VkSemaphore rdRenderSemaphore = VK_NULL_HANDLE;
-  VkFence rdRenderFence = VK_NULL_HANDLE;
+  std::vector<VkSemaphore> rdPresentSemaphores{};
+  std::vector<VkSemaphore> rdRenderSemaphores{};
+  std::vector<VkFence> rdRenderFences{};
 
   VkImage rdTextureImage = VK_NULL_HANDLE;
   VkImageView rdTextureImageView = VK_NULL_HANDLE;
@@ -93,12 +180,14 @@ struct VkRenderData {
   VkDescriptorSetLayout rdTextureDescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSet rdTextureDescriptorSet = VK_NULL_HANDLE;
 
-  VkBuffer rdUboBuffer = VK_NULL_HANDLE;
-  VmaAllocation rdUboBufferAlloc = nullptr;
+  VkUploadRingData rdUploadRing{};
+  VkStagingPoolData rdStagingPool{};
+  VkUploadManagerData rdUploadManager{};
 
   VkDescriptorPool rdUBODescriptorPool = VK_NULL_HANDLE;
   VkDescriptorSetLayout rdUBODescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSet rdUBODescriptorSet = VK_NULL_HANDLE;
+  uint32_t rdUBODynamicOffset = 0;
 
   VkDescriptorPool rdImguiDescriptorPool = VK_NULL_HANDLE;
 };
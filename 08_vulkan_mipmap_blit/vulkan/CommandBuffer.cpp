@@ -2,7 +2,7 @@
 #include <Logger.h>
 #include <VkBootstrap.h>
 
-bool CommandBuffer::init(VkRenderData renderData, VkCommandBuffer& commandBuffer) {
+bool CommandBuffer::init(VkRenderData& renderData, VkCommandBuffer& commandBuffer) {
   VkCommandBufferAllocateInfo allocInfo{};
   allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
   allocInfo.commandPool = renderData.rdCommandPool;
@@ -16,11 +16,11 @@ bool CommandBuffer::init(VkRenderData renderData, VkCommandBuffer& commandBuffer
   return true;
 }
 
-void CommandBuffer::cleanup(VkRenderData renderData, const VkCommandBuffer commandBuffer) {
+void CommandBuffer::cleanup(VkRenderData& renderData, const VkCommandBuffer commandBuffer) {
   vkFreeCommandBuffers(renderData.rdVkbDevice.device, renderData.rdCommandPool, 1, &commandBuffer);
 }
 
-VkCommandBuffer CommandBuffer::createSingleShotBuffer(VkRenderData renderData) {
+VkCommandBuffer CommandBuffer::createSingleShotBuffer(VkRenderData& renderData) {
   Logger::log(2, "%s: creating a single shot command buffer\n", __FUNCTION__);
   VkCommandBuffer commandBuffer;
 
@@ -47,7 +47,7 @@ VkCommandBuffer CommandBuffer::createSingleShotBuffer(VkRenderData renderData) {
   return commandBuffer;
 }
 
-bool CommandBuffer::submitSingleShotBuffer(VkRenderData renderData, const VkCommandBuffer commandBuffer, const VkQueue queue) {
+bool CommandBuffer::submitSingleShotBuffer(VkRenderData& renderData, const VkCommandBuffer commandBuffer, const VkQueue queue) {
   Logger::log(2, "%s: submitting single shot command buffer\n", __FUNCTION__);
 
   if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
@@ -5,8 +5,8 @@
 
 class CommandBuffer {
   public:
-    static bool init(VkRenderData renderData, VkCommandBuffer& commandBuffer);
-    static void cleanup(VkRenderData renderData, const VkCommandBuffer commandBuffer);
-    static VkCommandBuffer createSingleShotBuffer(VkRenderData renderData);
-    static bool submitSingleShotBuffer(VkRenderData renderData, const VkCommandBuffer commandBuffer, const VkQueue queue);
+    static bool init(VkRenderData& renderData, VkCommandBuffer& commandBuffer);
+    static void cleanup(VkRenderData& renderData, const VkCommandBuffer commandBuffer);
+    static VkCommandBuffer createSingleShotBuffer(VkRenderData& renderData);
+    static bool submitSingleShotBuffer(VkRenderData& renderData, const VkCommandBuffer commandBuffer, const VkQueue queue);
 };
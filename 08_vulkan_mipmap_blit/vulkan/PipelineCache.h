@@ -0,0 +1,18 @@
+/* Vulkan pipeline cache, stored in a file between runs */
+#pragma once
+
+#include <string>
+#include <vulkan/vulkan.h>
+
+#include "VkRenderData.h"
+
+class PipelineCache {
+  public:
+    /* an empty cache is created if the file is missing or was written by another device or driver */
+    static bool init(VkRenderData &renderData, const std::string cacheFileName);
+    static bool save(VkRenderData &renderData, const std::string cacheFileName);
+    static void cleanup(VkRenderData &renderData);
+
+  private:
+    static bool isCacheDataValid(VkRenderData &renderData, const std::string &cacheData);
+};
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cstring>
+
+#include "StagingPool.h"
+#include "Logger.h"
+
+#include <VkBootstrap.h>
+
+bool StagingPool::init(VkRenderData &renderData, const VkDeviceSize blockSize) {
+  VkStagingPoolData &poolData = renderData.rdStagingPool;
+  poolData.rdBlockSize = blockSize;
+
+  /* image copies need offsets aligned to the texel size, 16 bytes cover all formats */
+  const VkPhysicalDeviceLimits &limits = renderData.rdVkbPhysicalDevice.properties.limits;
+  poolData.rdAlignment = std::max(static_cast<VkDeviceSize>(16), limits.optimalBufferCopyOffsetAlignment);
+
+  poolData.rdFrameReleases.resize(VkRenderData::rdMaxFramesInFlight);
+
+  /* most uploads fit into the first block */
+  unsigned int blockIndex = 0;
+  return createBlock(renderData, blockSize, blockIndex);
+}
+
+bool StagingPool::allocate(VkRenderData &renderData, const void *data, const VkDeviceSize dataSize,
+    VkStagingAllocation &allocation) {
+  VkStagingPoolData &poolData = renderData.rdStagingPool;
+  VkDeviceSize alignedSize = getAlignedSize(poolData, dataSize);
+
+  /* first block with enough free space at the end */
+  bool blockFound = false;
+  unsigned int blockIndex = 0;
+  for (unsigned int i = 0; i < poolData.rdBlocks.size(); ++i) {
+    const VkStagingBlockData &block = poolData.rdBlocks.at(i);
+    if (block.sbBuffer != VK_NULL_HANDLE && block.sbUsedSize + alignedSize <= block.sbSize) {
+      blockIndex = i;
+      blockFound = true;
+      break;
+    }
+  }
+
+  /* uploads larger than a block get a block of their own */
+  if (!blockFound && !createBlock(renderData, std::max(poolData.rdBlockSize, alignedSize), blockIndex)) {
+    return false;
+  }
+
+  VkStagingBlockData &block = poolData.rdBlocks.at(blockIndex);
+  allocation.saBuffer = block.sbBuffer;
+  allocation.saOffset = block.sbUsedSize;
+  allocation.saSize = alignedSize;
+  allocation.saBlock = blockIndex;
+
+  /* the memory is host coherent, no flush required */
+  std::memcpy(block.sbMappedData + allocation.saOffset, data, dataSize);
+
+  block.sbUsedSize += alignedSize;
+  ++block.sbAllocations;
+
+  poolData.rdUsedSize += alignedSize;
+  poolData.rdPeakUsedSize = std::max(poolData.rdPeakUsedSize, poolData.rdUsedSize);
+  return true;
+}
+
+void StagingPool::release(VkRenderData &renderData, const VkStagingAllocation &allocation) {
+  VkStagingPoolData &poolData = renderData.rdStagingPool;
+  VkStagingBlockData &block = poolData.rdBlocks.at(allocation.saBlock);
+
+  --block.sbAllocations;
+  poolData.rdUsedSize -= allocation.saSize;
+  if (block.sbAllocations > 0) {
+    return;
+  }
+
+  /* empty blocks start over, oversized blocks of single large uploads are given back */
+  if (block.sbSize > poolData.rdBlockSize) {
+    destroyBlock(renderData, block);
+  } else {
+    block.sbUsedSize = 0;
+  }
+}
+
+void StagingPool::releaseAfterFrame(VkRenderData &renderData, const VkStagingAllocation &allocation) {
+  renderData.rdStagingPool.rdFrameReleases.at(renderData.rdCurrentFrame).emplace_back(allocation);
+}
+
+void StagingPool::beginFrame(VkRenderData &renderData) {
+  VkStagingPoolData &poolData = renderData.rdStagingPool;
+  releaseFrame(renderData, renderData.rdCurrentFrame);
+
+  /* the fences of frames above a lowered number of frames in flight are not waited for anymore */
+  for (unsigned int i = renderData.rdFramesInFlight; i < poolData.rdFrameReleases.size(); ++i) {
+    if (!poolData.rdFrameReleases.at(i).empty() &&
+        vkGetFenceStatus(renderData.rdVkbDevice.device, renderData.rdRenderFences.at(i)) == VK_SUCCESS) {
+      releaseFrame(renderData, i);
+    }
+  }
+}
+
+void StagingPool::cleanup(VkRenderData &renderData) {
+  VkStagingPoolData &poolData = renderData.rdStagingPool;
+
+  Logger::log(1, "%s: staging peak usage %llu bytes, %u block allocations\n", __FUNCTION__,
+    static_cast<unsigned long long>(poolData.rdPeakUsedSize), poolData.rdBlockAllocations);
+
+  for (auto &block : poolData.rdBlocks) {
+    destroyBlock(renderData, block);
+  }
+  poolData.rdBlocks.clear();
+  poolData.rdFrameReleases.clear();
+  poolData.rdUsedSize = 0;
+}
+
+bool StagingPool::createBlock(VkRenderData &renderData, const VkDeviceSize blockSize, unsigned int &blockIndex) {
+  VkStagingPoolData &poolData = renderData.rdStagingPool;
+
+  VkBufferCreateInfo stagingBufferInfo{};
+  stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  stagingBufferInfo.size = blockSize;
+  stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+  VmaAllocationCreateInfo stagingAllocInfo{};
+  stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+  stagingAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+  VkStagingBlockData block{};
+  VmaAllocationInfo allocInfo{};
+  if (vmaCreateBuffer(renderData.rdAllocator, &stagingBufferInfo, &stagingAllocInfo, &block.sbBuffer,
+      &block.sbBufferAlloc, &allocInfo) != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not allocate staging block of %llu bytes via VMA\n", __FUNCTION__,
+      static_cast<unsigned long long>(blockSize));
+    return false;
+  }
+  block.sbMappedData = static_cast<char*>(allocInfo.pMappedData);
+  block.sbSize = blockSize;
+
+  ++poolData.rdBlockAllocations;
+  poolData.rdResidentSize += blockSize;
+
+  /* reuse the slot of a destroyed block, the indices of live allocations must not change */
+  auto freeSlot = std::find_if(poolData.rdBlocks.begin(), poolData.rdBlocks.end(),
+    [](const VkStagingBlockData &slot) { return slot.sbBuffer == VK_NULL_HANDLE; });
+  if (freeSlot != poolData.rdBlocks.end()) {
+    *freeSlot = block;
+    blockIndex = static_cast<unsigned int>(freeSlot - poolData.rdBlocks.begin());
+  } else {
+    poolData.rdBlocks.emplace_back(block);
+    blockIndex = static_cast<unsigned int>(poolData.rdBlocks.size() - 1);
+  }
+
+  Logger::log(1, "%s: created staging block %u with %llu bytes\n", __FUNCTION__, blockIndex,
+    static_cast<unsigned long long>(blockSize));
+  return true;
+}
+
+void StagingPool::destroyBlock(VkRenderData &renderData, VkStagingBlockData &block) {
+  if (block.sbBuffer == VK_NULL_HANDLE) {
+    return;
+  }
+
+  renderData.rdStagingPool.rdResidentSize -= block.sbSize;
+  vmaDestroyBuffer(renderData.rdAllocator, block.sbBuffer, block.sbBufferAlloc);
+  block = VkStagingBlockData{};
+}
+
+void StagingPool::releaseFrame(VkRenderData &renderData, const unsigned int frame) {
+  std::vector<VkStagingAllocation> &frameReleases = renderData.rdStagingPool.rdFrameReleases.at(frame);
+  for (const auto &allocation : frameReleases) {
+    release(renderData, allocation);
+  }
+  frameReleases.clear();
+}
+
+VkDeviceSize StagingPool::getAlignedSize(const VkStagingPoolData &poolData, const VkDeviceSize size) {
+  /* both alignments are powers of two */
+  return (size + poolData.rdAlignment - 1) & ~(poolData.rdAlignment - 1);
+}
@@ -3,6 +3,7 @@
 #include <stb_image.h>
 
 #include "CommandBuffer.h"
+#include "StagingPool.h"
 #include "Texture.h"
 #include "Logger.h"
 
@@ -49,28 +50,14 @@ bool Texture::loadTexture(VkRenderData &renderData, std::string textureFilename,
     return false;
   }
 
-  /* staging buffer */
-  VkBufferCreateInfo stagingBufferInfo{};
-  stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  stagingBufferInfo.size = imageSize;
-  stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-  VkBuffer stagingBuffer;
-  VmaAllocation stagingBufferAlloc;
-
-  VmaAllocationCreateInfo stagingAllocInfo{};
-  stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-  if (vmaCreateBuffer(renderData.rdAllocator, &stagingBufferInfo, &stagingAllocInfo, &stagingBuffer,  &stagingBufferAlloc, nullptr) != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate texture staging buffer via VMA\n", __FUNCTION__);
+  /* staging memory from the pool, released after the copy */
+  VkStagingAllocation stagingAllocation{};
+  if (!StagingPool::allocate(renderData, textureData, imageSize, stagingAllocation)) {
+    Logger::log(1, "%s error: could not get texture staging memory\n", __FUNCTION__);
+    stbi_image_free(textureData);
     return false;
   }
 
-  void* data;
-  vmaMapMemory(renderData.rdAllocator, stagingBufferAlloc, &data);
-  std::memcpy(data, textureData, static_cast<uint32_t>(imageSize));
-  vmaUnmapMemory(renderData.rdAllocator, stagingBufferAlloc);
-
   stbi_image_free(textureData);
 
   /* upload */
@@ -99,7 +86,7 @@ bool Texture::loadTexture(VkRenderData &renderData, std::string textureFilename,
   textureExtent.depth = 1;
 
   VkBufferImageCopy stagingBufferCopy{};
-  stagingBufferCopy.bufferOffset = 0;
+  stagingBufferCopy.bufferOffset = stagingAllocation.saOffset;
   stagingBufferCopy.bufferRowLength = 0;
   stagingBufferCopy.bufferImageHeight = 0;
   stagingBufferCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -124,7 +111,7 @@ bool Texture::loadTexture(VkRenderData &renderData, std::string textureFilename,
   stagingBufferShaderBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
   vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferTransferBarrier);
-  vkCmdCopyBufferToImage(uploadCommandBuffer, stagingBuffer, renderData.rdTextureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &stagingBufferCopy);
+  vkCmdCopyBufferToImage(uploadCommandBuffer, stagingAllocation.saBuffer, renderData.rdTextureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &stagingBufferCopy);
   vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferShaderBarrier);
 
 
@@ -216,7 +203,7 @@ bool Texture::loadTexture(VkRenderData &renderData, std::string textureFilename,
   }
 
   bool commandResult = CommandBuffer::submitSingleShotBuffer(renderData, uploadCommandBuffer, renderData.rdGraphicsQueue);
-  vmaDestroyBuffer(renderData.rdAllocator, stagingBuffer, stagingBufferAlloc);
+  StagingPool::release(renderData, stagingAllocation);
 
   if (!commandResult) {
     Logger::log(1, "%s error: could not submit texture transfer commands\n", __FUNCTION__);
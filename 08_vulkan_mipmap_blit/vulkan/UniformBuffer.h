@@ -8,6 +8,7 @@
 class UniformBuffer {
   public:
     static bool init(VkRenderData &renderData);
-    static void uploadData(VkRenderData &renderData, VkUploadMatrices matrices);
+    /* stores the offset of the matrices inside the upload ring in rdUBODynamicOffset */
+    static bool uploadData(VkRenderData &renderData, const VkUploadMatrices &matrices);
     static void cleanup(VkRenderData &renderData);
 };
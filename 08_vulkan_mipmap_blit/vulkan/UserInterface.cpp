@@ -1,4 +1,5 @@
 #include <string>
+#include <algorithm>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/string_cast.hpp>
@@ -50,7 +51,9 @@ bool UserInterface::init(VkRenderData& renderData) {
   imguiIinitInfo.Queue = renderData.rdGraphicsQueue;
   imguiIinitInfo.DescriptorPool = renderData.rdImguiDescriptorPool;
   imguiIinitInfo.MinImageCount = 2;
-  imguiIinitInfo.ImageCount = renderData.rdSwapchainImages.size();
+  /* ImGui rotates its vertex buffers by this count, it must not reuse a buffer of a frame still in flight */
+  imguiIinitInfo.ImageCount = std::max(static_cast<uint32_t>(renderData.rdSwapchainImages.size()),
+    static_cast<uint32_t>(VkRenderData::rdMaxFramesInFlight));
   imguiIinitInfo.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
 
   ImGui_ImplVulkan_Init(&imguiIinitInfo, renderData.rdRenderpass);
@@ -163,6 +166,12 @@ void UserInterface::createFrame(VkRenderData& renderData) {
   ImGui::SameLine();
   ImGui::Text("ms");
 
+  ImGui::Text("Wait for Fence Time:");
+  ImGui::SameLine();
+  ImGui::Text("%s", std::to_string(renderData.rdWaitForFenceTime).c_str());
+  ImGui::SameLine();
+  ImGui::Text("ms");
+
   ImGui::Text("Matrix Generation Time:");
   ImGui::SameLine();
   ImGui::Text("%s", std::to_string(renderData.rdMatrixGenerateTime).c_str());
@@ -187,6 +196,11 @@ void UserInterface::createFrame(VkRenderData& renderData) {
   ImGui::SameLine();
   ImGui::Text("ms");
 
+  /* one frame in flight serializes CPU and GPU, compare the frame and fence wait times */
+  ImGui::Text("Frames in Flight:");
+  ImGui::SameLine();
+  ImGui::SliderInt("##FramesInFlight", &renderData.rdFramesInFlight, 1, VkRenderData::rdMaxFramesInFlight);
+
   ImGui::Separator();
 
   ImGui::Text("Camera Position:");
@@ -217,6 +231,17 @@ void UserInterface::createFrame(VkRenderData& renderData) {
   ImGui::SameLine();
   ImGui::Text("%s", imgWindowPos.c_str());
 
+  const VkStagingPoolData &stagingPool = renderData.rdStagingPool;
+  std::string stagingMemory = std::to_string(stagingPool.rdUsedSize / 1024) + "/" +
+    std::to_string(stagingPool.rdPeakUsedSize / 1024) + "/" + std::to_string(stagingPool.rdResidentSize / 1024) + " KiB";
+  ImGui::Text("Staging Used/Peak/Resident:");
+  ImGui::SameLine();
+  ImGui::Text("%s", stagingMemory.c_str());
+
+  ImGui::Text("Staging Block Allocations:");
+  ImGui::SameLine();
+  ImGui::Text("%s", std::to_string(stagingPool.rdBlockAllocations).c_str());
+
   ImGui::Separator();
 
   static bool checkBoxChecked = false;
@@ -38,6 +38,10 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
+  if (!createStagingPool()) {
+    return false;
+  }
+
   if (!createSwapchain()) {
     return false;
   }
@@ -60,6 +64,10 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
+  if (!createUploadRing()) {
+    return false;
+  }
+
   if (!createUBO()) {
       return false;
   }
@@ -72,6 +80,13 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
+  if (!createPipelineCache()) {
+    return false;
+  }
+
+  /* compare the time with an empty and a filled pipeline cache */
+  mPipelineCreationTimer.start();
+
   if (!createBasicPipeline()) {
     return false;
   }
@@ -79,6 +94,8 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
   if (!createChangedPipeline()) {
     return false;
   }
+  Logger::log(1, "%s: created pipelines in %f ms (%s pipeline cache)\n", __FUNCTION__,
+    mPipelineCreationTimer.stop(), mRenderData.rdPipelineCacheLoaded ? "warm" : "cold");
 
   if (!createFramebuffer()) {
     return false;
@@ -261,6 +278,22 @@ bool VkRenderer::recreateSwapchain() {
   return true;
 }
 
+bool VkRenderer::createStagingPool() {
+  if (!StagingPool::init(mRenderData, mStagingBlockSize)) {
+    Logger::log(1, "%s error: could not create staging pool\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
+bool VkRenderer::createUploadRing() {
+  if (!UploadRing::init(mRenderData, { sizeof(VkUploadMatrices) })) {
+    Logger::log(1, "%s error: could not create upload ring\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
 bool VkRenderer::createUBO() {
   if (!UniformBuffer::init(mRenderData)) {
     Logger::log(1, "%s error: could not create uniform buffers\n", __FUNCTION__);
@@ -285,6 +318,14 @@ bool VkRenderer::createPipelineLayout() {
   return true;
 }
 
+bool VkRenderer::createPipelineCache() {
+  if (!PipelineCache::init(mRenderData, mPipelineCacheFileName)) {
+    Logger::log(1, "%s error: could not create pipeline cache\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
 bool VkRenderer::createBasicPipeline() {
   std::string vertexShaderFile = "shader/basic.vert.spv";
   std::string fragmentShaderFile = "shader/basic.frag.spv";
@@ -322,10 +363,14 @@ bool VkRenderer::createCommandPool() {
 }
 
 bool VkRenderer::createCommandBuffer() {
-  if (!CommandBuffer::init(mRenderData, mRenderData.rdCommandBuffer)) {
-    Logger::log(1, "%s error: could not create command buffers\n", __FUNCTION__);
-    return false;
+  mRenderData.rdCommandBuffers.resize(VkRenderData::rdMaxFramesInFlight, VK_NULL_HANDLE);
+  for (auto& commandBuffer : mRenderData.rdCommandBuffers) {
+    if (!CommandBuffer::init(mRenderData, commandBuffer)) {
+      Logger::log(1, "%s error: could not create command buffers\n", __FUNCTION__);
+      return false;
+    }
   }
+  mRenderData.rdCommandBuffer = mRenderData.rdCommandBuffers.at(0);
   return true;
 }
 
@@ -369,23 +414,30 @@ bool VkRenderer::initUserInterface() {
 void VkRenderer::cleanup() {
   vkDeviceWaitIdle(mRenderData.rdVkbDevice.device);
 
+  PipelineCache::save(mRenderData, mPipelineCacheFileName);
+
   mUserInterface.cleanup(mRenderData);
 
   Texture::cleanup(mRenderData);
   vmaDestroyBuffer(mRenderData.rdAllocator, mVertexBuffer, mVertexBufferAlloc);
 
   SyncObjects::cleanup(mRenderData);
-  CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandBuffer);
+  for (const auto& commandBuffer : mRenderData.rdCommandBuffers) {
+    CommandBuffer::cleanup(mRenderData, commandBuffer);
+  }
   CommandPool::cleanup(mRenderData);
   Framebuffer::cleanup(mRenderData);
   Pipeline::cleanup(mRenderData, mRenderData.rdBasicPipeline);
   Pipeline::cleanup(mRenderData, mRenderData.rdChangedPipeline);
   PipelineLayout::cleanup(mRenderData, mRenderData.rdPipelineLayout);
+  PipelineCache::cleanup(mRenderData);
   Renderpass::cleanup(mRenderData);
   UniformBuffer::cleanup(mRenderData);
+  UploadRing::cleanup(mRenderData);
 
   vkDestroyImageView(mRenderData.rdVkbDevice.device, mRenderData.rdDepthImageView, nullptr);
   vmaDestroyImage(mRenderData.rdAllocator, mRenderData.rdDepthImage, mRenderData.rdDepthImageAlloc);
+  StagingPool::cleanup(mRenderData);
   vmaDestroyAllocator(mRenderData.rdAllocator);
 
   mRenderData.rdVkbSwapchain.destroy_image_views(mRenderData.rdSwapchainImageViews);
@@ -550,24 +602,33 @@ bool VkRenderer::draw() {
 
   handleMovementKeys();
 
-  if (vkWaitForFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdRenderFence, VK_TRUE, UINT64_MAX) != VK_SUCCESS) {
-    Logger::log(1, "%s error: waiting for fence failed\n", __FUNCTION__);
-    return false;
+  /* the number of frames may have been lowered in the UI, every frame index is guarded by its own fence */
+  if (mRenderData.rdCurrentFrame >= static_cast<unsigned int>(mRenderData.rdFramesInFlight)) {
+    mRenderData.rdCurrentFrame = 0;
   }
+  const unsigned int currentFrame = mRenderData.rdCurrentFrame;
+  VkFence renderFence = mRenderData.rdRenderFences.at(currentFrame);
 
-  if (vkResetFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdRenderFence) != VK_SUCCESS) {
-    Logger::log(1, "%s error:  fence reset failed\n", __FUNCTION__);
+  /* wait only for the GPU work submitted rdFramesInFlight frames ago */
+  mWaitForFenceTimer.start();
+  if (vkWaitForFences(mRenderData.rdVkbDevice.device, 1, &renderFence, VK_TRUE, UINT64_MAX) != VK_SUCCESS) {
+    Logger::log(1, "%s error: waiting for fence failed\n", __FUNCTION__);
     return false;
   }
+  mRenderData.rdWaitForFenceTime = mWaitForFenceTimer.stop();
+
+  /* the copies of the last frame with this index are done */
+  StagingPool::beginFrame(mRenderData);
 
   uint32_t imageIndex = 0;
   VkResult result = vkAcquireNextImageKHR(mRenderData.rdVkbDevice.device,
       mRenderData.rdVkbSwapchain.swapchain,
       UINT64_MAX,
-      mRenderData.rdPresentSemaphore,
+      mRenderData.rdPresentSemaphores.at(currentFrame),
       VK_NULL_HANDLE,
       &imageIndex);
 
+  /* the fence stays signaled here, the next frame with this index must not wait forever */
   if (result == VK_ERROR_OUT_OF_DATE_KHR) {
     return recreateSwapchain();
   } else {
@@ -577,6 +638,13 @@ bool VkRenderer::draw() {
     }
   }
 
+  if (vkResetFences(mRenderData.rdVkbDevice.device, 1, &renderFence) != VK_SUCCESS) {
+    Logger::log(1, "%s error:  fence reset failed\n", __FUNCTION__);
+    return false;
+  }
+
+  mRenderData.rdCommandBuffer = mRenderData.rdCommandBuffers.at(currentFrame);
+
 
   if (vkResetCommandBuffer(mRenderData.rdCommandBuffer, 0) != VK_SUCCESS) {
     Logger::log(1, "%s error: failed to reset command buffer\n", __FUNCTION__);
@@ -639,6 +707,15 @@ bool VkRenderer::draw() {
   mMatrices.viewMatrix = mCamera.getViewMatrix(mRenderData) * model;
   mRenderData.rdMatrixGenerateTime = mMatrixGenerateTimer.stop();
 
+  /* the dynamic offset is needed to bind the descriptor set, so the data is uploaded before the draw */
+  mUploadToUBOTimer.start();
+  UploadRing::beginFrame(mRenderData);
+  if (!UniformBuffer::uploadData(mRenderData, mMatrices)) {
+    return false;
+  }
+  UploadRing::endFrame(mRenderData);
+  mRenderData.rdUploadToUBOTime = mUploadToUBOTimer.stop();
+
   vkCmdBeginRenderPass(mRenderData.rdCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
 
   /* the rendering itself happens here */
@@ -657,7 +734,7 @@ bool VkRenderer::draw() {
   vkCmdBindVertexBuffers(mRenderData.rdCommandBuffer, 0, 1, &mVertexBuffer, &offset);
 
   vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdPipelineLayout, 0, 1, &mRenderData.rdTextureDescriptorSet, 0, nullptr);
-  vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdPipelineLayout, 1, 1, &mRenderData.rdUBODescriptorSet, 0, nullptr);
+  vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdPipelineLayout, 1, 1, &mRenderData.rdUBODescriptorSet, 1, &mRenderData.rdUBODynamicOffset);
 
   vkCmdDraw(mRenderData.rdCommandBuffer, mRenderData.rdTriangleCount * 3, 1, 0, 0);
 
@@ -677,13 +754,6 @@ bool VkRenderer::draw() {
     return false;
   }
 
-  /* upload UBO data after commands are created */
-  mUploadToUBOTimer.start();
-
-  UniformBuffer::uploadData(mRenderData, mMatrices);
-
-  mRenderData.rdUploadToUBOTime = mUploadToUBOTimer.stop();
-
   /* submit command buffer */
   VkSubmitInfo submitInfo{};
   submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -692,23 +762,26 @@ bool VkRenderer::draw() {
   submitInfo.pWaitDstStageMask = &waitStage;
 
   submitInfo.waitSemaphoreCount = 1;
-  submitInfo.pWaitSemaphores = &mRenderData.rdPresentSemaphore;
+  submitInfo.pWaitSemaphores = &mRenderData.rdPresentSemaphores.at(currentFrame);
 
   submitInfo.signalSemaphoreCount = 1;
-  submitInfo.pSignalSemaphores = &mRenderData.rdRenderSemaphore;
+  submitInfo.pSignalSemaphores = &mRenderData.rdRenderSemaphores.at(currentFrame);
 
   submitInfo.commandBufferCount = 1;
   submitInfo.pCommandBuffers = &mRenderData.rdCommandBuffer;
 
-  if (vkQueueSubmit(mRenderData.rdGraphicsQueue, 1, &submitInfo, mRenderData.rdRenderFence) != VK_SUCCESS) {
+  if (vkQueueSubmit(mRenderData.rdGraphicsQueue, 1, &submitInfo, renderFence) != VK_SUCCESS) {
     Logger::log(1, "%s error: failed to submit draw command buffer\n", __FUNCTION__);
     return false;
   }
 
+  /* advance before presenting, a swapchain recreation below returns early */
+  mRenderData.rdCurrentFrame = (currentFrame + 1) % mRenderData.rdFramesInFlight;
+
   VkPresentInfoKHR presentInfo{};
   presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
   presentInfo.waitSemaphoreCount = 1;
-  presentInfo.pWaitSemaphores = &mRenderData.rdRenderSemaphore;
+  presentInfo.pWaitSemaphores = &mRenderData.rdRenderSemaphores.at(currentFrame);
 
   presentInfo.swapchainCount = 1;
   presentInfo.pSwapchains = &mRenderData.rdVkbSwapchain.swapchain;
@@ -14,12 +14,15 @@
 #include "VkRenderData.h"
 #include "Renderpass.h"
 #include "Pipeline.h"
+#include "PipelineCache.h"
 #include "PipelineLayout.h"
 #include "Framebuffer.h"
 #include "CommandPool.h"
 #include "CommandBuffer.h"
 #include "SyncObjects.h"
 #include "Texture.h"
+#include "UploadRing.h"
+#include "StagingPool.h"
 #include "UniformBuffer.h"
 #include "UserInterface.h"
 #include "Camera.h"
@@ -57,10 +60,16 @@ class VkRenderer {
     int mCameraUpDown = 0;
 
     Timer mFrameTimer{};
+    Timer mWaitForFenceTimer{};
     Timer mMatrixGenerateTimer{};
     Timer mUploadToUBOTimer{};
     Timer mUIGenerateTimer{};
     Timer mUIDrawTimer{};
+    Timer mPipelineCreationTimer{};
+
+    const std::string mPipelineCacheFileName = "pipeline_cache.bin";
+    /* larger uploads get a block of their own */
+    const VkDeviceSize mStagingBlockSize = 4 * 1024 * 1024;
 
     VkSurfaceKHR mSurface = VK_NULL_HANDLE;
 
@@ -74,10 +83,13 @@ class VkRenderer {
     bool deviceInit();
     bool getQueue();
     bool createDepthBuffer();
+    bool createStagingPool();
+    bool createUploadRing();
     bool createUBO();
     bool createSwapchain();
     bool createRenderPass();
     bool createPipelineLayout();
+    bool createPipelineCache();
     bool createBasicPipeline();
     bool createChangedPipeline();
     bool createFramebuffer();
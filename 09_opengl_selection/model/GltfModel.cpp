@@ -266,6 +266,15 @@ void GltfModel::createVertexBuffers() {
       int numPositionEntries = accessor.count;
       Logger::log(1, "%s: loaded %i vertices from glTF file\n", __FUNCTION__,
         numPositionEntries);
+
+      /* the glTF spec requires min and max for positions, but not every exporter writes them */
+      if (accessor.minValues.size() == 3 && accessor.maxValues.size() == 3) {
+        glm::vec3 minPos = glm::vec3(accessor.minValues.at(0), accessor.minValues.at(1), accessor.minValues.at(2));
+        glm::vec3 maxPos = glm::vec3(accessor.maxValues.at(0), accessor.maxValues.at(1), accessor.maxValues.at(2));
+        mBoundingSphere = glm::vec4((minPos + maxPos) / 2.0f, glm::length(maxPos - minPos) / 2.0f * 1.2f);
+      } else {
+        Logger::log(1, "%s error: position accessor %i has no bounds\n", __FUNCTION__, accessorNum);
+      }
     }
 
     mAttribAccessors.at(attributes.at(attribType)) = accessorNum;
@@ -349,6 +358,15 @@ void GltfModel::uploadIndexBuffer() {
     &indexBuffer.data.at(0) + indexBufferView.byteOffset, GL_STATIC_DRAW);
 }
 
+int GltfModel::getIndexCount() {
+  const tinygltf::Primitive &primitives = mModel->meshes.at(0).primitives.at(0);
+  return mModel->accessors.at(primitives.indices).count;
+}
+
+glm::vec4 GltfModel::getBoundingSphere() {
+  return mBoundingSphere;
+}
+
 int GltfModel::getTriangleCount() {
   const tinygltf::Primitive &primitives = mModel->meshes.at(0).primitives.at(0);
   const tinygltf::Accessor &indexAccessor = mModel->accessors.at(primitives.indices);
@@ -408,6 +426,27 @@ void GltfModel::drawInstanced(int instanceCount) {
   mTex.unbind();
 }
 
+void GltfModel::drawIndirect(GLintptr indirectOffset) {
+  const tinygltf::Primitive &primitives = mModel->meshes.at(0).primitives.at(0);
+  const tinygltf::Accessor &indexAccessor = mModel->accessors.at(primitives.indices);
+
+  GLuint drawMode = GL_TRIANGLES;
+  switch (primitives.mode) {
+    case TINYGLTF_MODE_TRIANGLES:
+      drawMode = GL_TRIANGLES;
+      break;
+    default:
+      Logger::log(1, "%s error: unknown draw mode %i\n", __FUNCTION__, primitives.mode);
+      break;
+  }
+
+  mTex.bind();
+  glBindVertexArray(mVAO);
+  glDrawElementsIndirect(drawMode, indexAccessor.componentType, reinterpret_cast<const void*>(indirectOffset));
+  glBindVertexArray(0);
+  mTex.unbind();
+}
+
 void GltfModel::cleanup() {
   glDeleteBuffers(mVertexVBO.size(), mVertexVBO.data());
   glDeleteBuffers(1, &mVAO);
@@ -24,12 +24,17 @@ class GltfModel {
       std::string textureFilename);
     void draw();
     void drawInstanced(int instanceCount);
+    /* instance count and base instance come from the command in the bound GL_DRAW_INDIRECT_BUFFER */
+    void drawIndirect(GLintptr indirectOffset);
     void cleanup();
 
     std::string getModelFilename();
     int getNodeCount();
     GltfNodeData getGltfNodes();
     int getTriangleCount();
+    int getIndexCount();
+    /* model space center in xyz, radius in w */
+    glm::vec4 getBoundingSphere();
 
     void uploadVertexBuffers();
     void uploadIndexBuffer();
@@ -66,6 +71,9 @@ class GltfModel {
     std::vector<int> mAttribAccessors{};
     std::vector<int> mNodeToJoint{};
 
+    /* bind pose bounds of the mesh, enlarged to contain the animated poses */
+    glm::vec4 mBoundingSphere = glm::vec4(0.0f);
+
     std::vector<std::shared_ptr<GltfAnimationClip>> mAnimClips{};
 
     GLuint mVAO = 0;
@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <numeric>
+
+#include "InstanceCulling.h"
+#include "Logger.h"
+
+bool InstanceCulling::init(unsigned int maxInstances, unsigned int numDrawGroups) {
+  mMaxInstances = maxInstances;
+  mNumDrawGroups = numDrawGroups;
+
+  if (!mCullShader.loadComputeShader("shader/instance_cull.comp")) {
+    Logger::log(1, "%s: instance culling shader loading failed\n", __FUNCTION__);
+    return false;
+  }
+  if (!mCullShader.getUniformLocation("aInstanceCount")) {
+    Logger::log(1, "%s: failed to get instance count uniform for instance culling shader\n",
+      __FUNCTION__);
+    return false;
+  }
+
+  /* six planes */
+  mFrustumBuffer.init(6 * sizeof(glm::vec4));
+  mCullInstanceBuffer.init(mMaxInstances * sizeof(OGLCullInstance));
+  createBuffers();
+  createReadbackSlots();
+
+  Logger::log(1, "%s: instance culling for %i instances in %i draw groups initialized\n", __FUNCTION__,
+    mMaxInstances, mNumDrawGroups);
+  return true;
+}
+
+void InstanceCulling::createBuffers() {
+  glGenBuffers(1, &mIndirectBuffer);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mIndirectBuffer);
+  glBufferData(GL_DRAW_INDIRECT_BUFFER, mNumDrawGroups * sizeof(DrawElementsIndirectCommand), NULL, GL_DYNAMIC_COPY);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+  /* never read by the CPU */
+  glGenBuffers(1, &mVisibleIdBuffer);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, mVisibleIdBuffer);
+  glBufferData(GL_SHADER_STORAGE_BUFFER, mNumDrawGroups * mMaxInstances * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void InstanceCulling::createReadbackSlots() {
+  /* persistent and coherent, the data is valid as soon as the fence of the slot is signaled */
+  GLbitfield storageFlags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  GLsizeiptr slotSize = mNumDrawGroups * sizeof(DrawElementsIndirectCommand);
+
+  for (auto &slot : mReadbackSlots) {
+    glGenBuffers(1, &slot.buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, slot.buffer);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, slotSize, NULL, storageFlags);
+    slot.commands = static_cast<DrawElementsIndirectCommand*>(
+      glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, slotSize, storageFlags));
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void InstanceCulling::cull(OGLRenderData &renderData, const glm::mat4 &projectionView,
+    std::vector<OGLCullInstance> &cullInstances, unsigned int indexCount) {
+  readVisibleCount(renderData);
+
+  unsigned int numInstances = cullInstances.size();
+  if (numInstances > mMaxInstances) {
+    Logger::log(1, "%s: resizing culling buffers from %i to %i instances\n", __FUNCTION__, mMaxInstances, numInstances);
+    glDeleteBuffers(1, &mIndirectBuffer);
+    glDeleteBuffers(1, &mVisibleIdBuffer);
+    mMaxInstances = numInstances;
+    createBuffers();
+  }
+  mCullInstanceBuffer.checkForResize(numInstances * sizeof(OGLCullInstance));
+
+  /* the compute shader counts the visible instances up from zero */
+  std::vector<DrawElementsIndirectCommand> drawCommands(mNumDrawGroups);
+  for (unsigned int i = 0; i < mNumDrawGroups; ++i) {
+    drawCommands.at(i) = { indexCount, 0, 0, 0, i * mMaxInstances };
+  }
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mIndirectBuffer);
+  glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, drawCommands.size() * sizeof(DrawElementsIndirectCommand),
+    drawCommands.data());
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+  std::vector<glm::vec4> frustumPlanes;
+  if (renderData.rdFrustumCulling) {
+    frustumPlanes = getFrustumPlanes(projectionView);
+  } else {
+    /* every sphere is in front of these planes */
+    frustumPlanes = std::vector<glm::vec4>(6, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+  }
+  mFrustumBuffer.uploadUboData(frustumPlanes, 1);
+  mCullInstanceBuffer.uploadSsboData(cullInstances, 4);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, mIndirectBuffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, mVisibleIdBuffer);
+
+  if (numInstances == 0) {
+    renderData.rdVisibleInstances = 0;
+    renderData.rdCulledInstances = 0;
+    return;
+  }
+
+  mCullShader.use();
+  mCullShader.setUniformValue(numInstances);
+  glDispatchCompute((numInstances + 63) / 64, 1, 1);
+
+  /* the draws read the commands and the ids, the copy reads the counts */
+  glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+  copyVisibleCount(numInstances);
+}
+
+GLintptr InstanceCulling::bindDrawGroup(unsigned int drawGroup) {
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mIndirectBuffer);
+  return drawGroup * sizeof(DrawElementsIndirectCommand);
+}
+
+void InstanceCulling::copyVisibleCount(unsigned int instanceCount) {
+  /* the GPU is still working on the copy of this slot, skip the count of this frame instead of waiting */
+  CullReadbackSlot &slot = mReadbackSlots.at(mReadbackSlot);
+  if (slot.fence) {
+    return;
+  }
+
+  glBindBuffer(GL_COPY_READ_BUFFER, mIndirectBuffer);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, slot.buffer);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+    mNumDrawGroups * sizeof(DrawElementsIndirectCommand));
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  slot.instanceCount = instanceCount;
+  mReadbackSlot = (mReadbackSlot + 1) % mNumReadbackSlots;
+}
+
+void InstanceCulling::readVisibleCount(OGLRenderData &renderData) {
+  /* oldest slot first, so the newest finished frame wins */
+  for (unsigned int i = 0; i < mNumReadbackSlots; ++i) {
+    CullReadbackSlot &slot = mReadbackSlots.at((mReadbackSlot + i) % mNumReadbackSlots);
+    if (!slot.fence) {
+      continue;
+    }
+
+    /* a timeout of zero only polls the fence */
+    GLenum waitResult = glClientWaitSync(slot.fence, 0, 0);
+    if (waitResult != GL_ALREADY_SIGNALED && waitResult != GL_CONDITION_SATISFIED) {
+      continue;
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    unsigned int visibleInstances = std::accumulate(slot.commands, slot.commands + mNumDrawGroups, 0u,
+      [](unsigned int sum, const DrawElementsIndirectCommand &command) { return sum + command.instanceCount; });
+
+    renderData.rdVisibleInstances = std::min(visibleInstances, slot.instanceCount);
+    renderData.rdCulledInstances = slot.instanceCount - renderData.rdVisibleInstances;
+  }
+}
+
+void InstanceCulling::cleanup() {
+  for (auto &slot : mReadbackSlots) {
+    if (slot.fence) {
+      glDeleteSync(slot.fence);
+      slot.fence = nullptr;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, slot.buffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glDeleteBuffers(1, &slot.buffer);
+    slot.commands = nullptr;
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  glDeleteBuffers(1, &mIndirectBuffer);
+  glDeleteBuffers(1, &mVisibleIdBuffer);
+  mCullInstanceBuffer.cleanup();
+  mFrustumBuffer.cleanup();
+  mCullShader.cleanup();
+}
+
+std::vector<glm::vec4> InstanceCulling::getFrustumPlanes(const glm::mat4 &projectionView) {
+  /* rows of the matrix, glm stores the columns */
+  std::array<glm::vec4, 4> rows{};
+  for (int i = 0; i < 4; ++i) {
+    rows.at(i) = glm::vec4(projectionView[0][i], projectionView[1][i], projectionView[2][i], projectionView[3][i]);
+  }
+
+  /* left, right, bottom, top, near and far */
+  std::vector<glm::vec4> planes = {
+    rows.at(3) + rows.at(0), rows.at(3) - rows.at(0),
+    rows.at(3) + rows.at(1), rows.at(3) - rows.at(1),
+    rows.at(3) + rows.at(2), rows.at(3) - rows.at(2)
+  };
+
+  /* normalized planes give the distance to the sphere center */
+  for (auto &plane : planes) {
+    plane /= glm::length(glm::vec3(plane));
+  }
+  return planes;
+}
@@ -0,0 +1,68 @@
+/* OpenGL frustum culling of the glTF instances in a compute shader, the instances are drawn with indirect draw calls */
+#pragma once
+#include <vector>
+#include <array>
+#include <glm/glm.hpp>
+#include <glad/glad.h>
+
+#include "Shader.h"
+#include "UniformBuffer.h"
+#include "ShaderStorageBuffer.h"
+
+#include "OGLRenderData.h"
+
+/* must match the command layout of glDrawElementsIndirect() */
+struct DrawElementsIndirectCommand {
+  GLuint count;
+  GLuint instanceCount;
+  GLuint firstIndex;
+  GLint baseVertex;
+  GLuint baseInstance;
+};
+
+/* copy of the draw commands of one frame, read by the CPU once the fence is signaled */
+struct CullReadbackSlot {
+  GLuint buffer = 0;
+  DrawElementsIndirectCommand *commands = nullptr;
+  GLsync fence = nullptr;
+  unsigned int instanceCount = 0;
+};
+
+/* every draw group has its own indirect command and its own range of visible instance ids,
+ * the range starts at the base instance of the command */
+class InstanceCulling {
+  public:
+    bool init(unsigned int maxInstances, unsigned int numDrawGroups);
+
+    /* tests the instances against the frustum and fills the commands of the draw groups,
+     * the counts shown in the UI are the ones of the newest frame the GPU has finished */
+    void cull(OGLRenderData &renderData, const glm::mat4 &projectionView,
+      std::vector<OGLCullInstance> &cullInstances, unsigned int indexCount);
+    /* binds the buffer with the commands, returns the offset of the command for the draw group */
+    GLintptr bindDrawGroup(unsigned int drawGroup);
+
+    void cleanup();
+
+  private:
+    void createBuffers();
+    void createReadbackSlots();
+    void readVisibleCount(OGLRenderData &renderData);
+    void copyVisibleCount(unsigned int instanceCount);
+    /* normalized planes of the view frustum, the normals point inside */
+    std::vector<glm::vec4> getFrustumPlanes(const glm::mat4 &projectionView);
+
+    unsigned int mMaxInstances = 0;
+    unsigned int mNumDrawGroups = 0;
+
+    Shader mCullShader{};
+    UniformBuffer mFrustumBuffer{};
+    ShaderStorageBuffer mCullInstanceBuffer{};
+
+    GLuint mIndirectBuffer = 0;
+    GLuint mVisibleIdBuffer = 0;
+
+    /* copies in flight, the count of a frame is dropped if the GPU still works on all of them */
+    static const unsigned int mNumReadbackSlots = 3;
+    std::array<CullReadbackSlot, mNumReadbackSlots> mReadbackSlots{};
+    unsigned int mReadbackSlot = 0;
+};
@@ -18,6 +18,16 @@ struct OGLMesh {
   std::vector<OGLVertex> vertices;
 };
 
+/* one drawn glTF instance as seen by the culling compute shader, must match the std430 layout */
+struct OGLCullInstance {
+  glm::vec4 boundingSphere;
+  uint32_t drawGroup;
+  /* position of the joint data in the SSBO of the draw group */
+  uint32_t paletteIndex;
+  uint32_t instanceIndex;
+  uint32_t padding;
+};
+
 enum class skinningMode {
   linear = 0,
   dualQuat
@@ -77,5 +87,9 @@ struct OGLRenderData {
   int rdNumberOfInstances = 0;
   int rdCurrentSelectedInstance = 0;
 
+  bool rdFrustumCulling = true;
+  unsigned int rdVisibleInstances = 0;
+  unsigned int rdCulledInstances = 0;
+
   instanceEditMode rdInstanceEditMode = instanceEditMode::move;
 };
@@ -152,6 +152,11 @@ bool OGLRenderer::init(unsigned int width, unsigned int height) {
   mSelectedInstanceBuffer.init(256);
   Logger::log(1, "%s: SSBOs initialized\n", __FUNCTION__);
 
+  if (!mInstanceCulling.init(mRenderData.rdNumberOfInstances, 2)) {
+    Logger::log(1, "%s error: could not init instance culling\n", __FUNCTION__);
+    return false;
+  }
+
   /* valid, but emtpy */
   mLineMesh = std::make_shared<OGLMesh>();
   Logger::log(1, "%s: line mesh storage initialized\n", __FUNCTION__);
@@ -505,7 +510,9 @@ void OGLRenderer::draw() {
 
   unsigned int matrixInstances = 0;
   unsigned int dualQuatInstances = 0;
-  unsigned int numTriangles = 0;
+
+  mCullInstances.clear();
+  glm::vec4 modelBoundingSphere = mGltfModel->getBoundingSphere();
 
   for (int i = 0; i < numInstances; ++i) {
     const auto& instance = mGltfInstances.at(i);
@@ -518,28 +525,39 @@ void OGLRenderer::draw() {
       mSelectedInstance.at(i).y = static_cast<float>(i);
     }
 
+    /* the instances are only moved on the ground and rotated */
+    glm::vec2 worldPos = instance->getWorldPosition();
+    OGLCullInstance cullInstance{};
+    cullInstance.boundingSphere = glm::vec4(instance->getWorldRotation() * glm::vec3(modelBoundingSphere) +
+      glm::vec3(worldPos.x, 0.0f, worldPos.y), modelBoundingSphere.w);
+    cullInstance.drawGroup = static_cast<uint32_t>(settings.msVertexSkinningMode);
+    cullInstance.instanceIndex = i;
+
     if (settings.msVertexSkinningMode == skinningMode::dualQuat) {
       std::vector<glm::mat2x4> quats = instance->getJointDualQuats();
       mModelJointDualQuats.insert(mModelJointDualQuats.end(),
         quats.begin(), quats.end());
-      ++dualQuatInstances;
+      cullInstance.paletteIndex = dualQuatInstances++;
     } else {
       std::vector<glm::mat4> mats = instance->getJointMatrices();
       mModelJointMatrices.insert(mModelJointMatrices.end(),
         mats.begin(), mats.end());
-      ++matrixInstances;
+      cullInstance.paletteIndex = matrixInstances++;
     }
-    numTriangles += mGltfModel->getTriangleCount();
+    mCullInstances.emplace_back(cullInstance);
   }
 
-  mRenderData.rdTriangleCount = numTriangles;
-
   mUploadToUBOTimer.start();
   mGltfShaderStorageBuffer.uploadSsboData(mModelJointMatrices, 1);
   mGltfDualQuatSSBuffer.uploadSsboData(mModelJointDualQuats, 2);
   mSelectedInstanceBuffer.uploadSsboData(mSelectedInstance, 3);
   mRenderData.rdUploadToUBOTime = mUploadToUBOTimer.stop();
 
+  /* fills the draw commands for both skinning modes */
+  mInstanceCulling.cull(mRenderData, mProjectionMatrix * mViewMatrix, mCullInstances,
+    mGltfModel->getIndexCount());
+  mRenderData.rdTriangleCount = mRenderData.rdVisibleInstances * mGltfModel->getTriangleCount();
+
   /* upload vertex data */
   mUploadToVBOTimer.start();
   uploadData(*mLineMesh);
@@ -555,7 +573,7 @@ void OGLRenderer::draw() {
     mGltfGPUShader.setUniformValue(mGltfInstances.at(0)->getJointMatrixSize());
   }
 
-  mGltfModel->drawInstanced(matrixInstances);
+  mGltfModel->drawIndirect(mInstanceCulling.bindDrawGroup(static_cast<unsigned int>(skinningMode::linear)));
 
   if (mMousePick) {
     mGltfGPUDualQuatSelectionShader.use();
@@ -564,7 +582,7 @@ void OGLRenderer::draw() {
     mGltfGPUDualQuatShader.use();
     mGltfGPUDualQuatShader.setUniformValue(mGltfInstances.at(0)->getJointDualQuatsSize());
   }
-  mGltfModel->drawInstanced(dualQuatInstances);
+  mGltfModel->drawIndirect(mInstanceCulling.bindDrawGroup(static_cast<unsigned int>(skinningMode::dualQuat)));
 
   /* draw the coordinate arrow WITH depth buffer */
   if (mCoordArrowsLineIndexCount > 0) {
@@ -632,6 +650,7 @@ void OGLRenderer::cleanup() {
   mGltfShaderStorageBuffer.cleanup();
   mGltfDualQuatSSBuffer.cleanup();
   mSelectedInstanceBuffer.cleanup();
+  mInstanceCulling.cleanup();
   mUniformBuffer.cleanup();
   mFramebuffer.cleanup();
 }
@@ -14,6 +14,7 @@
 #include "Shader.h"
 #include "UniformBuffer.h"
 #include "ShaderStorageBuffer.h"
+#include "InstanceCulling.h"
 #include "UserInterface.h"
 #include "Camera.h"
 #include "CoordArrowsModel.h"
@@ -66,6 +67,10 @@ class OGLRenderer {
     std::vector<glm::vec2> mSelectedInstance{};
     ShaderStorageBuffer mSelectedInstanceBuffer{};
 
+    /* one draw group per skinning mode */
+    std::vector<OGLCullInstance> mCullInstances{};
+    InstanceCulling mInstanceCulling{};
+
     std::shared_ptr<GltfModel> mGltfModel = nullptr;
 
     std::vector<std::shared_ptr<GltfInstance>> mGltfInstances{};
@@ -20,6 +20,17 @@ bool Shader::loadShaders(std::string vertexShaderFileName, std::string fragmentS
   return true;
 }
 
+bool Shader::loadComputeShader(std::string computeShaderFileName) {
+  Logger::log(1, "%s: loading compute shader '%s'\n", __FUNCTION__, computeShaderFileName.c_str());
+
+  if (!createComputeShaderProgram(computeShaderFileName)) {
+    Logger::log(1, "%s error: compute shader program creation failed\n", __FUNCTION__);
+    return false;
+  }
+
+  return true;
+}
+
 void Shader::use() {
   glUseProgram(mShaderProgram);
 }
@@ -105,6 +116,34 @@ bool Shader::createShaderProgram(std::string vertexShaderFileName, std::string f
   return true;
 }
 
+bool Shader::createComputeShaderProgram(std::string computeShaderFileName) {
+  GLuint computeShader = loadShader(computeShaderFileName, GL_COMPUTE_SHADER);
+  if (!computeShader) {
+    Logger::log(1, "%s: loading of compute shader '%s' failed\n", __FUNCTION__, computeShaderFileName.c_str());
+    return false;
+  }
+
+  mShaderProgram = glCreateProgram();
+
+  glAttachShader(mShaderProgram, computeShader);
+
+  glLinkProgram(mShaderProgram);
+
+  if (!checkLinkStats(computeShaderFileName, mShaderProgram)) {
+    Logger::log(1, "%s error: program linking from compute shader '%s' failed\n", __FUNCTION__, computeShaderFileName.c_str());
+
+    glDeleteShader(computeShader);
+
+    return false;
+  }
+
+  /* it is safe to delete the original shader here */
+  glDeleteShader(computeShader);
+
+  Logger::log(1, "%s: shader program %#x successfully compiled from compute shader '%s'\n", __FUNCTION__, mShaderProgram, computeShaderFileName.c_str());
+  return true;
+}
+
 bool Shader::checkCompileStats(std::string shaderFileName, GLuint shader) {
   GLint isShaderCompiled;
   int logMessageLength;
@@ -143,6 +182,25 @@ bool Shader::checkLinkStats(std::string vertexShaderFileName, std::string fragme
   return true;
 }
 
+bool Shader::checkLinkStats(std::string computeShaderFileName, GLuint shaderProgram) {
+  GLint isProgramLinked;
+  int logMessageLength;
+  std::vector<char> programLog;
+
+  glGetProgramiv(shaderProgram, GL_LINK_STATUS, &isProgramLinked);
+  if (!isProgramLinked) {
+    glGetProgramiv(shaderProgram, GL_INFO_LOG_LENGTH, &logMessageLength);
+    programLog = std::vector<char>(logMessageLength + 1);
+    glGetProgramInfoLog(shaderProgram, logMessageLength, &logMessageLength, programLog.data());
+    programLog.at(logMessageLength) = '\0';
+    Logger::log(1, "%s error: program linking of compute shader '%s' failed\n", __FUNCTION__, computeShaderFileName.c_str());
+    Logger::log(1, "%s compile log:\n%s\n", __FUNCTION__, programLog.data());
+    return false;
+  }
+
+  return true;
+}
+
 std::string Shader::loadFileToString(std::string fileName) {
   std::ifstream inFile(fileName);
   std::string str;
@@ -47,6 +47,18 @@ void ShaderStorageBuffer::uploadSsboData(std::vector<glm::mat2x4> bufferData, in
   glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
+void ShaderStorageBuffer::uploadSsboData(std::vector<OGLCullInstance> bufferData, int bindingPoint) {
+  if (bufferData.size() == 0) {
+    return;
+  }
+  size_t bufferSize = bufferData.size() * sizeof(OGLCullInstance);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, mShaderStorageBuffer);
+  glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, bufferSize, bufferData.data());
+  glBindBufferRange(GL_SHADER_STORAGE_BUFFER, bindingPoint, mShaderStorageBuffer, 0,
+    bufferSize);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
 void ShaderStorageBuffer::checkForResize(size_t newBufferSize) {
   if (newBufferSize > mBufferSize) {
     Logger::log(1, "%s: resizing SSBO %i from %i to %i bytes\n", __FUNCTION__, mShaderStorageBuffer, mBufferSize, newBufferSize);
@@ -4,12 +4,15 @@
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 
+#include "OGLRenderData.h"
+
 class ShaderStorageBuffer {
   public:
     void init(size_t bufferSize);
     void uploadSsboData(std::vector<glm::vec2> bufferData, int bindingPoint);
     void uploadSsboData(std::vector<glm::mat4> bufferData, int bindingPoint);
     void uploadSsboData(std::vector<glm::mat2x4> bufferData, int bindingPoint);
+    void uploadSsboData(std::vector<OGLCullInstance> bufferData, int bindingPoint);
     void checkForResize(size_t newBufferSize);
     void cleanup();
 
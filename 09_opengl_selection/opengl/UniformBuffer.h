@@ -8,6 +8,7 @@ class UniformBuffer {
   public:
     void init(size_t bufferSize);
     void uploadUboData(std::vector<glm::mat4> bufferData, int bindingPoint);
+    void uploadUboData(std::vector<glm::vec4> bufferData, int bindingPoint);
     void cleanup();
 
   private:
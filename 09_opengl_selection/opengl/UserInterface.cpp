@@ -127,6 +127,16 @@ void UserInterface::createFrame(OGLRenderData &renderData, ModelSettings &settin
     ImGui::SameLine();
     ImGui::Text("%s", std::to_string(renderData.rdTriangleCount + renderData.rdGltfTriangleCount).c_str());
 
+    ImGui::Text("Visible Instances:");
+    ImGui::SameLine();
+    ImGui::Text("%s", std::to_string(renderData.rdVisibleInstances).c_str());
+
+    ImGui::Text("Culled Instances:");
+    ImGui::SameLine();
+    ImGui::Text("%s", std::to_string(renderData.rdCulledInstances).c_str());
+
+    ImGui::Checkbox("Frustum Culling", &renderData.rdFrustumCulling);
+
     std::string windowDims = std::to_string(renderData.rdWidth) + "x" + std::to_string(renderData.rdHeight);
     ImGui::Text("Window Dimensions:");
     ImGui::SameLine();
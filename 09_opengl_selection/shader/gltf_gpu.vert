@@ -17,14 +17,37 @@ layout (std430, binding = 1) readonly buffer JointMatrices {
   mat4 jointMat[];
 };
 
+struct CullInstance {
+  vec4 boundingSphere;
+  uint drawGroup;
+  uint paletteIndex;
+  uint instanceIndex;
+  uint padding;
+};
+
+layout (std430, binding = 4) readonly buffer CullInstances {
+  CullInstance cullInstances[];
+};
+
+/* written by the culling compute shader, the ids of a draw group start at its base instance */
+layout (std430, binding = 6) readonly buffer VisibleInstances {
+  uint visibleIds[];
+};
+
 uniform int aModelStride;
 
+uint getCullInstance() {
+  return visibleIds[gl_BaseInstance + gl_InstanceID];
+}
+
 void main() {
+  int jointOffset = int(cullInstances[getCullInstance()].paletteIndex) * aModelStride;
+
   mat4 skinMat =
-    aJointWeight.x * jointMat[int(aJointNum.x) + gl_InstanceID * aModelStride] +
-    aJointWeight.y * jointMat[int(aJointNum.y) + gl_InstanceID * aModelStride] +
-    aJointWeight.z * jointMat[int(aJointNum.z) + gl_InstanceID * aModelStride] +
-    aJointWeight.w * jointMat[int(aJointNum.w) + gl_InstanceID * aModelStride];
+    aJointWeight.x * jointMat[int(aJointNum.x) + jointOffset] +
+    aJointWeight.y * jointMat[int(aJointNum.y) + jointOffset] +
+    aJointWeight.z * jointMat[int(aJointNum.z) + jointOffset] +
+    aJointWeight.w * jointMat[int(aJointNum.w) + jointOffset];
 
   gl_Position = projection * view * skinMat * vec4(aPos, 1.0);
   normal = vec3(transpose(inverse(skinMat)) * vec4(aNormal, 1.0));
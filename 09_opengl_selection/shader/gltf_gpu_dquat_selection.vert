@@ -22,14 +22,37 @@ layout (std430, binding = 3) readonly buffer InstanceSelected {
   vec2 selected[];
 };
 
+struct CullInstance {
+  vec4 boundingSphere;
+  uint drawGroup;
+  uint paletteIndex;
+  uint instanceIndex;
+  uint padding;
+};
+
+layout (std430, binding = 4) readonly buffer CullInstances {
+  CullInstance cullInstances[];
+};
+
+/* written by the culling compute shader, the ids of a draw group start at its base instance */
+layout (std430, binding = 6) readonly buffer VisibleInstances {
+  uint visibleIds[];
+};
+
 uniform int aModelStride;
 
+uint getCullInstance() {
+  return visibleIds[gl_BaseInstance + gl_InstanceID];
+}
+
 mat2x4 getJointTransform(ivec4 joints, vec4 weights) {
+  int jointOffset = int(cullInstances[getCullInstance()].paletteIndex) * aModelStride;
+
   // read dual quaterions from buffer
-  mat2x4 dq0 = jointDQs[joints.x + gl_InstanceID * aModelStride];
-  mat2x4 dq1 = jointDQs[joints.y + gl_InstanceID * aModelStride];
-  mat2x4 dq2 = jointDQs[joints.z + gl_InstanceID * aModelStride];
-  mat2x4 dq3 = jointDQs[joints.w + gl_InstanceID * aModelStride];
+  mat2x4 dq0 = jointDQs[joints.x + jointOffset];
+  mat2x4 dq1 = jointDQs[joints.y + jointOffset];
+  mat2x4 dq2 = jointDQs[joints.z + jointOffset];
+  mat2x4 dq3 = jointDQs[joints.w + jointOffset];
 
   // shortest rotation
   weights.y *= sign(dot(dq0[0], dq1[0]));
@@ -84,5 +107,5 @@ void main() {
   texCoord = aTexCoord;
 
   /* we need vertex id only (z -> y) */
-  selectInfo = selected[gl_InstanceID].y;
+  selectInfo = selected[cullInstances[getCullInstance()].instanceIndex].y;
 }